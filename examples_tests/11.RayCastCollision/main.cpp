@@ -124,6 +124,8 @@ int main()
         smgr->drawAll();
 
 		driver->endScene();
+        //! drawAll updated the nodes' absolute transformations, move their colliders in the broad phase once before picking
+        gCollEng->refit();
 
         cube->setMaterialFlag(video::EMF_WIREFRAME,false);
         sphere->setMaterialFlag(video::EMF_WIREFRAME,false);
@@ -170,13 +170,13 @@ float Fresnel_dielectric(in float Eta, in float CosTheta)
     }
 
 protected:
-    irr::core::vector<std::pair<std::regex, HandleFunc_t>> getBuiltinNamesToFunctionMapping() const override
+    irr::core::vector<std::pair<std::string, HandleFunc_t>> getBuiltinNamesToFunctionMapping() const override
     {
         return {
-            { std::regex{"diffuse/oren_nayar\\.glsl"}, &getOrenNayar },
-            { std::regex{"specular/ndf/ggx_trowbridge_reitz\\.glsl"}, &getGGXTrowbridgeReitz },
-            { std::regex{"specular/geom/ggx_smith\\.glsl"}, &getGGXSmith },
-            { std::regex{"specular/fresnel/fresnel\\.glsl"}, &getFresnel }
+            { "diffuse/oren_nayar\\.glsl", &getOrenNayar },
+            { "specular/ndf/ggx_trowbridge_reitz\\.glsl", &getGGXTrowbridgeReitz },
+            { "specular/geom/ggx_smith\\.glsl", &getGGXSmith },
+            { "specular/fresnel/fresnel\\.glsl", &getFresnel }
         };
     }
 };
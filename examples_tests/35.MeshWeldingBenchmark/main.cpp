@@ -0,0 +1,109 @@
+#define _IRR_STATIC_LIB_
+#include <irrlicht.h>
+
+#include <chrono>
+#include <random>
+#include <cstdio>
+
+using namespace irr;
+using namespace core;
+
+//! Builds an indexed triangle soup over a (_gridSide x _gridSide) grid of points, so every grid point is duplicated up to 6 times with sub-epsilon jitter
+static asset::ICPUMeshBuffer* createTriangleSoup(uint32_t _gridSide, float _jitter)
+{
+	const size_t vertexCount = size_t(_gridSide-1u)*size_t(_gridSide-1u)*6ull;
+
+	struct SVertex
+	{
+		float pos[3];
+		uint8_t normal[4];
+	};
+	asset::ICPUBuffer* vertices = new asset::ICPUBuffer(vertexCount*sizeof(SVertex));
+	asset::ICPUBuffer* indices = new asset::ICPUBuffer(vertexCount*sizeof(uint32_t));
+
+	std::mt19937 generator(0xdeadbeefu);
+	std::uniform_real_distribution<float> jitter(-_jitter,_jitter);
+
+	SVertex* vx = reinterpret_cast<SVertex*>(vertices->getPointer());
+	auto addVertex = [&](uint32_t x, uint32_t y)
+	{
+		vx->pos[0] = float(x)+jitter(generator);
+		vx->pos[1] = float(y)+jitter(generator);
+		vx->pos[2] = 0.5f*sinf(float(x)*0.1f)*cosf(float(y)*0.1f)+jitter(generator);
+		vx->normal[0] = 0u;
+		vx->normal[1] = 0u;
+		vx->normal[2] = 255u;
+		vx->normal[3] = 0u;
+		vx++;
+	};
+	for (uint32_t y=0u; y<_gridSide-1u; y++)
+	for (uint32_t x=0u; x<_gridSide-1u; x++)
+	{
+		addVertex(x,y);
+		addVertex(x+1u,y);
+		addVertex(x,y+1u);
+		addVertex(x+1u,y);
+		addVertex(x+1u,y+1u);
+		addVertex(x,y+1u);
+	}
+
+	uint32_t* ix = reinterpret_cast<uint32_t*>(indices->getPointer());
+	for (size_t i=0u; i<vertexCount; i++)
+		ix[i] = i;
+
+	asset::ICPUMeshDataFormatDesc* desc = new asset::ICPUMeshDataFormatDesc();
+	desc->setVertexAttrBuffer(vertices,asset::EVAI_ATTR0,asset::EF_R32G32B32_SFLOAT,sizeof(SVertex),offsetof(SVertex,pos));
+	desc->setVertexAttrBuffer(vertices,asset::EVAI_ATTR3,asset::EF_R8G8B8A8_UNORM,sizeof(SVertex),offsetof(SVertex,normal));
+	desc->setIndexBuffer(indices);
+	vertices->drop();
+	indices->drop();
+
+	asset::ICPUMeshBuffer* meshbuffer = new asset::ICPUMeshBuffer();
+	meshbuffer->setMeshDataAndFormat(desc);
+	meshbuffer->setIndexType(asset::EIT_32BIT);
+	meshbuffer->setIndexCount(vertexCount);
+	desc->drop();
+
+	return meshbuffer;
+}
+
+int main()
+{
+	irr::SIrrlichtCreationParameters params;
+	params.DriverType = video::EDT_NULL;
+	params.WindowSize = dimension2d<uint32_t>(64, 64);
+	IrrlichtDevice* device = createDeviceEx(params);
+	if (device == 0)
+		return 1; // could not create selected driver.
+
+	const asset::IMeshManipulator* manipulator = device->getAssetManager().getMeshManipulator();
+
+	constexpr float epsilon = 1.525e-3f;
+	asset::IMeshManipulator::SErrorMetric errorMetrics[asset::EVAI_COUNT];
+	for (auto& metric : errorMetrics)
+		metric.set(asset::IMeshManipulator::EEM_POSITIONS, core::vectorSIMDf(epsilon));
+
+	// roughly 10k, 1M and 10M vertices
+	const uint32_t gridSides[] = { 42u, 409u, 1292u };
+	for (uint32_t gridSide : gridSides)
+	{
+		asset::ICPUMeshBuffer* meshbuffer = createTriangleSoup(gridSide, epsilon*0.25f);
+		const size_t vertexCount = meshbuffer->getIndexCount();
+
+		auto start = std::chrono::high_resolution_clock::now();
+		manipulator->createMeshBufferWelded(meshbuffer, errorMetrics, false, false);
+		auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now()-start).count();
+
+		// every grid point should have collapsed onto its first occurrence
+		core::unordered_set<uint32_t> uniqueIndices;
+		const uint32_t* indices = reinterpret_cast<const uint32_t*>(meshbuffer->getIndices());
+		for (size_t i=0u; i<vertexCount; i++)
+			uniqueIndices.insert(indices[i]);
+
+		printf("Welded %zu vertices into %zu (expected %u) in %f ms\n", vertexCount, uniqueIndices.size(), gridSide*gridSide, double(elapsed)/1000.0);
+		meshbuffer->drop();
+	}
+
+	device->drop();
+	return 0;
+}
@@ -0,0 +1,128 @@
+#define _IRR_STATIC_LIB_
+#include <irrlicht.h>
+#include "CConcurrentObjectCache.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <random>
+#include <cstdio>
+
+using namespace irr;
+using namespace core;
+
+class RefCounted : public core::IReferenceCounted {};
+
+static void greet(RefCounted* _obj) { _obj->grab(); }
+static void dispose(RefCounted* _obj) { _obj->drop(); }
+
+constexpr uint32_t KEY_COUNT = 1u<<14;
+constexpr auto RUN_DURATION = std::chrono::milliseconds(500);
+
+struct SResult
+{
+	double lookupsPerSecond;
+	double writesPerSecond;
+};
+
+//! Hammers the cache with `_readers` threads doing lookups while `_writers` threads keep removing and reinserting objects for a fixed time
+template<class CacheT>
+static SResult runContention(uint32_t _readers, uint32_t _writers, const core::vector<std::string>& _keys, const core::vector<RefCounted*>& _objects)
+{
+	CacheT cache(&greet, &dispose);
+	for (uint32_t i=0u; i<KEY_COUNT; i++)
+		cache.insert(_keys[i], _objects[i]);
+
+	std::atomic<bool> done(false);
+	std::atomic<uint64_t> totalLookups(0u);
+	std::atomic<uint64_t> totalWrites(0u);
+	std::atomic<uint32_t> mismatches(0u);
+
+	core::vector<std::thread> threads;
+	for (uint32_t t=0u; t<_readers; t++)
+	threads.emplace_back([&,t]()
+	{
+		std::mt19937 generator(t);
+		std::uniform_int_distribution<uint32_t> pick(0u, KEY_COUNT-1u);
+
+		uint64_t lookups = 0u;
+		RefCounted* found[4];
+		while (!done.load(std::memory_order_relaxed))
+		{
+			const uint32_t ix = pick(generator);
+			size_t count = 4u;
+			cache.findAndStoreRange(_keys[ix], count, found);
+			// writers only ever put back the same object under its key
+			for (size_t j=0u; j<count; j++)
+			if (found[j]!=_objects[ix])
+				mismatches++;
+			lookups++;
+		}
+		totalLookups += lookups;
+	});
+	for (uint32_t t=0u; t<_writers; t++)
+	threads.emplace_back([&,t]()
+	{
+		std::mt19937 generator(0xdeadbeefu+t);
+		// every writer owns a disjoint slice of the keys so they never undo each other
+		std::uniform_int_distribution<uint32_t> pick(0u, KEY_COUNT/_writers-1u);
+
+		uint64_t writes = 0u;
+		while (!done.load(std::memory_order_relaxed))
+		{
+			const uint32_t ix = pick(generator)*_writers+t;
+			cache.removeObject(_objects[ix], _keys[ix]);
+			cache.insert(_keys[ix], _objects[ix]);
+			writes += 2u;
+		}
+		totalWrites += writes;
+	});
+
+	auto start = std::chrono::high_resolution_clock::now();
+	std::this_thread::sleep_for(RUN_DURATION);
+	done = true;
+	for (auto& thread : threads)
+		thread.join();
+	const double elapsed = std::chrono::duration<double>(std::chrono::high_resolution_clock::now()-start).count();
+
+	if (mismatches)
+		printf("ERROR: %u lookups returned a wrong object!\n", mismatches.load());
+	if (cache.getSize()!=KEY_COUNT)
+		printf("ERROR: cache ended up with %zu objects instead of %u!\n", cache.getSize(), KEY_COUNT);
+
+	return { double(totalLookups.load())/elapsed, double(totalWrites.load())/elapsed };
+}
+
+int main()
+{
+	core::vector<std::string> keys(KEY_COUNT);
+	core::vector<RefCounted*> objects(KEY_COUNT);
+	for (uint32_t i=0u; i<KEY_COUNT; i++)
+	{
+		keys[i] = "../../media/asset_" + std::to_string(i) + ".baw";
+		objects[i] = new RefCounted();
+	}
+
+	using LockedCache = CConcurrentMultiObjectCache<std::string, RefCounted, std::multimap>;
+	using ShardedCache = CShardedConcurrentMultiObjectCache<std::string, RefCounted, std::multimap>;
+
+	const uint32_t hwThreads = core::max_(std::thread::hardware_concurrency(), 2u);
+	const uint32_t writerCounts[] = { 1u, 2u };
+	for (uint32_t writers : writerCounts)
+	for (uint32_t readers=1u; readers<=hwThreads*2u; readers*=2u)
+	{
+		const SResult locked = runContention<LockedCache>(readers, writers, keys, objects);
+		const SResult sharded = runContention<ShardedCache>(readers, writers, keys, objects);
+		printf("%2u readers, %u writers: lookups/s locked %11.0f sharded %11.0f (x%.2f), writes/s locked %9.0f sharded %9.0f\n",
+			readers, writers, locked.lookupsPerSecond, sharded.lookupsPerSecond, sharded.lookupsPerSecond/locked.lookupsPerSecond, locked.writesPerSecond, sharded.writesPerSecond);
+	}
+
+	for (auto obj : objects)
+	{
+		if (obj->getReferenceCount()!=1)
+			printf("ERROR: reference count leaked!\n");
+		obj->drop();
+	}
+
+	return 0;
+}
@@ -0,0 +1,117 @@
+#define _IRR_STATIC_LIB_
+#include <irrlicht.h>
+
+#include <chrono>
+#include <random>
+#include <cstdio>
+
+using namespace irr;
+using namespace core;
+
+constexpr uint32_t GRID_SIDE = 501u; // 500x500 quads, 500k triangles
+constexpr uint32_t RAY_COUNT = 1u<<16;
+constexpr uint32_t LINEAR_RAY_COUNT = 256u; // the linear scan is too slow to run all of them
+
+//! Bumpy heightfield over [0,GRID_SIDE-1]^2 in XZ
+static void createHeightfield(core::vector<float>& _vertices, core::vector<uint32_t>& _indices)
+{
+	_vertices.reserve(GRID_SIDE*GRID_SIDE*3u);
+	for (uint32_t z=0u; z<GRID_SIDE; z++)
+	for (uint32_t x=0u; x<GRID_SIDE; x++)
+	{
+		_vertices.push_back(float(x));
+		_vertices.push_back(8.f*sinf(float(x)*0.05f)*cosf(float(z)*0.07f)+sinf(float(x*z)*0.01f));
+		_vertices.push_back(float(z));
+	}
+
+	_indices.reserve((GRID_SIDE-1u)*(GRID_SIDE-1u)*6u);
+	for (uint32_t z=0u; z<GRID_SIDE-1u; z++)
+	for (uint32_t x=0u; x<GRID_SIDE-1u; x++)
+	{
+		const uint32_t i = z*GRID_SIDE+x;
+		const uint32_t quad[6] = {i,i+GRID_SIDE,i+1u,i+1u,i+GRID_SIDE,i+GRID_SIDE+1u};
+		_indices.insert(_indices.end(),quad,quad+6u);
+	}
+}
+
+struct SRay
+{
+	vectorSIMDf origin;
+	vectorSIMDf direction;
+};
+
+struct SResult
+{
+	uint32_t hits;
+	double raysPerSecond;
+};
+
+static SResult castRays(const STriangleMeshCollider* _collider, const core::vector<SRay>& _rays, uint32_t _rayCount, core::vector<float>& _distances)
+{
+	SResult result = {0u,0.0};
+	auto start = std::chrono::high_resolution_clock::now();
+	for (uint32_t i=0u; i<_rayCount; i++)
+	{
+		float distance = -1.f;
+		if (_collider->CollideWithRay(distance,_rays[i].origin,_rays[i].direction,1000.f))
+			result.hits++;
+		_distances[i] = distance;
+	}
+	const double elapsed = std::chrono::duration<double>(std::chrono::high_resolution_clock::now()-start).count();
+	result.raysPerSecond = double(_rayCount)/elapsed;
+	return result;
+}
+
+int main()
+{
+	core::vector<float> vertices;
+	core::vector<uint32_t> indices;
+	createHeightfield(vertices,indices);
+
+	STriangleMeshCollider* linear = new STriangleMeshCollider();
+	linear->Init(vertices.data(),indices.size(),indices.data(),false);
+
+	STriangleMeshCollider* bvh = new STriangleMeshCollider();
+	auto start = std::chrono::high_resolution_clock::now();
+	bvh->Init(vertices.data(),indices.size(),indices.data(),true);
+	const double buildTime = std::chrono::duration<double>(std::chrono::high_resolution_clock::now()-start).count();
+	printf("%zu triangles, BVH built in %.1f ms\n",bvh->getTriangleCount(),buildTime*1000.0);
+
+	// mix of picking-like rays from above and grazing rays across the terrain
+	std::mt19937 generator(0x45u);
+	std::uniform_real_distribution<float> onGrid(0.f,float(GRID_SIDE-1u));
+	std::uniform_real_distribution<float> unit(-1.f,1.f);
+	core::vector<SRay> rays(RAY_COUNT);
+	for (uint32_t i=0u; i<RAY_COUNT; i++)
+	{
+		if (i&1u)
+		{
+			rays[i].origin = vectorSIMDf(onGrid(generator),50.f,onGrid(generator));
+			rays[i].direction = normalize(vectorSIMDf(unit(generator)*0.3f,-1.f,unit(generator)*0.3f));
+		}
+		else
+		{
+			rays[i].origin = vectorSIMDf(onGrid(generator),12.f,onGrid(generator));
+			rays[i].direction = normalize(vectorSIMDf(unit(generator),unit(generator)*0.05f-0.02f,unit(generator)));
+		}
+	}
+
+	core::vector<float> linearDistances(RAY_COUNT), bvhDistances(RAY_COUNT);
+	const SResult linearResult = castRays(linear,rays,LINEAR_RAY_COUNT,linearDistances);
+	const SResult bvhResult = castRays(bvh,rays,RAY_COUNT,bvhDistances);
+
+	uint32_t mismatches = 0u;
+	for (uint32_t i=0u; i<LINEAR_RAY_COUNT; i++)
+	if (fabsf(linearDistances[i]-bvhDistances[i])>0.0001f*(1.f+fabsf(linearDistances[i])))
+		mismatches++;
+	if (mismatches)
+		printf("ERROR: %u of %u rays disagree between the linear scan and the BVH!\n",mismatches,LINEAR_RAY_COUNT);
+
+	printf("linear: %12.0f rays/s (%u/%u hits)\n",linearResult.raysPerSecond,linearResult.hits,LINEAR_RAY_COUNT);
+	printf("BVH:    %12.0f rays/s (%u/%u hits) x%.1f\n",bvhResult.raysPerSecond,bvhResult.hits,RAY_COUNT,bvhResult.raysPerSecond/linearResult.raysPerSecond);
+
+	linear->drop();
+	bvh->drop();
+
+	return 0;
+}
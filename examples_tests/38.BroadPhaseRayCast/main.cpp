@@ -0,0 +1,187 @@
+#define _IRR_STATIC_LIB_
+#include <irrlicht.h>
+#include "SCollisionEngine.h"
+
+#include <chrono>
+#include <random>
+#include <cstdio>
+
+using namespace irr;
+using namespace core;
+
+constexpr uint32_t COLLIDER_COUNT = 50000u;
+constexpr float SCENE_SIZE = 1000.f;
+constexpr uint32_t RAY_COUNT = 1u<<14;
+constexpr uint32_t BRUTE_FORCE_RAY_COUNT = 512u; // testing every collider is too slow to run all of them
+constexpr uint32_t CHURN_COUNT = 10000u;
+constexpr uint32_t CAMERA_RESOLUTION = 256u;
+
+struct SRay
+{
+	vectorSIMDf origin;
+	vectorSIMDf direction;
+};
+
+//! What SCollisionEngine::FastCollide used to do before it had a broad phase
+static bool bruteForceCollide(const core::vector<SCompoundCollider*>& _colliders, float& _distance, const SRay& _ray, float _maxRayLen)
+{
+	bool retval = false;
+	_distance = _maxRayLen;
+	for (auto collider : _colliders)
+	{
+		float tmpDist;
+		if (collider->CollideWithRay(tmpDist,_ray.origin,_ray.direction,_distance)&&tmpDist<_distance)
+		{
+			_distance = tmpDist;
+			retval = true;
+		}
+	}
+	return retval;
+}
+
+static double castRays(const SCollisionEngine& _engine, const core::vector<SRay>& _rays, core::vector<float>& _distances, uint32_t& _hits)
+{
+	_hits = 0u;
+	auto start = std::chrono::high_resolution_clock::now();
+	for (uint32_t i=0u; i<RAY_COUNT; i++)
+	{
+		SColliderData hitData;
+		if (_engine.FastCollide(hitData,_distances[i],_rays[i].origin,_rays[i].direction,SCENE_SIZE*2.f))
+			_hits++;
+		else
+			_distances[i] = -1.f;
+	}
+	return std::chrono::duration<double,std::micro>(std::chrono::high_resolution_clock::now()-start).count()/double(RAY_COUNT);
+}
+
+//! Casts `_rays` with FastCollide one by one and with FastCollideBatch, returns the amount of rays on which they disagree
+static uint32_t compareBatch(const SCollisionEngine& _engine, const core::vector<SRay>& _rays, const char* _name)
+{
+	const size_t rayCount = _rays.size();
+	core::vector<vectorSIMDf> origins(rayCount), directions(rayCount);
+	for (size_t i=0u; i<rayCount; i++)
+	{
+		origins[i] = _rays[i].origin;
+		directions[i] = _rays[i].direction;
+	}
+
+	core::vector<float> singleDistances(rayCount);
+	auto start = std::chrono::high_resolution_clock::now();
+	for (size_t i=0u; i<rayCount; i++)
+	{
+		SColliderData hitData;
+		_engine.FastCollide(hitData,singleDistances[i],origins[i],directions[i],SCENE_SIZE*2.f);
+	}
+	const double singleTime = std::chrono::duration<double,std::micro>(std::chrono::high_resolution_clock::now()-start).count()/double(rayCount);
+
+	core::vector<SColliderData> hitData(rayCount);
+	core::vector<float> batchDistances(rayCount);
+	double batchTimes[2];
+	const uint32_t threadCounts[2] = {1u,0u};
+	size_t hits = 0u;
+	for (uint32_t i=0u; i<2u; i++)
+	{
+		start = std::chrono::high_resolution_clock::now();
+		hits = _engine.FastCollideBatch(hitData.data(),batchDistances.data(),origins.data(),directions.data(),rayCount,SCENE_SIZE*2.f,threadCounts[i]);
+		batchTimes[i] = std::chrono::duration<double,std::micro>(std::chrono::high_resolution_clock::now()-start).count()/double(rayCount);
+	}
+	printf("%s: FastCollide %8.2f us/ray, FastCollideBatch %8.2f us/ray single threaded (x%.2f), %8.2f us/ray on all threads (x%.2f), %zu/%zu hits\n",
+		_name,singleTime,batchTimes[0],singleTime/batchTimes[0],batchTimes[1],singleTime/batchTimes[1],hits,rayCount);
+
+	uint32_t mismatches = 0u;
+	for (size_t i=0u; i<rayCount; i++)
+	if (fabsf(singleDistances[i]-batchDistances[i])>0.0001f*(1.f+fabsf(singleDistances[i])))
+		mismatches++;
+	return mismatches;
+}
+
+static uint32_t compareWithBruteForce(const core::vector<SCompoundCollider*>& _colliders, const core::vector<SRay>& _rays, const core::vector<float>& _distances, double& _microsecondsPerRay)
+{
+	uint32_t mismatches = 0u;
+	auto start = std::chrono::high_resolution_clock::now();
+	for (uint32_t i=0u; i<BRUTE_FORCE_RAY_COUNT; i++)
+	{
+		float distance;
+		if (!bruteForceCollide(_colliders,distance,_rays[i],SCENE_SIZE*2.f))
+			distance = -1.f;
+		if (fabsf(distance-_distances[i])>0.0001f*(1.f+fabsf(distance)))
+			mismatches++;
+	}
+	_microsecondsPerRay = std::chrono::duration<double,std::micro>(std::chrono::high_resolution_clock::now()-start).count()/double(BRUTE_FORCE_RAY_COUNT);
+	return mismatches;
+}
+
+int main()
+{
+	std::mt19937 generator(0x38u);
+	std::uniform_real_distribution<float> inScene(0.f,SCENE_SIZE);
+	std::uniform_real_distribution<float> boxSize(0.5f,6.f);
+	std::uniform_real_distribution<float> unit(-1.f,1.f);
+
+	core::vector<SCompoundCollider*> colliders(COLLIDER_COUNT);
+	for (auto& collider : colliders)
+	{
+		collider = new SCompoundCollider();
+		const vector3df corner(inScene(generator),inScene(generator),inScene(generator));
+		collider->AddBox(SAABoxCollider(aabbox3df(corner,corner+vector3df(boxSize(generator),boxSize(generator),boxSize(generator)))));
+	}
+
+	SCollisionEngine engine;
+	auto start = std::chrono::high_resolution_clock::now();
+	for (auto collider : colliders)
+		engine.addCompoundCollider(collider);
+	printf("%zu colliders added in %.1f ms\n",engine.getColliderCount(),std::chrono::duration<double,std::milli>(std::chrono::high_resolution_clock::now()-start).count());
+
+	core::vector<SRay> rays(RAY_COUNT);
+	for (auto& ray : rays)
+	{
+		ray.origin = vectorSIMDf(inScene(generator),inScene(generator),inScene(generator));
+		ray.direction = normalize(vectorSIMDf(unit(generator),unit(generator),unit(generator)));
+	}
+
+	core::vector<float> distances(RAY_COUNT);
+	uint32_t hits;
+	const double treeTime = castRays(engine,rays,distances,hits);
+	double bruteForceTime;
+	uint32_t mismatches = compareWithBruteForce(colliders,rays,distances,bruteForceTime);
+	printf("broad phase: %8.2f us/ray (%u/%u hits), brute force: %8.2f us/ray x%.0f\n",treeTime,hits,RAY_COUNT,bruteForceTime,bruteForceTime/treeTime);
+
+	// take some colliders out and put them back in, the tree has to stay valid and balanced
+	start = std::chrono::high_resolution_clock::now();
+	for (uint32_t i=0u; i<CHURN_COUNT; i++)
+		engine.removeCompoundCollider(colliders[(i*7u)%COLLIDER_COUNT]);
+	for (uint32_t i=0u; i<CHURN_COUNT; i++)
+		engine.addCompoundCollider(colliders[(i*7u)%COLLIDER_COUNT]);
+	printf("%u removals and reinsertions in %.1f ms\n",CHURN_COUNT,std::chrono::duration<double,std::milli>(std::chrono::high_resolution_clock::now()-start).count());
+
+	// primary rays of a pinhole camera looking into the scene from a corner, neighbouring pixels go into the same packet
+	core::vector<SRay> cameraRays(CAMERA_RESOLUTION*CAMERA_RESOLUTION);
+	const vectorSIMDf eye(-10.f,-10.f,-10.f);
+	for (uint32_t y=0u; y<CAMERA_RESOLUTION; y++)
+	for (uint32_t x=0u; x<CAMERA_RESOLUTION; x++)
+	{
+		const float u = float(x)/float(CAMERA_RESOLUTION-1u);
+		const float v = float(y)/float(CAMERA_RESOLUTION-1u);
+		SRay& ray = cameraRays[y*CAMERA_RESOLUTION+x];
+		ray.origin = eye;
+		ray.direction = normalize(vectorSIMDf(1.f,0.2f+u*0.6f,0.2f+v*0.6f));
+	}
+	mismatches += compareBatch(engine,cameraRays,"coherent rays  ");
+	mismatches += compareBatch(engine,rays,"incoherent rays");
+
+	const double churnedTreeTime = castRays(engine,rays,distances,hits);
+	mismatches += compareWithBruteForce(colliders,rays,distances,bruteForceTime);
+	printf("broad phase after churn: %8.2f us/ray (%u/%u hits)\n",churnedTreeTime,hits,RAY_COUNT);
+	if (mismatches)
+		printf("ERROR: %u rays disagree between the broad phase and the brute force loop!\n",mismatches);
+
+	for (auto collider : colliders)
+	{
+		engine.removeCompoundCollider(collider);
+		collider->drop();
+	}
+	if (engine.getColliderCount())
+		printf("ERROR: %zu colliders left in the engine!\n",engine.getColliderCount());
+
+	return 0;
+}
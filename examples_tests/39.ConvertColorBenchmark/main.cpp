@@ -0,0 +1,224 @@
+#define _IRR_STATIC_LIB_
+#include <irrlicht.h>
+#include "irr/video/convertColor.h"
+
+#include <chrono>
+#include <random>
+#include <cstdio>
+#include <cmath>
+
+using namespace irr;
+using namespace core;
+using namespace asset;
+
+constexpr uint32_t IMAGE_SIDE = 1024u;
+constexpr uint32_t TEXEL_COUNT = IMAGE_SIDE*IMAGE_SIDE;
+
+//! Converts the image one texel at a time like convertColor used to, then all at once with the fast path, @returns the number of texels which differ
+template<E_FORMAT sF, E_FORMAT dF>
+static uint32_t benchmarkPair(const char* _name, const core::vector<uint8_t>& _source)
+{
+	constexpr video::impl::SFastPathTexelLayout srcLayout = video::impl::getFastPathTexelLayout(sF);
+	constexpr video::impl::SFastPathTexelLayout dstLayout = video::impl::getFastPathTexelLayout(dF);
+	static_assert(video::impl::hasFastPath<sF,dF>(), "benchmark only covers the specialized pairs");
+
+	// padding because the generic decode of 3 byte texels reads 4 bytes
+	core::vector<uint8_t> reference(TEXEL_COUNT*dstLayout.size+8u), converted(TEXEL_COUNT*dstLayout.size+8u);
+
+	auto start = std::chrono::high_resolution_clock::now();
+	const void* srcPix[4] = {_source.data(),nullptr,nullptr,nullptr};
+	for (uint32_t i=0u; i<TEXEL_COUNT; i++)
+	{
+		video::convertColor<sF,dF>(srcPix,reference.data()+i*dstLayout.size,0u,0u);
+		srcPix[0] = reinterpret_cast<const uint8_t*>(srcPix[0])+srcLayout.size;
+	}
+	const double genericTime = std::chrono::duration<double,std::milli>(std::chrono::high_resolution_clock::now()-start).count();
+
+	// first call builds the tables, don't count that
+	srcPix[0] = _source.data();
+	core::vector3d<uint32_t> imgSize(IMAGE_SIDE,IMAGE_SIDE,1u);
+	video::convertColor<sF,dF>(srcPix,converted.data(),1u,imgSize);
+
+	start = std::chrono::high_resolution_clock::now();
+	srcPix[0] = _source.data();
+	video::convertColor<sF,dF>(srcPix,converted.data(),TEXEL_COUNT,imgSize);
+	const double fastTime = std::chrono::duration<double,std::milli>(std::chrono::high_resolution_clock::now()-start).count();
+
+	// channels missing in the source are left undefined by the generic path
+	uint64_t compareMask = 0u;
+	for (uint32_t ch=0u; ch<4u; ch++)
+	if (srcLayout.width[ch] && dstLayout.width[ch])
+		compareMask |= ((0x1ull<<dstLayout.width[ch])-1ull)<<dstLayout.offset[ch];
+
+	uint32_t mismatches = 0u;
+	for (uint32_t i=0u; i<TEXEL_COUNT; i++)
+	{
+		uint64_t a = 0u, b = 0u;
+		memcpy(&a,reference.data()+i*dstLayout.size,dstLayout.size);
+		memcpy(&b,converted.data()+i*dstLayout.size,dstLayout.size);
+		if ((a^b)&compareMask)
+			mismatches++;
+	}
+
+	printf("%-40s generic %8.1f ms, fast path %7.2f ms (x%.0f) %7.1f Mtexels/s\n",_name,genericTime,fastTime,genericTime/fastTime,double(TEXEL_COUNT)/fastTime*0.001);
+	if (mismatches)
+		printf("ERROR: %u texels differ from the generic conversion!\n",mismatches);
+	return mismatches;
+}
+
+#define BENCHMARK_PAIR(sF,dF) benchmarkPair<sF,dF>(#sF " -> " #dF,source)
+
+//! Converts the whole image on the calling thread and then split into tiles on all threads, @returns the number of bytes which differ
+template<E_FORMAT sF, E_FORMAT dF>
+static uint32_t benchmarkThreaded(const char* _name, const core::vector<uint8_t>& _source)
+{
+	const core::vector3d<uint32_t> blockDims = getBlockDimensions(sF);
+	const size_t blockCount = TEXEL_COUNT/(blockDims.X*blockDims.Y);
+	const size_t dstSize = TEXEL_COUNT*getTexelOrBlockSize(dF);
+	core::vector<uint8_t> serial(dstSize+8u), threaded(dstSize+8u);
+	core::vector3d<uint32_t> imgSize(IMAGE_SIDE,IMAGE_SIDE,1u);
+
+	// warm up, the fast path builds its tables on first use
+	const void* srcPix[4] = {_source.data(),nullptr,nullptr,nullptr};
+	video::convertColor<sF,dF>(srcPix,serial.data(),1u,imgSize);
+
+	double times[2];
+	uint8_t* outputs[2] = {serial.data(),threaded.data()};
+	const uint32_t threadCounts[2] = {1u,0u};
+	for (uint32_t i=0u; i<2u; i++)
+	{
+		srcPix[0] = _source.data();
+		auto start = std::chrono::high_resolution_clock::now();
+		video::convertColor<sF,dF>(srcPix,outputs[i],blockCount,imgSize,threadCounts[i]);
+		times[i] = std::chrono::duration<double,std::milli>(std::chrono::high_resolution_clock::now()-start).count();
+		if (srcPix[0]!=_source.data()+blockCount*getTexelOrBlockSize(sF))
+			printf("ERROR: source pointer not advanced past the image!\n");
+	}
+
+	uint32_t mismatches = 0u;
+	for (size_t i=0u; i<dstSize; i++)
+	if (serial[i]!=threaded[i])
+		mismatches++;
+
+	printf("%-40s 1 thread %8.2f ms, %2u threads %8.2f ms (x%.2f)\n",_name,times[0],core::getDefaultThreadCount(),times[1],times[0]/times[1]);
+	if (mismatches)
+		printf("ERROR: %u bytes differ between the serial and the threaded conversion!\n",mismatches);
+	return mismatches;
+}
+
+#define BENCHMARK_THREADED(sF,dF) benchmarkThreaded<sF,dF>(#sF " -> " #dF,source)
+
+//! Compresses the image at every quality on one thread and on all threads, decodes it back and @returns the number of bytes which differ between the serial and threaded compression
+template<E_FORMAT dF>
+static uint32_t benchmarkCompression(const char* _name, const core::vector<uint8_t>& _source)
+{
+	const size_t blockCount = TEXEL_COUNT/16u;
+	const size_t dstSize = blockCount*getTexelOrBlockSize(dF);
+	core::vector<uint8_t> serial(dstSize), threaded(dstSize), decoded(TEXEL_COUNT*4u);
+	core::vector3d<uint32_t> imgSize(IMAGE_SIDE,IMAGE_SIDE,1u);
+
+	uint32_t mismatches = 0u;
+	const char* qualityNames[3] = {"fastest","normal","highest"};
+	for (uint32_t q=video::EBCQ_FASTEST; q<=video::EBCQ_HIGHEST; q++)
+	{
+		const auto quality = static_cast<video::E_BLOCK_COMPRESSION_QUALITY>(q);
+
+		double times[2];
+		uint8_t* outputs[2] = {serial.data(),threaded.data()};
+		const uint32_t threadCounts[2] = {1u,0u};
+		for (uint32_t i=0u; i<2u; i++)
+		{
+			const void* srcPix[4] = {_source.data(),nullptr,nullptr,nullptr};
+			auto start = std::chrono::high_resolution_clock::now();
+			video::convertColor<EF_R8G8B8A8_UNORM,dF>(srcPix,outputs[i],TEXEL_COUNT,imgSize,threadCounts[i],quality);
+			times[i] = std::chrono::duration<double,std::milli>(std::chrono::high_resolution_clock::now()-start).count();
+		}
+
+		for (size_t i=0u; i<dstSize; i++)
+		if (serial[i]!=threaded[i])
+			mismatches++;
+
+		const void* srcPix[4] = {serial.data(),nullptr,nullptr,nullptr};
+		video::convertColor<dF,EF_R8G8B8A8_UNORM>(srcPix,decoded.data(),blockCount,imgSize,0u);
+		// only the channels the format stores
+		const uint32_t channels = getFormatChannelCount(dF);
+		double error = 0.0;
+		for (size_t i=0u; i<TEXEL_COUNT; i++)
+		for (uint32_t ch=0u; ch<channels; ch++)
+		{
+			const double diff = double(_source[i*4u+ch])-double(decoded[i*4u+ch]);
+			error += diff*diff;
+		}
+
+		printf("%-40s %-7s 1 thread %8.2f ms, %2u threads %8.2f ms (x%.2f) RMSE %5.2f\n",_name,qualityNames[q],times[0],core::getDefaultThreadCount(),times[1],times[0]/times[1],sqrt(error/double(TEXEL_COUNT*channels)));
+	}
+	if (mismatches)
+		printf("ERROR: %u bytes differ between the serial and the threaded compression!\n",mismatches);
+	return mismatches;
+}
+
+#define BENCHMARK_COMPRESSION(dF) benchmarkCompression<dF>(#dF,gradient)
+
+int main()
+{
+	std::mt19937 generator(0x39u);
+	core::vector<uint8_t> source(TEXEL_COUNT*4u+8u);
+	for (auto& byte : source)
+		byte = generator();
+
+	uint32_t mismatches = 0u;
+	// 8 bit swizzles, adding and dropping alpha
+	mismatches += BENCHMARK_PAIR(EF_R8G8B8A8_UNORM,EF_B8G8R8A8_UNORM);
+	mismatches += BENCHMARK_PAIR(EF_B8G8R8A8_SRGB,EF_R8G8B8A8_SRGB);
+	mismatches += BENCHMARK_PAIR(EF_R8G8B8A8_UNORM,EF_R8G8B8_UNORM);
+	mismatches += BENCHMARK_PAIR(EF_B8G8R8_SRGB,EF_R8G8B8A8_SRGB);
+	mismatches += BENCHMARK_PAIR(EF_B8G8R8_UINT,EF_R8G8B8_UINT);
+	// sRGB <-> linear
+	mismatches += BENCHMARK_PAIR(EF_R8G8B8_UNORM,EF_R8G8B8_SRGB);
+	mismatches += BENCHMARK_PAIR(EF_R8G8B8A8_SRGB,EF_R8G8B8A8_UNORM);
+	mismatches += BENCHMARK_PAIR(EF_B8G8R8A8_UNORM,EF_R8G8B8A8_SRGB);
+	// 8 bit to half float
+	mismatches += BENCHMARK_PAIR(EF_R8G8B8A8_UNORM,EF_R16G16B16A16_SFLOAT);
+	mismatches += BENCHMARK_PAIR(EF_R8G8B8A8_SRGB,EF_R16G16B16A16_SFLOAT);
+	mismatches += BENCHMARK_PAIR(EF_B8G8R8_UNORM,EF_R16G16B16_SFLOAT);
+	// 10 bit packed
+	mismatches += BENCHMARK_PAIR(EF_A2B10G10R10_UNORM_PACK32,EF_R8G8B8A8_UNORM);
+	mismatches += BENCHMARK_PAIR(EF_R8G8B8A8_UNORM,EF_A2B10G10R10_UNORM_PACK32);
+	mismatches += BENCHMARK_PAIR(EF_B8G8R8A8_SRGB,EF_A2R10G10B10_UNORM_PACK32);
+	mismatches += BENCHMARK_PAIR(EF_A2R10G10B10_UNORM_PACK32,EF_R16G16B16A16_SFLOAT);
+
+	if (mismatches)
+		printf("ERROR: %u texels converted differently in total!\n",mismatches);
+
+	// tiled conversion, block compressed formats always go through the generic per texel decode
+	mismatches = 0u;
+	mismatches += BENCHMARK_THREADED(EF_BC1_RGB_UNORM_BLOCK,EF_R8G8B8A8_UNORM);
+	mismatches += BENCHMARK_THREADED(EF_BC2_UNORM_BLOCK,EF_R8G8B8A8_SRGB);
+	mismatches += BENCHMARK_THREADED(EF_BC3_SRGB_BLOCK,EF_R16G16B16A16_SFLOAT);
+	mismatches += BENCHMARK_THREADED(EF_R8G8B8A8_UNORM,EF_B8G8R8A8_UNORM);
+	mismatches += BENCHMARK_THREADED(EF_E5B9G9R9_UFLOAT_PACK32,EF_R8G8B8A8_SRGB);
+	if (mismatches)
+		printf("ERROR: %u bytes converted differently with threads in total!\n",mismatches);
+
+	// random bytes would not tell anything about the quality, compress something smooth with a bit of noise instead
+	core::vector<uint8_t> gradient(TEXEL_COUNT*4u);
+	for (uint32_t y=0u; y<IMAGE_SIDE; y++)
+	for (uint32_t x=0u; x<IMAGE_SIDE; x++)
+	{
+		uint8_t* texel = gradient.data()+(y*IMAGE_SIDE+x)*4u;
+		texel[0] = uint8_t(128.0+100.0*sin(x*0.02+y*0.01))+(generator()&7u);
+		texel[1] = uint8_t((x+y)>>3);
+		texel[2] = uint8_t(255u-(y>>2))-(generator()&3u);
+		texel[3] = uint8_t(x^y);
+	}
+	mismatches = 0u;
+	mismatches += BENCHMARK_COMPRESSION(EF_BC1_RGB_UNORM_BLOCK);
+	mismatches += BENCHMARK_COMPRESSION(EF_BC3_UNORM_BLOCK);
+	mismatches += BENCHMARK_COMPRESSION(EF_BC4_UNORM_BLOCK);
+	mismatches += BENCHMARK_COMPRESSION(EF_BC5_UNORM_BLOCK);
+	mismatches += BENCHMARK_COMPRESSION(EF_BC7_UNORM_BLOCK);
+	if (mismatches)
+		printf("ERROR: %u bytes compressed differently with threads in total!\n",mismatches);
+
+	return 0;
+}
@@ -0,0 +1,101 @@
+#define _IRR_STATIC_LIB_
+#include <irrlicht.h>
+
+#include <chrono>
+#include <random>
+#include <cstdio>
+
+using namespace irr;
+using namespace core;
+
+constexpr uint32_t RECTANGLE_COUNT = 4096u;
+constexpr uint32_t FRAME_COUNT = 8u;
+
+struct SGradientRectangle
+{
+	core::rectf Position;
+	video::SColor Corners[4];
+};
+
+//! Renders the scene with the Burning driver on the console device so no window is needed, @returns milliseconds per frame or a negative value if the device could not be created
+static double benchmarkResolution(const core::dimension2d<uint32_t>& _size, uint32_t _threads, const core::vector<SGradientRectangle>& _scene)
+{
+	// the console device draws the frame as ASCII art, send that into a file nobody reads
+	FILE* sink = std::tmpfile();
+
+	SIrrlichtCreationParameters params;
+	params.DeviceType = EIDT_CONSOLE;
+	params.DriverType = video::EDT_BURNINGSVIDEO;
+	params.WindowSize = _size;
+	params.WindowId = sink;
+	params.SoftwareRasterizerThreads = _threads;
+	IrrlichtDevice* device = createDeviceEx(params);
+	if (!device)
+	{
+		if (sink)
+			fclose(sink);
+		return -1.0;
+	}
+
+	video::IVideoDriver* driver = device->getVideoDriver();
+	// scene is laid out in the unit square, so every resolution draws the same picture
+	core::vector<core::recti> rectangles(_scene.size());
+	for (size_t i=0u; i<_scene.size(); i++)
+	{
+		const auto& pos = _scene[i].Position;
+		rectangles[i] = core::recti(int32_t(pos.UpperLeftCorner.X*_size.Width),int32_t(pos.UpperLeftCorner.Y*_size.Height),int32_t(pos.LowerRightCorner.X*_size.Width),int32_t(pos.LowerRightCorner.Y*_size.Height));
+	}
+
+	double total = 0.0;
+	// first frame allocates the bins and the worker shaders, don't count it
+	for (uint32_t frame=0u; frame<=FRAME_COUNT; frame++)
+	{
+		auto start = std::chrono::high_resolution_clock::now();
+		driver->beginScene(true,true,video::SColor(255,0,0,0));
+		for (size_t i=0u; i<_scene.size(); i++)
+		{
+			const auto& corners = _scene[i].Corners;
+			driver->draw2DRectangle(rectangles[i],corners[0],corners[1],corners[2],corners[3]);
+		}
+		driver->endScene();
+		if (frame)
+			total += std::chrono::duration<double,std::milli>(std::chrono::high_resolution_clock::now()-start).count();
+	}
+
+	device->drop();
+	fclose(sink);
+	return total/double(FRAME_COUNT);
+}
+
+int main()
+{
+	std::mt19937 generator(0x40u);
+	std::uniform_real_distribution<float> unit(0.f,1.f);
+	std::uniform_real_distribution<float> extent(0.02f,0.4f);
+
+	core::vector<SGradientRectangle> scene(RECTANGLE_COUNT);
+	for (auto& rectangle : scene)
+	{
+		const core::vector2df center(unit(generator),unit(generator));
+		const core::vector2df halfExtent(extent(generator),extent(generator));
+		rectangle.Position = core::rectf(center-halfExtent,center+halfExtent);
+		for (auto& corner : rectangle.Corners)
+			corner.set(255u,generator()&0xffu,generator()&0xffu,generator()&0xffu);
+	}
+
+	const core::dimension2d<uint32_t> resolutions[] = {{640u,480u},{1280u,720u},{1920u,1080u},{3840u,2160u}};
+	for (const auto& resolution : resolutions)
+	{
+		const double serial = benchmarkResolution(resolution,1u,scene);
+		const double tiled = benchmarkResolution(resolution,0u,scene);
+		if (serial<0.0 || tiled<0.0)
+		{
+			printf("ERROR: could not create the Burning driver on the console device!\n");
+			return 1;
+		}
+
+		printf("%4ux%-4u %u rectangles 1 thread %8.2f ms, %2u threads %8.2f ms (x%.2f)\n",resolution.Width,resolution.Height,RECTANGLE_COUNT,serial,core::getDefaultThreadCount(),tiled,serial/tiled);
+	}
+
+	return 0;
+}
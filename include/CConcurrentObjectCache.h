@@ -1,6 +1,9 @@
 #ifndef __C_CONCURRENT_OBJECT_CACHE_H_INCLUDED__
 #define __C_CONCURRENT_OBJECT_CACHE_H_INCLUDED__
 
+#include <atomic>
+#include <thread>
+
 #include "CObjectCache.h"
 #include "../source/Irrlicht/FW_Mutex.h"
 
@@ -158,6 +161,291 @@ namespace impl
             return r;
         }
     };
+
+    //! Concurrent cache split into `ShardCount` independent caches by hash of the key, each one implementing Left-Right concurrency control.
+    /**
+    Every shard keeps two copies of its cache. Readers never wait and never write anything but a per-shard reader counter:
+    they just read whichever copy is currently published. A writer (writers are serialized per shard) modifies the hidden copy,
+    publishes it, waits for readers of the previous copy to drain (like an RCU grace period) and then repeats the modification on the previous copy.
+    As a consequence lookups only contend with writers to the same shard through a single cacheline, and never block.
+
+    Greeting and disposal functions are called exactly once per object by the wrapper itself (copies are created without them),
+    greeting before the object becomes visible to readers and disposal only once no reader can observe the object anymore.
+
+    Operations involving more than one shard (getSize(), outputAll(), contains(), clear(), changeObjectKey() across shards) are not atomic as a whole.
+    Memory use of the container (not of the cached objects) is doubled compared to CMakeCacheConcurrent.
+    */
+    template<typename CacheT, size_t ShardCount>
+    class CMakeCacheConcurrentSharded
+    {
+        static_assert(ShardCount>0u, "ShardCount must be at least 1");
+
+        using BaseCache = CacheT;
+        using K = typename std::remove_const<typename BaseCache::PairType::first_type>::type;
+        using T = typename BaseCache::CachedType;
+
+    public:
+        using IteratorType = typename BaseCache::IteratorType;
+        using ConstIteratorType = typename BaseCache::ConstIteratorType;
+        using RevIteratorType = typename BaseCache::RevIteratorType;
+        using ConstRevIteratorType = typename BaseCache::ConstRevIteratorType;
+        using RangeType = typename BaseCache::RangeType;
+        using ConstRangeType = typename BaseCache::ConstRangeType;
+        using PairType = typename BaseCache::PairType;
+        using MutablePairType = typename BaseCache::MutablePairType;
+        using CachedType = T;
+        using KeyType = typename BaseCache::KeyType;
+        using GreetFuncType = typename BaseCache::GreetFuncType;
+        using DisposalFuncType = typename BaseCache::DisposalFuncType;
+
+    private:
+        class CShard
+        {
+            public:
+                //! Runs `_func(const BaseCache&)` on the currently published copy
+                template<typename F>
+                inline auto read(F&& _func) const -> decltype(_func(std::declval<const BaseCache&>()))
+                {
+                    const uint32_t version = m_versionIndex.load();
+                    m_readIndicator[version].counter.fetch_add(1);
+                    struct SDepart
+                    {
+                        std::atomic<uint32_t>& counter;
+                        ~SDepart() { counter.fetch_sub(1); }
+                    } depart{m_readIndicator[version].counter};
+
+                    return _func(m_copies[m_leftRight.load()]);
+                }
+
+                //! Runs `_func(BaseCache&)` on both copies, returns result from the first run
+                template<typename F>
+                inline auto write(F&& _func) -> decltype(_func(std::declval<BaseCache&>()))
+                {
+                    std::lock_guard<core::mutex> lock(m_writeMutex);
+
+                    const uint32_t published = m_leftRight.load();
+                    auto retval = _func(m_copies[published^1u]);
+                    m_leftRight.store(published^1u);
+                    toggleVersionAndWait();
+                    _func(m_copies[published]);
+
+                    return retval;
+                }
+
+                //! For use in destructor only
+                inline BaseCache& getUnsafe() { return m_copies[0]; }
+
+            private:
+                inline void toggleVersionAndWait()
+                {
+                    const uint32_t prevVersion = m_versionIndex.load();
+                    const uint32_t nextVersion = prevVersion^1u;
+
+                    waitForReaders(nextVersion);
+                    m_versionIndex.store(nextVersion);
+                    waitForReaders(prevVersion);
+                }
+                inline void waitForReaders(uint32_t _version) const
+                {
+                    while (m_readIndicator[_version].counter.load() != 0u)
+                        std::this_thread::yield();
+                }
+
+                BaseCache m_copies[2];
+                std::atomic<uint32_t> m_leftRight{0u};
+                std::atomic<uint32_t> m_versionIndex{0u};
+                struct alignas(_IRR_SIMD_ALIGNMENT*2) SReadIndicator
+                {
+                    mutable std::atomic<uint32_t> counter{0u};
+                } m_readIndicator[2];
+                core::mutex m_writeMutex;
+        };
+
+        inline CShard& shardFor(const K& _key) { return m_shards[shardIndex(_key)]; }
+        inline const CShard& shardFor(const K& _key) const { return m_shards[shardIndex(_key)]; }
+        static inline size_t shardIndex(const K& _key)
+        {
+            // std::hash is often the identity (pointers!), so scramble it before taking the top bits
+            const uint64_t h = static_cast<uint64_t>(std::hash<K>()(_key))*0x9e3779b97f4a7c15ull;
+            return static_cast<size_t>((h>>32)%ShardCount);
+        }
+
+        void greet(T* _object) const
+        {
+            if (m_greetingFunc)
+                m_greetingFunc(_object);
+        }
+        void dispose(T* _object) const
+        {
+            if (m_disposalFunc)
+                m_disposalFunc(_object);
+        }
+
+        CShard m_shards[ShardCount];
+        GreetFuncType m_greetingFunc;
+        DisposalFuncType m_disposalFunc;
+
+    public:
+        CMakeCacheConcurrentSharded() = default;
+        CMakeCacheConcurrentSharded(const GreetFuncType& _greeting, const DisposalFuncType& _disposal) : m_greetingFunc(_greeting), m_disposalFunc(_disposal) {}
+        CMakeCacheConcurrentSharded(GreetFuncType&& _greeting, DisposalFuncType&& _disposal) : m_greetingFunc(std::move(_greeting)), m_disposalFunc(std::move(_disposal)) {}
+        // explicitely making concurrent caches non-copy-and-move-constructible and non-copy-and-move-assignable
+        CMakeCacheConcurrentSharded(const CMakeCacheConcurrentSharded&) = delete;
+        CMakeCacheConcurrentSharded(CMakeCacheConcurrentSharded&&) = delete;
+        CMakeCacheConcurrentSharded& operator=(const CMakeCacheConcurrentSharded&) = delete;
+        CMakeCacheConcurrentSharded& operator=(CMakeCacheConcurrentSharded&&) = delete;
+
+        ~CMakeCacheConcurrentSharded()
+        {
+            for (auto& shard : m_shards)
+            for (auto it = shard.getUnsafe().begin(); it != shard.getUnsafe().end(); ++it)
+                dispose(it->second);
+        }
+
+        template<typename RngT>
+        static bool isNonZeroRange(const RngT& _rng) { return BaseCache::isNonZeroRange(_rng); }
+
+        inline bool insert(const K& _key, T* _val)
+        {
+            bool first = true;
+            return shardFor(_key).write([&](BaseCache& _cache) {
+                const bool r = _cache.insert(_key, _val);
+                // first run is on the hidden copy, so the object is greeted before anyone can find it
+                if (r && first)
+                    greet(_val);
+                first = false;
+                return r;
+            });
+        }
+
+        inline bool contains(const T* _object) const
+        {
+            for (const auto& shard : m_shards)
+            if (shard.read([&](const BaseCache& _cache) { return _cache.contains(_object); }))
+                return true;
+            return false;
+        }
+
+        inline size_t getSize() const
+        {
+            size_t r = 0u;
+            for (const auto& shard : m_shards)
+                r += shard.read([](const BaseCache& _cache) { return _cache.getSize(); });
+            return r;
+        }
+
+        inline void clear()
+        {
+            core::vector<MutablePairType> removed;
+            for (auto& shard : m_shards)
+            {
+                removed.clear();
+                bool first = true;
+                shard.write([&](BaseCache& _cache) {
+                    if (first)
+                    {
+                        size_t sz = 0u;
+                        _cache.outputAll(sz, static_cast<MutablePairType*>(nullptr));
+                        removed.resize(sz);
+                        _cache.outputAll(sz, removed.data());
+                        first = false;
+                    }
+                    _cache.clear();
+                    return true;
+                });
+                for (const auto& e : removed)
+                    dispose(e.second);
+            }
+        }
+
+        //! Returns true if had to insert
+        bool swapObjectValue(const K& _key, const T* _obj, T* _val)
+        {
+            greet(_val); // grab before drop
+            const bool r = shardFor(_key).write([&](BaseCache& _cache) { return _cache.swapObjectValue(_key, _obj, _val); });
+            if (!r)
+                dispose(const_cast<T*>(_obj));
+            return r;
+        }
+
+        bool getAndStoreKeyRangeOrReserve(const K& _key, size_t& _inOutStorageSize, T** _out, bool* _gotAll)
+        {
+            bool first = true;
+            const bool r = shardFor(_key).write([&](BaseCache& _cache) {
+                if (!first) // second copy only needs the reservation
+                {
+                    size_t dummySz = 0u;
+                    return _cache.getAndStoreKeyRangeOrReserve(_key, dummySz, static_cast<T**>(nullptr), nullptr);
+                }
+                first = false;
+                return _cache.getAndStoreKeyRangeOrReserve(_key, _inOutStorageSize, _out, _gotAll);
+            });
+            if (!r)
+                greet(nullptr);
+            return r;
+        }
+
+        inline bool removeObject(T* _object, const K& _key)
+        {
+            const bool r = shardFor(_key).write([&](BaseCache& _cache) { return _cache.removeObject(_object, _key); });
+            // both copies are rid of the object and no reader can be looking at the old one anymore
+            if (r)
+                dispose(_object);
+            return r;
+        }
+
+        inline bool findAndStoreRange(const K& _key, size_t& _inOutStorageSize, MutablePairType* _out) const
+        {
+            return shardFor(_key).read([&](const BaseCache& _cache) { return _cache.findAndStoreRange(_key, _inOutStorageSize, _out); });
+        }
+
+        inline bool findAndStoreRange(const K& _key, size_t& _inOutStorageSize, CachedType** _out) const
+        {
+            return shardFor(_key).read([&](const BaseCache& _cache) { return _cache.findAndStoreRange(_key, _inOutStorageSize, _out); });
+        }
+
+        inline bool outputAll(size_t& _inOutStorageSize, MutablePairType* _out) const
+        {
+            if (!_out)
+            {
+                _inOutStorageSize = getSize();
+                return false;
+            }
+
+            const size_t capacity = _inOutStorageSize;
+            size_t written = 0u;
+            size_t required = 0u;
+            for (const auto& shard : m_shards)
+            {
+                shard.read([&](const BaseCache& _cache) {
+                    required += _cache.getSize();
+                    if (written < capacity)
+                    {
+                        size_t sz = capacity-written;
+                        _cache.outputAll(sz, _out+written);
+                        written += sz;
+                    }
+                    return true;
+                });
+            }
+            _inOutStorageSize = written;
+            return capacity <= required;
+        }
+
+        inline bool changeObjectKey(T* _obj, const K& _key, const K& _newKey)
+        {
+            CShard& oldShard = shardFor(_key);
+            CShard& newShard = shardFor(_newKey);
+            if (&oldShard == &newShard)
+                return oldShard.write([&](BaseCache& _cache) { return _cache.changeObjectKey(_obj, _key, _newKey); });
+
+            constexpr bool DoGreetOrDispose = false;
+            if (!oldShard.write([&](BaseCache& _cache) { return _cache.template removeObject<DoGreetOrDispose>(_obj, _key); }))
+                return false;
+            newShard.write([&](BaseCache& _cache) { return _cache.template insert<DoGreetOrDispose>(_newKey, _obj); });
+            return true;
+        }
+    };
 }
 
 template<
@@ -182,6 +470,32 @@ using CConcurrentMultiObjectCache =
         CMultiObjectCache<K, T, ContainerT_T, Alloc>
     >;
 
+template<
+    typename K,
+    typename T,
+    template<typename...> class ContainerT_T = std::vector,
+    typename Alloc = core::allocator<typename impl::key_val_pair_type_for<ContainerT_T, K, T>::type>,
+    size_t ShardCount = 16u
+>
+using CShardedConcurrentObjectCache =
+    impl::CMakeCacheConcurrentSharded<
+        CObjectCache<K, T, ContainerT_T, Alloc>,
+        ShardCount
+    >;
+
+template<
+    typename K,
+    typename T,
+    template<typename...> class ContainerT_T = std::vector,
+    typename Alloc = core::allocator<typename impl::key_val_pair_type_for<ContainerT_T, K, T>::type>,
+    size_t ShardCount = 16u
+>
+using CShardedConcurrentMultiObjectCache =
+    impl::CMakeCacheConcurrentSharded<
+        CMultiObjectCache<K, T, ContainerT_T, Alloc>,
+        ShardCount
+    >;
+
 }}
 
 #endif
@@ -24,6 +24,8 @@ namespace scene
             {
                 if (boneNames)
                     _IRR_DELETE_ARRAY(boneNames,boneCount);
+                if (boneNameIndex)
+                    free(boneNameIndex);
                 if (boneFlatArray)
                     free(boneFlatArray);
                 if (boneTreeLevelEnd)
@@ -38,6 +40,10 @@ namespace scene
                     free(interpolatedAnimations);
                 if (nonInterpolatedAnimations)
                     free(nonInterpolatedAnimations);
+                if (soaInterpolatedAnimations)
+                    _IRR_ALIGNED_FREE(soaInterpolatedAnimations);
+                if (soaNonInterpolatedAnimations)
+                    _IRR_ALIGNED_FREE(soaNonInterpolatedAnimations);
             }
         public:
             #include "irr/irrpack.h"
@@ -56,19 +62,45 @@ namespace scene
                 float Scale[3];
                 float Padding[2];
             } PACK_STRUCT;
+            //! Entry of the name lookup table, the table is sorted by `nameHash` and serialized with the hierarchy
+            struct BoneNameIndexEntry
+            {
+                uint32_t nameHash;
+                uint32_t boneID;
+            } PACK_STRUCT;
             #include "irr/irrunpack.h"
 
+            //! Amount of bones getMatricesFromKeys evaluates at once
+            _IRR_STATIC_INLINE_CONSTEXPR size_t SoABatchSize = 4u;
+            //! Rows of a keyframe in the SoA copy of the animation data
+            enum E_SOA_KEY_COMPONENT
+            {
+                ESKC_ROTATION_X=0,
+                ESKC_ROTATION_Y,
+                ESKC_ROTATION_Z,
+                ESKC_ROTATION_W,
+                ESKC_POSITION_X,
+                ESKC_POSITION_Y,
+                ESKC_POSITION_Z,
+                ESKC_SCALE_X,
+                ESKC_SCALE_Y,
+                ESKC_SCALE_Z,
+                ESKC_COUNT
+            };
+
 
             CFinalBoneHierarchy(const core::vector<asset::ICPUSkinnedMesh::SJoint*>& inLevelFixedJoints, const core::vector<size_t>& inJointsLevelEnd)
-                    : boneCount(inLevelFixedJoints.size()), NumLevelsInHierarchy(inJointsLevelEnd.size()),
+                    : boneCount(inLevelFixedJoints.size()), boneNameIndex(NULL), NumLevelsInHierarchy(inJointsLevelEnd.size()),
                     ///boundBuffer(NULL),
-                    keyframeCount(0), keyframes(NULL), interpolatedAnimations(NULL), nonInterpolatedAnimations(NULL)
+                    keyframeCount(0), keyframes(NULL), interpolatedAnimations(NULL), nonInterpolatedAnimations(NULL),
+                    soaRowPitch(0), soaInterpolatedAnimations(NULL), soaNonInterpolatedAnimations(NULL)
             {
                 boneFlatArray = (BoneReferenceData*)malloc(sizeof(BoneReferenceData)*boneCount);
                 boneNames = _IRR_NEW_ARRAY(core::stringc,boneCount);
                 for (size_t i=0; i<boneCount; i++)
                 {
                     asset::ICPUSkinnedMesh::SJoint* joint = inLevelFixedJoints[i];
+                    boneNames[i] = joint->Name.c_str();
                     boneFlatArray[i].PoseBindMatrix = joint->GlobalInversedMatrix;
                     boneFlatArray[i].MinBBoxEdge[0] = joint->bbox.MinEdge.X;
                     boneFlatArray[i].MinBBoxEdge[1] = joint->bbox.MinEdge.Y;
@@ -98,7 +130,9 @@ namespace scene
                 boneTreeLevelEnd = (size_t*)malloc(sizeof(size_t)*NumLevelsInHierarchy);
                 memcpy(boneTreeLevelEnd,inJointsLevelEnd.data(),sizeof(size_t)*NumLevelsInHierarchy);
 
+                createBoneNameIndex();
                 createAnimationKeys(inLevelFixedJoints);
+                createSoAAnimationKeys();
             }
 
 			CFinalBoneHierarchy(const void* _bonesBegin, const void* _bonesEnd,
@@ -106,8 +140,10 @@ namespace scene
 				const std::size_t* _levelsBegin, const std::size_t* _levelsEnd,
 				const float* _keyframesBegin, const float* _keyframesEnd,
 				const void* _interpAnimsBegin, const void* _interpAnimsEnd,
-				const void* _nonInterpAnimsBegin, const void* _nonInterpAnimsEnd)
-			: boneCount((BoneReferenceData*)_bonesEnd - (BoneReferenceData*)_bonesBegin), NumLevelsInHierarchy(_levelsEnd - _levelsBegin), keyframeCount(_keyframesEnd - _keyframesBegin)
+				const void* _nonInterpAnimsBegin, const void* _nonInterpAnimsEnd,
+				const void* _boneNameIndexBegin = NULL, const void* _boneNameIndexEnd = NULL)
+			: boneCount((BoneReferenceData*)_bonesEnd - (BoneReferenceData*)_bonesBegin), boneNameIndex(NULL), NumLevelsInHierarchy(_levelsEnd - _levelsBegin), keyframeCount(_keyframesEnd - _keyframesBegin),
+				soaRowPitch(0), soaInterpolatedAnimations(NULL), soaNonInterpolatedAnimations(NULL)
 			{
 				_IRR_DEBUG_BREAK_IF(_bonesBegin > _bonesEnd ||
 					_boneNamesBegin > _boneNamesEnd ||
@@ -134,6 +170,18 @@ namespace scene
 				memcpy(keyframes, _keyframesBegin, sizeof(float)*keyframeCount);
 				memcpy(interpolatedAnimations, _interpAnimsBegin, sizeof(AnimationKeyData)*getAnimationCount());
 				memcpy(nonInterpolatedAnimations, _nonInterpAnimsBegin, sizeof(AnimationKeyData)*getAnimationCount());
+
+				// files written before the index got serialized don't have one
+				boneNameIndex = (BoneNameIndexEntry*)malloc(sizeof(BoneNameIndexEntry)*boneCount);
+				if ((BoneNameIndexEntry*)_boneNameIndexEnd-(BoneNameIndexEntry*)_boneNameIndexBegin==static_cast<std::make_signed<decltype(boneCount)>::type>(boneCount))
+				{
+					memcpy(boneNameIndex, _boneNameIndexBegin, sizeof(BoneNameIndexEntry)*boneCount);
+					if (!isBoneNameIndexValid())
+						createBoneNameIndex();
+				}
+				else
+					createBoneNameIndex();
+				createSoAAnimationKeys();
 			}
 
 			virtual void* serializeToBlob(void* _stackPtr = NULL, const size_t& _stackSize = 0) const
@@ -156,6 +204,10 @@ namespace scene
 			{
 				return sizeof(*interpolatedAnimations);
 			}
+			static inline size_t getSizeOfSingleBoneNameIndexEntry()
+			{
+				return sizeof(*boneNameIndex);
+			}
 
             inline const size_t& getBoneCount() const {return boneCount;}
 
@@ -171,17 +223,22 @@ namespace scene
                 return boneNames[boneID];
             }
 
+            //! Finds the bone by hashing its name and binary searching the name index, @returns 0xdeadbeefu if there is no such bone
             inline size_t getBoneIDFromName(const char* name) const
             {
-                for (size_t i=0; i<boneCount; i++)
+                const uint32_t nameHash = hashBoneName(name);
+                const BoneNameIndexEntry* it = std::lower_bound(boneNameIndex,boneNameIndex+boneCount,nameHash,[](const BoneNameIndexEntry& entry, const uint32_t& h) {return entry.nameHash<h;});
+                for (; it!=boneNameIndex+boneCount&&it->nameHash==nameHash; it++)
                 {
-                    if (boneNames[i]==name)
-                        return i;
+                    if (boneNames[it->boneID]==name)
+                        return it->boneID;
                 }
 
                 return 0xdeadbeefu;
             }
 
+            inline const BoneNameIndexEntry* getBoneNameIndex() const {return boneNameIndex;}
+
             inline const size_t& getHierarchyLevels() const {return NumLevelsInHierarchy;}
 
 
@@ -269,10 +326,35 @@ namespace scene
                 return getLowerBoundBoneKeyframes(tmpDummy,frame);
             }
 
+            //! Same as getLowerBoundBoneKeyframes(float&,const float&) but starts the search at `cursor`, which gets updated for the next call.
+            /** A cursor kept per playing instance makes normal playback (the frame stays or advances to the next keyframe) O(1),
+            any other jump falls back to the binary search. Cursors stay safe to use after the keyframes change, they just miss once.
+            @param cursor Position of std::lower_bound of the last frame within getKeys(), start with 0. */
+            inline size_t getLowerBoundBoneKeyframes(float& interpolationFactor, const float& frame, uint32_t& cursor) const
+            {
+                const float* found;
+                if (isLowerBoundOf(cursor,frame))
+                    found = keyframes+cursor;
+                else if (isLowerBoundOf(cursor+1u,frame))
+                    found = keyframes+cursor+1u;
+                else
+                    found = std::lower_bound(keyframes,keyframes+keyframeCount,frame);
+                cursor = found-keyframes;
+                return getLowerBoundBoneKeyframes(interpolationFactor, frame, found);
+            }
+
             inline const AnimationKeyData* getInterpolatedAnimationData(const size_t& boneID=0) const {return interpolatedAnimations+keyframeCount*boneID;}
 
             inline const AnimationKeyData* getNonInterpolatedAnimationData(const size_t& boneID=0) const {return nonInterpolatedAnimations+keyframeCount*boneID;}
 
+            //! Same animation data as above transposed for SIMD, ESKC_COUNT rows of getSoARowPitch() floats per keyframe, every row holds one component for all bones
+            /** A row has at least SoABatchSize-1 floats of padding past the last bone, so a batch can start at any bone. */
+            inline const float* getSoAAnimationData(const size_t& keyframe, const bool& interpolated=true) const
+            {
+                return (interpolated ? soaInterpolatedAnimations:soaNonInterpolatedAnimations)+keyframe*ESKC_COUNT*soaRowPitch;
+            }
+            inline const size_t& getSoARowPitch() const {return soaRowPitch;}
+
 
             //interpolant of 1 means full B
             static inline void getMatrixFromKeys(core::vectorSIMDf& outPos, core::quaternion& outQuat, core::vectorSIMDf& outScale,
@@ -317,6 +399,63 @@ namespace scene
                 return getMatrixFromKeys(keyframe,keyframe,1.f,0.25f,0.f);
             }
 
+            //! Does the same as getMatrixFromKeys for the SoABatchSize bones starting at `firstBone`, one bone per SIMD lane.
+            /** @param keyframeA Keyframe from getSoAAnimationData
+            @param keyframeB Keyframe from getSoAAnimationData, same as `keyframeA` with an interpolant of 1 to get the same as getMatrixFromKey */
+            static inline void getMatricesFromKeys(core::matrix3x4SIMD* outMatrices, const float* keyframeA, const float* keyframeB, const size_t& rowPitch, const size_t& firstBone,
+                                                   const float& interpolant, const float& interpolantPrecalcTerm2, const float& interpolantPrecalcTerm3)
+            {
+                keyframeA += firstBone;
+                keyframeB += firstBone;
+                core::vectorSIMDf a[ESKC_COUNT],b[ESKC_COUNT];
+                for (size_t i=0; i<ESKC_COUNT; i++)
+                {
+                    a[i] = core::vectorSIMDf(keyframeA+i*rowPitch);
+                    b[i] = core::vectorSIMDf(keyframeB+i*rowPitch);
+                }
+                const core::vectorSIMDf t(interpolant);
+
+                // quaternion::flerp_adjustedinterpolant
+                const core::vectorSIMDf angle = (a[ESKC_ROTATION_X]*b[ESKC_ROTATION_X]+a[ESKC_ROTATION_Y]*b[ESKC_ROTATION_Y])+(a[ESKC_ROTATION_Z]*b[ESKC_ROTATION_Z]+a[ESKC_ROTATION_W]*b[ESKC_ROTATION_W]);
+                const core::vectorSIMDf absAngle = core::abs(angle);
+                const core::vectorSIMDf A = core::vectorSIMDf(1.0904f)+absAngle*(core::vectorSIMDf(-3.2452f)+absAngle*(core::vectorSIMDf(3.55645f)-absAngle*core::vectorSIMDf(1.43519f)));
+                const core::vectorSIMDf B = core::vectorSIMDf(0.848013f)+absAngle*(core::vectorSIMDf(-1.06021f)+absAngle*core::vectorSIMDf(0.215638f));
+                const core::vectorSIMDf k = A*core::vectorSIMDf(interpolantPrecalcTerm2)+B;
+                const core::vectorSIMDf adjustedInterpolant = t+core::vectorSIMDf(interpolantPrecalcTerm3)*k;
+
+                // quaternion::lerp with the sign of B flipped in lanes where the quaternions are on opposite sides of the double cover, then normalize
+                const __m128i signFlip = _mm_and_si128((angle<core::vectorSIMDf(0.f)).getAsRegister(),_mm_set1_epi32(0x80000000));
+                core::vectorSIMDf rot[4];
+                for (size_t i=0; i<4; i++)
+                    rot[i] = core::mix(a[ESKC_ROTATION_X+i],b[ESKC_ROTATION_X+i]^signFlip,adjustedInterpolant);
+                const core::vectorSIMDf rotLength = core::sqrt((rot[0]*rot[0]+rot[1]*rot[1])+(rot[2]*rot[2]+rot[3]*rot[3]));
+                const core::vectorSIMDf x = rot[0]/rotLength;
+                const core::vectorSIMDf y = rot[1]/rotLength;
+                const core::vectorSIMDf z = rot[2]/rotLength;
+                const core::vectorSIMDf w = rot[3]/rotLength;
+
+                core::vectorSIMDf pos[3],scale[3],dblScale[3];
+                for (size_t i=0; i<3; i++)
+                {
+                    pos[i] = (b[ESKC_POSITION_X+i]-a[ESKC_POSITION_X+i])*t+a[ESKC_POSITION_X+i];
+                    scale[i] = (b[ESKC_SCALE_X+i]-a[ESKC_SCALE_X+i])*t+a[ESKC_SCALE_X+i];
+                    dblScale[i] = scale[i]*2.f;
+                }
+
+                // matrix3x4SIMD::setScaleRotationAndTranslation, each variable holds one matrix element for all the bones
+                core::vectorSIMDf rows[3][4] = {
+                    {scale[0]-(y*(y*dblScale[0])+(z*z)*dblScale[0]), y*(x*dblScale[1])-(z*w)*dblScale[1], y*(w*dblScale[2])+(z*x)*dblScale[2], pos[0]},
+                    {z*(w*dblScale[0])+(x*y)*dblScale[0], scale[1]-(z*(z*dblScale[1])+(x*x)*dblScale[1]), z*(y*dblScale[2])-(x*w)*dblScale[2], pos[1]},
+                    {x*(z*dblScale[0])-(y*w)*dblScale[0], x*(w*dblScale[1])+(y*z)*dblScale[1], scale[2]-(x*(x*dblScale[2])+(y*y)*dblScale[2]), pos[2]}
+                };
+                for (size_t i=0; i<3; i++)
+                {
+                    core::transpose4(rows[i]);
+                    for (size_t j=0; j<SoABatchSize; j++)
+                        outMatrices[j].rows[i] = rows[i][j];
+                }
+            }
+
             //effectively downsamples our animation
             inline void deleteKeyframes(const size_t& keyframesToRemoveCount, const float* sortedKeyFramesToRemove)
             {
@@ -377,6 +516,7 @@ namespace scene
 
                 //won't resize data buffers because cba
                 keyframeCount = keyframesOut-keyframes;
+                createSoAAnimationKeys();
             }
 
             //effectively upsamples our animation
@@ -387,11 +527,11 @@ namespace scene
                 const AnimationKeyData* inAnimationsIn = interpolatedAnimations;
                 const AnimationKeyData* noAnimationsIn = nonInterpolatedAnimations;
 
-                float* newKeyframes = (float*)malloc(keyframeCount+keyframesToAddCount);
+                float* newKeyframes = (float*)malloc(sizeof(float)*(keyframeCount+keyframesToAddCount));
                 float* newKeyframesOut = newKeyframes;
-                AnimationKeyData* newInAnimations = (AnimationKeyData*)malloc((keyframeCount+keyframesToAddCount)*boneCount);
+                AnimationKeyData* newInAnimations = (AnimationKeyData*)malloc(sizeof(AnimationKeyData)*(keyframeCount+keyframesToAddCount)*boneCount);
                 AnimationKeyData* newInAnimationsOut = newInAnimations;
-                AnimationKeyData* newNoAnimations = (AnimationKeyData*)malloc((keyframeCount+keyframesToAddCount)*boneCount);
+                AnimationKeyData* newNoAnimations = (AnimationKeyData*)malloc(sizeof(AnimationKeyData)*(keyframeCount+keyframesToAddCount)*boneCount);
                 AnimationKeyData* newNoAnimationsOut = newNoAnimations;
 
                 auto copyKeyframeFunc = [&]()
@@ -462,6 +602,7 @@ namespace scene
                 interpolatedAnimations = newInAnimations;
                 nonInterpolatedAnimations = newNoAnimations;
                 keyframeCount = newKeyframesOut-newKeyframes;
+                createSoAAnimationKeys();
             }
 
             //typedef for an interpolation function when adding interpolated offsets to animation
@@ -490,9 +631,52 @@ namespace scene
                     for (float* found=start; found<end; found++)
                         transformFunc(it++,i,*found,this,true);
                 }
+                createSoAAnimationKeys();
             }
 
         private:
+            //! (Re)builds the SoA copy of the animation data, has to be called whenever the keyframes change
+            inline void createSoAAnimationKeys()
+            {
+                if (soaInterpolatedAnimations)
+                    _IRR_ALIGNED_FREE(soaInterpolatedAnimations);
+                if (soaNonInterpolatedAnimations)
+                    _IRR_ALIGNED_FREE(soaNonInterpolatedAnimations);
+
+                // round up to the batch size after adding the padding, the rows stay aligned
+                soaRowPitch = ((boneCount+2u*(SoABatchSize-1u))/SoABatchSize)*SoABatchSize;
+                const size_t soaSize = sizeof(float)*ESKC_COUNT*soaRowPitch*keyframeCount;
+                soaInterpolatedAnimations = reinterpret_cast<float*>(_IRR_ALIGNED_MALLOC(soaSize,_IRR_SIMD_ALIGNMENT));
+                soaNonInterpolatedAnimations = reinterpret_cast<float*>(_IRR_ALIGNED_MALLOC(soaSize,_IRR_SIMD_ALIGNMENT));
+
+                auto transpose = [&](float* out, const AnimationKeyData* in)
+                {
+                    for (size_t m=0; m<keyframeCount; m++)
+                    {
+                        float* keyframeOut = out+m*ESKC_COUNT*soaRowPitch;
+                        // padding is an identity transform, so that the unused lanes stay finite
+                        for (size_t i=0; i<ESKC_COUNT; i++)
+                        {
+                            const float padding = i==ESKC_ROTATION_W||i>=ESKC_SCALE_X ? 1.f:0.f;
+                            std::fill(keyframeOut+i*soaRowPitch+boneCount,keyframeOut+(i+1u)*soaRowPitch,padding);
+                        }
+                        for (size_t j=0; j<boneCount; j++)
+                        {
+                            const AnimationKeyData& key = in[keyframeCount*j+m];
+                            for (size_t i=0; i<4; i++)
+                                keyframeOut[(ESKC_ROTATION_X+i)*soaRowPitch+j] = key.Rotation[i];
+                            for (size_t i=0; i<3; i++)
+                            {
+                                keyframeOut[(ESKC_POSITION_X+i)*soaRowPitch+j] = key.Position[i];
+                                keyframeOut[(ESKC_SCALE_X+i)*soaRowPitch+j] = key.Scale[i];
+                            }
+                        }
+                    }
+                };
+                transpose(soaInterpolatedAnimations,interpolatedAnimations);
+                transpose(soaNonInterpolatedAnimations,nonInterpolatedAnimations);
+            }
+
             inline void createAnimationKeys(const core::vector<asset::ICPUSkinnedMesh::SJoint*>& inLevelFixedJoints)
             {
                 core::unordered_set<float> sortedFrames;
@@ -708,10 +892,53 @@ namespace scene
             }
 
         private:
+            //! FNV-1a, has to give the same result on every platform as the index gets saved to files
+            static inline uint32_t hashBoneName(const char* name)
+            {
+                uint32_t retval = 2166136261u;
+                for (; *name; name++)
+                {
+                    retval ^= static_cast<uint8_t>(*name);
+                    retval *= 16777619u;
+                }
+                return retval;
+            }
+
+            inline void createBoneNameIndex()
+            {
+                if (!boneNameIndex)
+                    boneNameIndex = (BoneNameIndexEntry*)malloc(sizeof(BoneNameIndexEntry)*boneCount);
+                for (size_t i=0; i<boneCount; i++)
+                {
+                    boneNameIndex[i].nameHash = hashBoneName(boneNames[i].c_str());
+                    boneNameIndex[i].boneID = i;
+                }
+                std::sort(boneNameIndex,boneNameIndex+boneCount,[](const BoneNameIndexEntry& a, const BoneNameIndexEntry& b) {return a.nameHash<b.nameHash||(a.nameHash==b.nameHash&&a.boneID<b.boneID);});
+            }
+
+            //! Cheap sanity check of a loaded index, hashes are not recomputed
+            inline bool isBoneNameIndexValid() const
+            {
+                for (size_t i=0; i<boneCount; i++)
+                {
+                    if (boneNameIndex[i].boneID>=boneCount || (i && boneNameIndex[i].nameHash<boneNameIndex[i-1].nameHash))
+                        return false;
+                }
+                return true;
+            }
+
+            inline bool isLowerBoundOf(const uint32_t& keyframeIx, const float& frame) const
+            {
+                if (keyframeIx>keyframeCount)
+                    return false;
+                return (keyframeIx==0u || keyframes[keyframeIx-1u]<frame) && (keyframeIx==keyframeCount || frame<=keyframes[keyframeIx]);
+            }
+
             // bone hierachy independent from animations
             const size_t boneCount;
             BoneReferenceData* boneFlatArray;
             core::stringc* boneNames;
+            BoneNameIndexEntry* boneNameIndex;
             const size_t NumLevelsInHierarchy;
             size_t* boneTreeLevelEnd;
 
@@ -722,6 +949,10 @@ namespace scene
             float* keyframes;
             AnimationKeyData* interpolatedAnimations;
             AnimationKeyData* nonInterpolatedAnimations;
+            // the same in SoA layout
+            size_t soaRowPitch;
+            float* soaInterpolatedAnimations;
+            float* soaNonInterpolatedAnimations;
     };
 
 } // end namespace scene
@@ -11,6 +11,7 @@
 #include "irr/static_if.h"
 #include "irr/macros.h"
 #include "irr/core/Types.h"
+#include "irr/core/flat_hash_multimap.h"
 
 namespace irr { namespace core
 {
@@ -43,6 +44,8 @@ namespace impl
     struct is_multi_container<std::multimap> : std::true_type {};
     template<>
     struct is_multi_container<std::unordered_multimap> : std::true_type {};
+    template<>
+    struct is_multi_container<core::flat_hash_multimap> : std::true_type {};
 
     template<template<typename...> class>
     struct is_assoc_container : std::false_type {};
@@ -54,6 +57,8 @@ namespace impl
     struct is_assoc_container<std::multimap> : std::true_type {};
     template<>
     struct is_assoc_container<std::unordered_multimap> : std::true_type {};
+    template<>
+    struct is_assoc_container<core::flat_hash_multimap> : std::true_type {};
 
     template<typename K, typename...>
     struct IRR_FORCE_EBO PropagKeyTypeTypedef_ { using KeyType = K; };
@@ -703,7 +708,7 @@ class CMultiObjectCache<K, T, ContainerT_T, Alloc, false> :
     public impl::CDirectMultiCacheBase<false, ContainerT_T, Alloc, T*, const K>,
     public impl::PropagTypedefs<T, const K>
 {
-    static_assert(impl::is_same_templ<ContainerT_T, std::multimap>::value || impl::is_same_templ<ContainerT_T, std::unordered_multimap>::value, "ContainerT_T must be one of: std::vector, std::multimap, std::unordered_multimap");
+    static_assert(impl::is_same_templ<ContainerT_T, std::multimap>::value || impl::is_same_templ<ContainerT_T, std::unordered_multimap>::value || impl::is_same_templ<ContainerT_T, core::flat_hash_multimap>::value, "ContainerT_T must be one of: std::vector, std::multimap, std::unordered_multimap, core::flat_hash_multimap");
 
 private:
     using Base = impl::CDirectMultiCacheBase<false, ContainerT_T, Alloc, T*, const K>;
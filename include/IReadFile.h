@@ -43,6 +43,13 @@ namespace io
 		//! Get name of file.
 		/** \return File name as zero terminated character string. */
 		virtual const io::path& getFileName() const = 0;
+
+		//! Get pointer to the whole contents of the file, if the file is memory mapped.
+		/** The memory stays valid for as long as the file object is alive,
+		so grab() the file when holding on to the pointer.
+		\return Pointer to the first byte of the file, or nullptr if the file
+		can only be accessed through read(). */
+		virtual const void* getMappedPointer() const { return nullptr; }
 	};
 
 } // end namespace io
@@ -342,7 +342,7 @@ namespace scene
             class BoneHierarchyInstanceData : public core::AlignedBase<_IRR_SIMD_ALIGNMENT>
             {
                 public:
-                    BoneHierarchyInstanceData() : refCount(0), frame(0.f), lastAnimatedFrame(-1.f), interpolateAnimation(true), attachedNode(NULL)
+                    BoneHierarchyInstanceData() : refCount(0), frame(0.f), lastAnimatedFrame(-1.f), interpolateAnimation(true), keyframeCursor(0u), attachedNode(NULL)
                     {
                     }
 
@@ -356,6 +356,7 @@ namespace scene
                     };
 
                     bool interpolateAnimation;
+                    uint32_t keyframeCursor; //!< for CFinalBoneHierarchy::getLowerBoundBoneKeyframes, saves the binary search while playing forward
                     ISkinnedMeshSceneNode* attachedNode; //can be NULL
             };
             inline core::matrix4x3* getGlobalMatrices(BoneHierarchyInstanceData* currentInstance)
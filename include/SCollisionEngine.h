@@ -4,22 +4,64 @@
 #include "irrlicht.h"
 #include "SCompoundCollider.h"
 #include "SViewFrustum.h"
+#include "irr/core/flat_hash_map.h"
+
+#include <atomic>
 
 namespace irr
 {
 namespace core
 {
 
+//! Keeps the colliders in a dynamic AABB tree (broad phase), so a ray query only visits the colliders whose boxes the ray passes through.
+/** Leaves hold the world space bounding boxes of the colliders, enlarged by a margin so that small movements do not require any update.
+Colliders with an attached node are only moved in the tree by refit(), which has to be called once per frame after the nodes' absolute transformations were updated.
+The tree is kept balanced with the same rotations as an AVL tree, and internal nodes are chosen on insertion by the increase of surface area.
+*/
 class SCollisionEngine : public AllocationOverrideDefault
 {
-        vector<SCompoundCollider*> colliders;
+        _IRR_STATIC_INLINE_CONSTEXPR uint32_t InvalidNode = 0xffffffffu;
+        //! fraction of the extent by which leaf boxes are enlarged
+        _IRR_STATIC_INLINE_CONSTEXPR float FatBoxMargin = 0.1f;
+        _IRR_STATIC_INLINE_CONSTEXPR uint32_t MaxTreeHeight = 64u;
+        //! amount of rays FastCollideBatch traverses the tree with at once, one per SIMD lane
+        _IRR_STATIC_INLINE_CONSTEXPR uint32_t RayPacketSize = 4u;
+        //! smallest amount of packets worth giving to a thread
+        _IRR_STATIC_INLINE_CONSTEXPR size_t MinPacketsPerThread = 64u;
+
+        struct SBroadPhaseNode
+        {
+            vectorSIMDf MinEdge;
+            vectorSIMDf MaxEdge;
+            //! next free node for nodes in the free list
+            uint32_t parent;
+            uint32_t children[2];
+            //! 0 for leaves, -1 for free nodes
+            int32_t height;
+            SCompoundCollider* collider;
+
+            inline bool isLeaf() const {return children[0]==InvalidNode;}
+        };
+        struct SColliderEntry
+        {
+            uint32_t leaf;
+            //! index into movingColliders, only valid if the collider has an attached node
+            uint32_t movingIndex;
+            //! world transform the leaf's box was last computed with
+            matrix4x3 transform;
+        };
+        flat_hash_map<SCompoundCollider*,SColliderEntry> colliders;
+        //! colliders with an attached node, the only ones which can move
+        vector<SCompoundCollider*> movingColliders;
+        vector<SBroadPhaseNode> nodes;
+        uint32_t rootNode = InvalidNode;
+        uint32_t freeNodes = InvalidNode;
 
     public:
 		//! Destructor.
         ~SCollisionEngine()
         {
-			for (size_t i=0; i<colliders.size(); i++)
-				colliders[i]->drop();
+			colliders.for_each([](SCompoundCollider* collider, const SColliderEntry&) {collider->drop();});
         }
 #if 0
 		//! Returns a 3d ray which would go through the 2d screen coodinates.
@@ -102,18 +144,32 @@ class SCollisionEngine : public AllocationOverrideDefault
 		}
 
 		//! Adds a collider
-		/** @param collider A pointer to collider. */
+		/** The collider's shapes and collider data must not change while it is added, its attached node may move as long as refit() is called afterwards.
+		The leaf box is computed from the attached node's current absolute transformation, which is only up to date once the scene was drawn (or updateAbsolutePosition called).
+		@param collider A pointer to collider. */
         inline void addCompoundCollider(SCompoundCollider* collider)
         {
             if (!collider)
                 return;
 
-            auto found = std::lower_bound(colliders.begin(),colliders.end(),collider);
-            if (found!=colliders.end() && *found==collider)
-                return;
+            const size_t hash = colliders.hash(collider);
+            if (colliders.find(collider,hash))
+                return;
 
             collider->grab();
-            colliders.insert(found,collider);
+            SColliderEntry entry;
+            entry.leaf = allocateNode();
+            entry.movingIndex = InvalidNode;
+            if (collider->getColliderData().attachedNode)
+            {
+                collider->getWorldTransform(entry.transform);
+                entry.movingIndex = movingColliders.size();
+                movingColliders.push_back(collider);
+            }
+            nodes[entry.leaf].collider = collider;
+            setFatBox(nodes[entry.leaf],collider->getWorldBoundingBox());
+            insertLeaf(entry.leaf);
+            colliders.insert(std::move(collider),std::move(entry),hash);
         }
 
 		//! Removes collider pointed by `collider`
@@ -123,15 +179,56 @@ class SCollisionEngine : public AllocationOverrideDefault
             if (!collider)
                 return;
 
-            auto found = std::lower_bound(colliders.begin(),colliders.end(),collider);
-            if (found==colliders.end() || *found!=collider)
+            const size_t hash = colliders.hash(collider);
+            const SColliderEntry* found = colliders.find(collider,hash);
+            if (!found)
 			{
 //				FW_WriteToLog(kLogError,"removeCompoundCollider collider not found!\n");
                 return;
 			}
 
-			(*found)->drop();
-            colliders.erase(found);
+            if (found->movingIndex!=InvalidNode)
+            {
+                SCompoundCollider* last = movingColliders.back();
+                movingColliders[found->movingIndex] = last;
+                colliders.find(last)->movingIndex = found->movingIndex;
+                movingColliders.pop_back();
+            }
+            removeLeaf(found->leaf);
+            freeNode(found->leaf);
+            colliders.erase(collider,hash);
+			collider->drop();
+        }
+
+		//! Updates the broad phase after attached scene nodes have moved, call once per frame before any ray queries.
+		/** Only colliders with an attached node whose transformation changed since the last refit are considered,
+		a collider is only reinserted into the tree once it leaves its enlarged box.
+		Must not run concurrently with FastCollide or FastCollideBatch.
+		@returns Amount of colliders which had to be reinserted. */
+        inline uint32_t refit()
+        {
+            uint32_t reinserted = 0u;
+            for (SCompoundCollider* collider : movingColliders)
+            {
+                SColliderEntry* entry = colliders.find(collider);
+                matrix4x3 transform;
+                collider->getWorldTransform(transform);
+                if (transform==entry->transform)
+                    continue;
+                entry->transform = transform;
+
+                const aabbox3df box = collider->getWorldBoundingBox();
+                const SBroadPhaseNode& node = nodes[entry->leaf];
+                if (box.MinEdge.X>=node.MinEdge.X && box.MinEdge.Y>=node.MinEdge.Y && box.MinEdge.Z>=node.MinEdge.Z &&
+                    box.MaxEdge.X<=node.MaxEdge.X && box.MaxEdge.Y<=node.MaxEdge.Y && box.MaxEdge.Z<=node.MaxEdge.Z)
+                    continue;
+
+                removeLeaf(entry->leaf);
+                setFatBox(nodes[entry->leaf],box);
+                insertLeaf(entry->leaf);
+                reinserted++;
+            }
+            return reinserted;
         }
 
 		//! Gets current amount of colliders
@@ -139,7 +236,7 @@ class SCollisionEngine : public AllocationOverrideDefault
         inline size_t getColliderCount() const { return colliders.size(); }
 
 		//! Performs collision test with a given ray defined by `origin`, `direction` and `maxRayLen` parameters
-		/**
+		/** Colliders are tested where their attached nodes were at the last refit(), the narrow phase uses the nodes' current transformations.
 		@param[out] hitPointObjectData Data of collider with which the collision occured. Does not get touched if no collision occured.
 		@param[out] collisionDistance If no collision occured - gets value of `maxRayLen` parameter. Otherwise - ???
 		@param[in] origin Start point point of the input ray
@@ -151,19 +248,359 @@ class SCollisionEngine : public AllocationOverrideDefault
             bool retval = false;
 
             collisionDistance = maxRayLen;
-            for (size_t i=0; i<colliders.size(); i++)
+            if (rootNode==InvalidNode)
+                return false;
+
+            const vectorSIMDf invDirection = vectorSIMDf(1.f)/direction;
+            float entry;
+            if (!rayHitsBox(nodes[rootNode],origin,invDirection,collisionDistance,entry))
+                return false;
+
+            // nodes are pushed with the distance at which the ray enters them, so they can be skipped once a closer hit is found
+            struct SStackEntry
+            {
+                uint32_t node;
+                float entry;
+            } stack[MaxTreeHeight];
+            uint32_t stackSize = 0u;
+            stack[stackSize++] = {rootNode,entry};
+            while (stackSize)
             {
-                float tmpDist;
-                if (colliders[i]->CollideWithRay(tmpDist,origin,direction,collisionDistance)&&tmpDist<collisionDistance)
+                const SStackEntry current = stack[--stackSize];
+                if (current.entry>collisionDistance)
+                    continue;
+
+                const SBroadPhaseNode& node = nodes[current.node];
+                if (node.isLeaf())
                 {
-                    collisionDistance = tmpDist;
-                    hitPointObjectData = colliders[i]->getColliderData();
-                    retval = true;
+                    float tmpDist;
+                    if (node.collider->CollideWithRay(tmpDist,origin,direction,collisionDistance)&&tmpDist<collisionDistance)
+                    {
+                        collisionDistance = tmpDist;
+                        hitPointObjectData = node.collider->getColliderData();
+                        retval = true;
+                    }
+                    continue;
                 }
+
+                float entries[2];
+                const bool hits[2] = {rayHitsBox(nodes[node.children[0]],origin,invDirection,collisionDistance,entries[0]),
+                                        rayHitsBox(nodes[node.children[1]],origin,invDirection,collisionDistance,entries[1])};
+                // visit the nearer child first, which makes it more likely to cull the farther one
+                const uint32_t nearer = hits[1]&&(!hits[0]||entries[1]<entries[0]) ? 1u:0u;
+                const uint32_t farther = nearer^1u;
+                if (hits[farther])
+                    stack[stackSize++] = {node.children[farther],entries[farther]};
+                if (hits[nearer])
+                    stack[stackSize++] = {node.children[nearer],entries[nearer]};
             }
 
             return retval;
         }
+
+		//! Performs FastCollide for many rays at once
+		/** Consecutive rays are grouped into packets of 4 which traverse the broad phase together, with every box tested against the whole packet in SIMD.
+		A packet visits every node any of its rays enters, so order the rays such that neighbours go in similar directions (e.g. neighbouring pixels).
+		The packets are split across threads, the narrow phase tests of the colliders themselves are still done ray by ray.
+		@param[out] hitPointObjectData Array of `rayCount` elements, an element does not get touched if its ray did not collide.
+		@param[out] collisionDistances Array of `rayCount` elements, same as FastCollide's `collisionDistance` for every ray, `maxRayLen` if the ray did not collide.
+		@param[in] origins Array of `rayCount` ray start points
+		@param[in] directions Array of `rayCount` normalized ray directions
+		@param[in] rayCount Number of rays
+		@param[in] maxRayLen Length of all the rays
+		@param[in] threadCount Upper bound on the number of threads used, 0 means as many as there are hardware threads.
+		@returns Amount of rays which collided.
+		*/
+        inline size_t FastCollideBatch(SColliderData* hitPointObjectData, float* collisionDistances, const vectorSIMDf* origins, const vectorSIMDf* directions, size_t rayCount, const float& maxRayLen=FLT_MAX, uint32_t threadCount=0u) const
+        {
+            if (rootNode==InvalidNode)
+            {
+                std::fill(collisionDistances,collisionDistances+rayCount,maxRayLen);
+                return 0u;
+            }
+
+            std::atomic<size_t> hitCount(0u);
+            const size_t packetCount = (rayCount+RayPacketSize-1u)/RayPacketSize;
+            parallel_for<size_t>(0u,packetCount,[&](size_t packetBegin, size_t packetEnd)
+            {
+                size_t hits = 0u;
+                for (size_t packet=packetBegin; packet<packetEnd; packet++)
+                {
+                    const size_t firstRay = packet*RayPacketSize;
+                    const uint32_t packetRays = uint32_t(std::min<size_t>(rayCount-firstRay,RayPacketSize));
+                    hits += collidePacket(hitPointObjectData+firstRay,collisionDistances+firstRay,origins+firstRay,directions+firstRay,packetRays,maxRayLen);
+                }
+                hitCount += hits;
+            },threadCount,MinPacketsPerThread);
+            return hitCount;
+        }
+
+    private:
+        //! FastCollide for up to RayPacketSize rays traversing the tree together, returns the amount of rays that collided
+        inline uint32_t collidePacket(SColliderData* hitPointObjectData, float* collisionDistances, const vectorSIMDf* origins, const vectorSIMDf* directions, uint32_t rayCount, float maxRayLen) const
+        {
+            // packet in SoA layout, one ray per lane
+            vectorSIMDf packetOrigin[3];
+            vectorSIMDf packetInvDirection[3];
+            // unused lanes get a negative length so they never enter any box
+            vectorSIMDf packetLength(-1.f);
+            for (uint32_t i=0u; i<rayCount; i++)
+            {
+                for (uint32_t axis=0u; axis<3u; axis++)
+                {
+                    packetOrigin[axis].pointer[i] = origins[i].pointer[axis];
+                    packetInvDirection[axis].pointer[i] = 1.f/directions[i].pointer[axis];
+                }
+                packetLength.pointer[i] = maxRayLen;
+                collisionDistances[i] = maxRayLen;
+            }
+
+            // the first ray's direction decides which child to visit first for the whole packet
+            const vectorSIMDf& leadDirection = directions[0];
+            uint32_t stack[MaxTreeHeight];
+            uint32_t stackSize = 0u;
+            stack[stackSize++] = rootNode;
+            while (stackSize)
+            {
+                const SBroadPhaseNode& node = nodes[stack[--stackSize]];
+                // tested on pop rather than push, so the closest hits found in the meantime already cull it
+                uint32_t activeMask = packetHitsBox(node,packetOrigin,packetInvDirection,packetLength);
+                if (!activeMask)
+                    continue;
+
+                if (node.isLeaf())
+                {
+                    for (; activeMask; activeMask&=activeMask-1u)
+                    {
+                        const uint32_t lane = findLSB(activeMask);
+                        float tmpDist;
+                        if (node.collider->CollideWithRay(tmpDist,origins[lane],directions[lane],collisionDistances[lane])&&tmpDist<collisionDistances[lane])
+                        {
+                            collisionDistances[lane] = tmpDist;
+                            packetLength.pointer[lane] = tmpDist;
+                            hitPointObjectData[lane] = node.collider->getColliderData();
+                        }
+                    }
+                    continue;
+                }
+
+                // push the farther child first along the axis on which the children are the most apart
+                const vectorSIMDf centerOffset = (nodes[node.children[1]].MinEdge+nodes[node.children[1]].MaxEdge)-(nodes[node.children[0]].MinEdge+nodes[node.children[0]].MaxEdge);
+                const vectorSIMDf absOffset = abs(centerOffset);
+                const uint32_t axis = absOffset.X>=absOffset.Y ? (absOffset.X>=absOffset.Z ? 0u:2u):(absOffset.Y>=absOffset.Z ? 1u:2u);
+                const uint32_t nearer = centerOffset.pointer[axis]*leadDirection.pointer[axis]<0.f ? 1u:0u;
+                stack[stackSize++] = node.children[nearer^1u];
+                stack[stackSize++] = node.children[nearer];
+            }
+
+            // only hits make a ray shorter than maxRayLen
+            uint32_t hitCount = 0u;
+            for (uint32_t i=0u; i<rayCount; i++)
+                hitCount += collisionDistances[i]<maxRayLen ? 1u:0u;
+            return hitCount;
+        }
+
+        //! @returns Bitmask of the packet's rays which enter the box before reaching their length
+        static inline uint32_t packetHitsBox(const SBroadPhaseNode& node, const vectorSIMDf* packetOrigin, const vectorSIMDf* packetInvDirection, const vectorSIMDf& packetLength)
+        {
+            vectorSIMDf entry(0.f);
+            vectorSIMDf exit = packetLength;
+            for (uint32_t axis=0u; axis<3u; axis++)
+            {
+                const vectorSIMDf t0 = (vectorSIMDf(node.MinEdge.pointer[axis])-packetOrigin[axis])*packetInvDirection[axis];
+                const vectorSIMDf t1 = (vectorSIMDf(node.MaxEdge.pointer[axis])-packetOrigin[axis])*packetInvDirection[axis];
+                entry = max_(entry,min_(t0,t1));
+                exit = min_(exit,max_(t0,t1));
+            }
+            return _mm_movemask_ps(_mm_cmple_ps(entry.getAsRegister(),exit.getAsRegister()));
+        }
+
+        static inline bool rayHitsBox(const SBroadPhaseNode& node, const vectorSIMDf& origin, const vectorSIMDf& invDirection, float maxDistance, float& entry)
+        {
+            const vectorSIMDf t0 = (node.MinEdge-origin)*invDirection;
+            const vectorSIMDf t1 = (node.MaxEdge-origin)*invDirection;
+            const vectorSIMDf tNear = min_(t0,t1);
+            const vectorSIMDf tFar = max_(t0,t1);
+            entry = std::max(std::max(tNear.X,tNear.Y),std::max(tNear.Z,0.f));
+            const float exit = std::min(std::min(tFar.X,tFar.Y),std::min(tFar.Z,maxDistance));
+            return entry<=exit;
+        }
+
+        static inline float surfaceArea(const vectorSIMDf& minEdge, const vectorSIMDf& maxEdge)
+        {
+            const vectorSIMDf extent = maxEdge-minEdge;
+            return extent.X*extent.Y+extent.Y*extent.Z+extent.Z*extent.X;
+        }
+
+        static inline void setFatBox(SBroadPhaseNode& node, const aabbox3df& box)
+        {
+            vectorSIMDf minEdge,maxEdge;
+            minEdge.set(box.MinEdge);
+            maxEdge.set(box.MaxEdge);
+            const vectorSIMDf margin = (maxEdge-minEdge)*FatBoxMargin;
+            node.MinEdge = minEdge-margin;
+            node.MaxEdge = maxEdge+margin;
+        }
+
+        inline void refitFromChildren(SBroadPhaseNode& node)
+        {
+            const SBroadPhaseNode& first = nodes[node.children[0]];
+            const SBroadPhaseNode& second = nodes[node.children[1]];
+            node.MinEdge = min_(first.MinEdge,second.MinEdge);
+            node.MaxEdge = max_(first.MaxEdge,second.MaxEdge);
+            node.height = 1+std::max(first.height,second.height);
+        }
+
+        inline uint32_t allocateNode()
+        {
+            uint32_t ix;
+            if (freeNodes!=InvalidNode)
+            {
+                ix = freeNodes;
+                freeNodes = nodes[ix].parent;
+            }
+            else
+            {
+                ix = nodes.size();
+                nodes.emplace_back();
+            }
+            SBroadPhaseNode& node = nodes[ix];
+            node.parent = InvalidNode;
+            node.children[0] = node.children[1] = InvalidNode;
+            node.height = 0;
+            node.collider = nullptr;
+            return ix;
+        }
+
+        inline void freeNode(uint32_t ix)
+        {
+            nodes[ix].parent = freeNodes;
+            nodes[ix].height = -1;
+            freeNodes = ix;
+        }
+
+        inline void insertLeaf(uint32_t leaf)
+        {
+            if (rootNode==InvalidNode)
+            {
+                rootNode = leaf;
+                nodes[leaf].parent = InvalidNode;
+                return;
+            }
+
+            // descend towards the sibling which makes the tree's total surface area grow the least
+            const vectorSIMDf leafMin = nodes[leaf].MinEdge;
+            const vectorSIMDf leafMax = nodes[leaf].MaxEdge;
+            uint32_t sibling = rootNode;
+            while (!nodes[sibling].isLeaf())
+            {
+                const SBroadPhaseNode& node = nodes[sibling];
+                const float area = surfaceArea(node.MinEdge,node.MaxEdge);
+                const float combinedArea = surfaceArea(min_(node.MinEdge,leafMin),max_(node.MaxEdge,leafMax));
+                // cost of making a new parent for this node and the leaf
+                const float cost = 2.f*combinedArea;
+                // minimum cost of pushing the leaf further down the tree
+                const float inheritanceCost = 2.f*(combinedArea-area);
+
+                float childCosts[2];
+                for (uint32_t i=0u; i<2u; i++)
+                {
+                    const SBroadPhaseNode& child = nodes[node.children[i]];
+                    childCosts[i] = surfaceArea(min_(child.MinEdge,leafMin),max_(child.MaxEdge,leafMax))+inheritanceCost;
+                    if (!child.isLeaf())
+                        childCosts[i] -= surfaceArea(child.MinEdge,child.MaxEdge);
+                }
+
+                if (cost<childCosts[0] && cost<childCosts[1])
+                    break;
+                sibling = node.children[childCosts[1]<childCosts[0] ? 1u:0u];
+            }
+
+            const uint32_t oldParent = nodes[sibling].parent;
+            const uint32_t newParent = allocateNode();
+            nodes[newParent].parent = oldParent;
+            nodes[newParent].children[0] = sibling;
+            nodes[newParent].children[1] = leaf;
+            nodes[sibling].parent = newParent;
+            nodes[leaf].parent = newParent;
+            if (oldParent!=InvalidNode)
+                nodes[oldParent].children[nodes[oldParent].children[0]==sibling ? 0u:1u] = newParent;
+            else
+                rootNode = newParent;
+
+            refitAncestors(newParent);
+        }
+
+        inline void removeLeaf(uint32_t leaf)
+        {
+            if (leaf==rootNode)
+            {
+                rootNode = InvalidNode;
+                return;
+            }
+
+            const uint32_t parent = nodes[leaf].parent;
+            const uint32_t grandParent = nodes[parent].parent;
+            const uint32_t sibling = nodes[parent].children[nodes[parent].children[0]==leaf ? 1u:0u];
+            nodes[sibling].parent = grandParent;
+            freeNode(parent);
+            if (grandParent!=InvalidNode)
+            {
+                nodes[grandParent].children[nodes[grandParent].children[0]==parent ? 0u:1u] = sibling;
+                refitAncestors(grandParent);
+            }
+            else
+                rootNode = sibling;
+        }
+
+        //! Walks up from `ix` to the root, rebalancing and recomputing every node's box and height
+        inline void refitAncestors(uint32_t ix)
+        {
+            while (ix!=InvalidNode)
+            {
+                ix = balance(ix);
+                refitFromChildren(nodes[ix]);
+                ix = nodes[ix].parent;
+            }
+        }
+
+        //! If the subtrees of `a` differ in height by more than one, rotates the taller child up to take the place of `a`, returns the node now in that place
+        inline uint32_t balance(uint32_t a)
+        {
+            if (nodes[a].isLeaf() || nodes[a].height<2)
+                return a;
+
+            const int32_t heightDiff = nodes[nodes[a].children[1]].height-nodes[nodes[a].children[0]].height;
+            if (heightDiff>=-1 && heightDiff<=1)
+                return a;
+
+            // side of `a` on which the taller child is
+            const uint32_t tallSide = heightDiff>1 ? 1u:0u;
+            const uint32_t up = nodes[a].children[tallSide];
+            const uint32_t upChildren[2] = {nodes[up].children[0],nodes[up].children[1]};
+
+            // `up` takes the place of `a`, which becomes a child of `up`
+            nodes[up].children[0] = a;
+            nodes[up].parent = nodes[a].parent;
+            nodes[a].parent = up;
+            if (nodes[up].parent!=InvalidNode)
+            {
+                SBroadPhaseNode& parent = nodes[nodes[up].parent];
+                parent.children[parent.children[0]==a ? 0u:1u] = up;
+            }
+            else
+                rootNode = up;
+
+            // the taller grandchild stays with `up`, the shorter one goes to `a` in place of `up`
+            const uint32_t keep = nodes[upChildren[0]].height>nodes[upChildren[1]].height ? 0u:1u;
+            nodes[up].children[1] = upChildren[keep];
+            nodes[a].children[tallSide] = upChildren[keep^1u];
+            nodes[upChildren[keep^1u]].parent = a;
+
+            refitFromChildren(nodes[a]);
+            refitFromChildren(nodes[up]);
+            return up;
+        }
 };
 
 }
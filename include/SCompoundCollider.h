@@ -220,6 +220,30 @@ class SCompoundCollider : public IReferenceCounted
 
 		inline size_t getShapeCount() const { return Shapes.size(); }
 		inline const SAABoxCollider& getBoundingBox() const { return BBox; }
+
+		//! @returns Bounding box transformed by the attached node's (and instance's) transformation, the same as getBoundingBox() if there is no attached node.
+        inline aabbox3df getWorldBoundingBox() const
+        {
+            aabbox3df box = BBox.Box;
+            if (!colliderData.attachedNode)
+                return box;
+
+            if (colliderData.attachedNode->getType()==scene::ESNT_MESH_INSTANCED)
+                static_cast<scene::IMeshSceneNodeInstanced*>(colliderData.attachedNode)->getInstanceTransform(colliderData.instanceID).transformBoxEx(box);
+            colliderData.attachedNode->getAbsoluteTransformation().transformBoxEx(box);
+            return box;
+        }
+		//! @returns Whether there is an attached node, in which case `transform` is set to its (and the instance's) transformation which getWorldBoundingBox() applies.
+        inline bool getWorldTransform(matrix4x3& transform) const
+        {
+            if (!colliderData.attachedNode)
+                return false;
+
+            transform = colliderData.attachedNode->getAbsoluteTransformation();
+            if (colliderData.attachedNode->getType()==scene::ESNT_MESH_INSTANCED)
+                transform = concatenateBFollowedByA(transform,static_cast<scene::IMeshSceneNodeInstanced*>(colliderData.attachedNode)->getInstanceTransform(colliderData.instanceID));
+            return true;
+        }
         inline const SColliderData& getColliderData() const {return colliderData;}
 
 		//! Sets collider data.
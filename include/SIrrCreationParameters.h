@@ -42,6 +42,7 @@ namespace irr
 			LoggingLevel(ELL_INFORMATION),
 #endif
 			AuxGLContexts(0),
+			SoftwareRasterizerThreads(0),
 			SDK_version_do_not_use(IRRLICHTBAW_SDK_VERSION)
 		{
 		}
@@ -70,6 +71,7 @@ namespace irr
 			WindowId = other.WindowId;
 			LoggingLevel = other.LoggingLevel;
 			AuxGLContexts = other.AuxGLContexts;
+			SoftwareRasterizerThreads = other.SoftwareRasterizerThreads;
 			return *this;
 		}
 
@@ -225,6 +227,12 @@ namespace irr
 		//!
 		uint8_t AuxGLContexts;
 
+		//! Number of threads the software driver rasterizes screen tiles with.
+		/** With 1 every triangle is drawn on the calling thread as soon as it is submitted, otherwise
+		triangles are still drawn in submission order at every pixel. 0 means one thread per hardware thread.
+		Default value: 0 */
+		uint32_t SoftwareRasterizerThreads;
+
 		//! Don't use or change this parameter.
 		/** Always set it to IRRLICHTBAW_SDK_VERSION, which is done by default.
 		This is needed for sdk version checks. */
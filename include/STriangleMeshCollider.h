@@ -1,6 +1,8 @@
 #ifndef __S_TRIANGLE_MESH_COLLIDER_H_INCLUDED__
 #define __S_TRIANGLE_MESH_COLLIDER_H_INCLUDED__
 
+#include <algorithm>
+
 #include "SAABoxCollider.h"
 #include "irr/core/IReferenceCounted.h"
 
@@ -21,34 +23,36 @@ class STriangleCollider// : public AllocationOverrideDefault EBO inheritance pro
                 validTriangle = false;
                 return;
             }
-            boundaryPlanes[0] = cross(normal,B-A);
-            boundaryPlanes[1] = cross(C-A,normal);
-
-            planeEq.W = dot(planeEq,A).X;
-            boundaryPlanes[0].W = dot(boundaryPlanes[0],A).X;
-            boundaryPlanes[1].W = dot(boundaryPlanes[1],A).X;
+            // scaled so that the plane equations evaluate to the barycentric coordinates of C and B respectively
+            const vectorSIMDf invNormalLenSq = vectorSIMDf(1.f)/dot(normal,normal);
+            boundaryPlanes[0] = cross(normal,B-A)*invNormalLenSq;
+            boundaryPlanes[1] = cross(C-A,normal)*invNormalLenSq;
+
+            // all planes are stored as (N,-N.A) so that a dot product with a point with W=1 gives the signed distance
+            planeEq.W = -dot(planeEq,A).X;
+            boundaryPlanes[0].W = -dot(boundaryPlanes[0],A).X;
+            boundaryPlanes[1].W = -dot(boundaryPlanes[1],A).X;
             validTriangle = true;
         }
 
         inline bool CollideWithRay(float& collisionDistance, const vectorSIMDf& origin, const vectorSIMDf& direction, const float& dirMaxMultiplier) const
         {
-            float NdotD = dot(direction,planeEq).X;
-            if (NdotD!=0.f)
-                return false;
+            const vectorSIMDf originW1 = _mm_blend_ps(origin.getAsRegister(),_mm_set1_ps(1.f),0x8);
+            const vectorSIMDf directionW0 = _mm_blend_ps(direction.getAsRegister(),_mm_setzero_ps(),0x8);
 
-            float NdotOrigin = -dot(origin,planeEq).X;
-            float d = planeEq.W;
+            float NdotD = dot(directionW0,planeEq).X;
+            if (NdotD==0.f)
+                return false;
 
-            float t = (NdotOrigin-d)/NdotD;
+            float t = -dot(originW1,planeEq).X/NdotD;
             if (t>=dirMaxMultiplier||t<0.f)
                 return false;
 
-            vectorSIMDf outPoint = origin+direction*t;
-
-            vectorSIMDf extraComponent(0.f,0.f,0.f,1.f);
-            vectorSIMDf outPointW1 = outPoint|reinterpret_cast<const vectorSIMDu32&>(extraComponent);
+            vectorSIMDf outPointW1 = originW1+directionW0*t;
 
-            if (dot(outPointW1,boundaryPlanes[0]).X>=0.f&&dot(outPointW1,boundaryPlanes[1]).X>=0.f)
+            const float baryC = dot(outPointW1,boundaryPlanes[0]).X;
+            const float baryB = dot(outPointW1,boundaryPlanes[1]).X;
+            if (baryC>=0.f&&baryB>=0.f&&baryB+baryC<=1.f)
             {
                 collisionDistance = t;
                 return true;
@@ -66,10 +70,42 @@ class STriangleMeshCollider : public IReferenceCounted
 {
 	    _IRR_INTERFACE_CHILD(STriangleMeshCollider) {}
 
+        //! Node of the bounding volume hierarchy, nodes are stored depth first so the first child of an inner node directly follows it
+        /** The W components of the bounds hold the links, which keeps a node at 32 bytes (two per cache line).
+        MinEdge.W is the index of the second child for inner nodes and the first triangle for leaves, MaxEdge.W is the leaf's triangle count (0 for inner nodes).
+        */
+        struct SBVHNode
+        {
+            vectorSIMDf MinEdge;
+            vectorSIMDf MaxEdge;
+
+            inline uint32_t getOffset() const {return reinterpret_cast<const uint32_t*>(MinEdge.pointer)[3];}
+            inline uint32_t getTriangleCount() const {return reinterpret_cast<const uint32_t*>(MaxEdge.pointer)[3];}
+            inline void setLinks(uint32_t offset, uint32_t triangleCount)
+            {
+                reinterpret_cast<uint32_t*>(MinEdge.pointer)[3] = offset;
+                reinterpret_cast<uint32_t*>(MaxEdge.pointer)[3] = triangleCount;
+            }
+        };
+        struct SBuildPrimitive
+        {
+            vectorSIMDf MinEdge;
+            vectorSIMDf MaxEdge;
+            vectorSIMDf Centroid;
+            uint32_t triangle;
+        };
+        _IRR_STATIC_INLINE_CONSTEXPR uint32_t BVHBinCount = 16u;
+        //! larger ranges are always split, only ranges at BVHMaxDepth become bigger leaves
+        _IRR_STATIC_INLINE_CONSTEXPR uint32_t BVHMaxLeafSize = 8u;
+        _IRR_STATIC_INLINE_CONSTEXPR uint32_t BVHMaxDepth = 64u;
+        //! relative cost of visiting a node as opposed to testing a triangle, for the surface area heuristic
+        _IRR_STATIC_INLINE_CONSTEXPR float BVHTraversalCost = 1.f;
+
         SAABoxCollider BBox;
         ///matrix4x3 cachedTransformInverse;
         ///matrix4x3 cachedTransform;
         vector<STriangleCollider> triangles;
+        vector<SBVHNode> bvhNodes;
     public:
         STriangleMeshCollider() : BBox(core::aabbox3df()) {}
 
@@ -78,9 +114,43 @@ class STriangleMeshCollider : public IReferenceCounted
 
         inline size_t getTriangleCount() const {return triangles.size();}
 
-        inline bool Init(float* vertices, const size_t &indexCount, uint32_t* indices=NULL)
+        inline bool hasBVH() const {return !bvhNodes.empty();}
+
+        //! @param buildBVH Whether to build a bounding volume hierarchy over the triangles, ray queries then only test the triangles along the ray instead of all of them
+        inline bool Init(float* vertices, const size_t &indexCount, uint32_t* indices=NULL, bool buildBVH=true)
         {
             bool firstPoint = true;
+            vector<SBuildPrimitive> primitives;
+            if (buildBVH)
+                primitives.reserve(indexCount/3);
+            auto addTriangle = [&](const vectorSIMDf& A, const vectorSIMDf& B, const vectorSIMDf& C)
+            {
+                bool useful = false;
+                STriangleCollider triangle(A,B,C,useful);
+                if (!useful)
+                    return;
+
+                if (firstPoint)
+                {
+                    BBox.Box.reset(A.getAsVector3df());
+                    firstPoint = false;
+                }
+                else
+                    BBox.Box.addInternalPoint(A.getAsVector3df());
+                BBox.Box.addInternalPoint(B.getAsVector3df());
+                BBox.Box.addInternalPoint(C.getAsVector3df());
+                if (buildBVH)
+                {
+                    SBuildPrimitive prim;
+                    prim.MinEdge = min_(min_(A,B),C);
+                    prim.MaxEdge = max_(max_(A,B),C);
+                    prim.Centroid = (prim.MinEdge+prim.MaxEdge)*0.5f;
+                    prim.triangle = triangles.size();
+                    primitives.push_back(prim);
+                }
+                triangles.push_back(triangle);
+            };
+
             if (indices)
             {
                 for (size_t i=0; i<indexCount; i+=3)
@@ -88,22 +158,7 @@ class STriangleMeshCollider : public IReferenceCounted
                     vectorSIMDf A(vertices[indices[i+0]*3+0],vertices[indices[i+0]*3+1],vertices[indices[i+0]*3+2]);
                     vectorSIMDf B(vertices[indices[i+1]*3+0],vertices[indices[i+1]*3+1],vertices[indices[i+1]*3+2]);
                     vectorSIMDf C(vertices[indices[i+2]*3+0],vertices[indices[i+2]*3+1],vertices[indices[i+2]*3+2]);
-
-                    bool useful = false;
-                    STriangleCollider triangle(A,B,C,useful);
-                    if (useful)
-                    {
-                        if (firstPoint)
-                        {
-                            BBox.Box.reset(A.getAsVector3df());
-                            firstPoint = false;
-                        }
-                        else
-                            BBox.Box.addInternalPoint(A.getAsVector3df());
-                        BBox.Box.addInternalPoint(B.getAsVector3df());
-                        BBox.Box.addInternalPoint(C.getAsVector3df());
-                        triangles.push_back(triangle);
-                    }
+                    addTriangle(A,B,C);
                 }
             }
             else
@@ -113,25 +168,14 @@ class STriangleMeshCollider : public IReferenceCounted
                     vectorSIMDf A(vertices[(i+0)*3+0],vertices[(i+0)*3+1],vertices[(i+0)*3+2]);
                     vectorSIMDf B(vertices[(i+1)*3+0],vertices[(i+1)*3+1],vertices[(i+1)*3+2]);
                     vectorSIMDf C(vertices[(i+2)*3+0],vertices[(i+2)*3+1],vertices[(i+2)*3+2]);
-
-                    bool useful;
-                    STriangleCollider triangle(A,B,C,useful);
-                    if (useful)
-                    {
-                        if (firstPoint)
-                        {
-                            BBox.Box.reset(A.getAsVector3df());
-                            firstPoint = false;
-                        }
-                        else
-                            BBox.Box.addInternalPoint(A.getAsVector3df());
-                        BBox.Box.addInternalPoint(B.getAsVector3df());
-                        BBox.Box.addInternalPoint(C.getAsVector3df());
-                        triangles.push_back(triangle);
-                    }
+                    addTriangle(A,B,C);
                 }
             }
 
+            bvhNodes.clear();
+            if (buildBVH && primitives.size())
+                buildHierarchy(primitives);
+
             return triangles.size();
         }
 
@@ -140,19 +184,237 @@ class STriangleMeshCollider : public IReferenceCounted
             return CollideWithRay(collisionDistance,origin,direction,dirMaxMultiplier,reciprocal(direction));
         }
 
+        //! Finds the closest triangle hit along the ray, if any
         inline bool CollideWithRay(float& collisionDistance, const vectorSIMDf& origin, const vectorSIMDf& direction, const float& dirMaxMultiplier, const vectorSIMDf& direction_reciprocal) const
         {
             float dummyDist;
             if (!BBox.CollideWithRay(dummyDist,origin,direction,dirMaxMultiplier,direction_reciprocal))
                 return false;
 
+            if (hasBVH())
+                return traverseHierarchy(collisionDistance,origin,direction,dirMaxMultiplier);
+
+            bool hit = false;
+            float closest = dirMaxMultiplier;
             for (size_t i=0; i<triangles.size(); i++)
             {
-                if (triangles[i].CollideWithRay(collisionDistance,origin,direction,dirMaxMultiplier))
-                    return true;
+                if (triangles[i].CollideWithRay(closest,origin,direction,closest))
+                    hit = true;
+            }
+            if (hit)
+                collisionDistance = closest;
+
+            return hit;
+        }
+    private:
+        //! Slab test of the ray against the node's box, `_invDirection` must be exact since the boxes are tight
+        static inline bool rayHitsNode(float& _entryDistance, const SBVHNode& _node, const vectorSIMDf& _origin, const vectorSIMDf& _invDirection, float _maxDistance)
+        {
+            const vectorSIMDf t0 = (_node.MinEdge-_origin)*_invDirection;
+            const vectorSIMDf t1 = (_node.MaxEdge-_origin)*_invDirection;
+            const vectorSIMDf tNear = min_(t0,t1);
+            const vectorSIMDf tFar = max_(t0,t1);
+
+            // W components hold garbage, only reduce over XYZ
+            const float entry = std::max(std::max(tNear.X,tNear.Y),std::max(tNear.Z,0.f));
+            const float exit = std::min(std::min(tFar.X,tFar.Y),std::min(tFar.Z,_maxDistance));
+            _entryDistance = entry;
+            return entry<=exit;
+        }
+
+        //! Closest hit traversal, visits the nearer child first and skips any node further away than the closest hit found so far
+        inline bool traverseHierarchy(float& collisionDistance, const vectorSIMDf& origin, const vectorSIMDf& direction, float dirMaxMultiplier) const
+        {
+            const vectorSIMDf invDirection = vectorSIMDf(1.f)/direction;
+
+            bool hit = false;
+            float closest = dirMaxMultiplier;
+
+            uint32_t stack[BVHMaxDepth];
+            uint32_t stackSize = 0u;
+            uint32_t nodeIx = 0u;
+            float entry;
+            if (!rayHitsNode(entry,bvhNodes[0],origin,invDirection,closest))
+                return false;
+            while (true)
+            {
+                const SBVHNode& node = bvhNodes[nodeIx];
+                const uint32_t triangleCount = node.getTriangleCount();
+                if (triangleCount)
+                {
+                    for (uint32_t i=node.getOffset(); i<node.getOffset()+triangleCount; i++)
+                    {
+                        if (triangles[i].CollideWithRay(closest,origin,direction,closest))
+                            hit = true;
+                    }
+                }
+                else
+                {
+                    const uint32_t children[2] = {nodeIx+1u,node.getOffset()};
+                    float entries[2];
+                    const bool hits[2] = {  rayHitsNode(entries[0],bvhNodes[children[0]],origin,invDirection,closest),
+                                            rayHitsNode(entries[1],bvhNodes[children[1]],origin,invDirection,closest)};
+                    if (hits[0]&&hits[1])
+                    {
+                        const uint32_t nearer = entries[1]<entries[0] ? 1u:0u;
+                        stack[stackSize++] = children[nearer^1u];
+                        nodeIx = children[nearer];
+                        continue;
+                    }
+                    else if (hits[0]||hits[1])
+                    {
+                        nodeIx = children[hits[0] ? 0u:1u];
+                        continue;
+                    }
+                }
+
+                // pop nodes until one is still closer than the closest hit
+                bool found = false;
+                while (stackSize)
+                {
+                    nodeIx = stack[--stackSize];
+                    if (rayHitsNode(entry,bvhNodes[nodeIx],origin,invDirection,closest))
+                    {
+                        found = true;
+                        break;
+                    }
+                }
+                if (!found)
+                    break;
+            }
+
+            if (hit)
+                collisionDistance = closest;
+            return hit;
+        }
+
+        static inline float surfaceArea(const vectorSIMDf& _min, const vectorSIMDf& _max)
+        {
+            const vectorSIMDf extent = _max-_min;
+            return extent.X*extent.Y+extent.Y*extent.Z+extent.Z*extent.X;
+        }
+
+        //! Builds the node array with a binned surface area heuristic and reorders `triangles` so that every leaf references a contiguous range
+        inline void buildHierarchy(vector<SBuildPrimitive>& primitives)
+        {
+            bvhNodes.reserve(2u*primitives.size());
+            buildNode(primitives,0u,primitives.size(),0u);
+
+            vector<STriangleCollider> leafOrdered;
+            leafOrdered.reserve(triangles.size());
+            for (const auto& prim : primitives)
+                leafOrdered.push_back(triangles[prim.triangle]);
+            triangles.swap(leafOrdered);
+        }
+
+        inline uint32_t buildNode(vector<SBuildPrimitive>& primitives, uint32_t begin, uint32_t end, uint32_t depth)
+        {
+            const uint32_t nodeIx = bvhNodes.size();
+            bvhNodes.emplace_back();
+
+            vectorSIMDf minEdge(FLT_MAX), maxEdge(-FLT_MAX), minCentroid(FLT_MAX), maxCentroid(-FLT_MAX);
+            for (uint32_t i=begin; i<end; i++)
+            {
+                minEdge = min_(minEdge,primitives[i].MinEdge);
+                maxEdge = max_(maxEdge,primitives[i].MaxEdge);
+                minCentroid = min_(minCentroid,primitives[i].Centroid);
+                maxCentroid = max_(maxCentroid,primitives[i].Centroid);
+            }
+            bvhNodes[nodeIx].MinEdge = minEdge;
+            bvhNodes[nodeIx].MaxEdge = maxEdge;
+
+            const uint32_t count = end-begin;
+            // the stack of the traversal bounds the depth, past it everything goes into one (slow but correct) leaf
+            if (count<=2u || depth+1u>=BVHMaxDepth)
+            {
+                bvhNodes[nodeIx].setLinks(begin,count);
+                return nodeIx;
+            }
+
+            // evaluate the split planes between bins of centroids along every axis
+            struct SBin
+            {
+                vectorSIMDf MinEdge = vectorSIMDf(FLT_MAX);
+                vectorSIMDf MaxEdge = vectorSIMDf(-FLT_MAX);
+                uint32_t count = 0u;
+            };
+            float bestCost = FLT_MAX;
+            uint32_t bestAxis = 0u, bestSplit = 0u;
+            const vectorSIMDf centroidExtent = maxCentroid-minCentroid;
+            for (uint32_t axis=0u; axis<3u; axis++)
+            {
+                if (centroidExtent.pointer[axis]<=0.f)
+                    continue;
+
+                const float binScale = float(BVHBinCount)/centroidExtent.pointer[axis];
+                SBin bins[BVHBinCount];
+                for (uint32_t i=begin; i<end; i++)
+                {
+                    const uint32_t bin = std::min(uint32_t((primitives[i].Centroid.pointer[axis]-minCentroid.pointer[axis])*binScale),BVHBinCount-1u);
+                    bins[bin].MinEdge = min_(bins[bin].MinEdge,primitives[i].MinEdge);
+                    bins[bin].MaxEdge = max_(bins[bin].MaxEdge,primitives[i].MaxEdge);
+                    bins[bin].count++;
+                }
+
+                float rightAreas[BVHBinCount];
+                uint32_t rightCounts[BVHBinCount];
+                {
+                    SBin right;
+                    for (uint32_t b=BVHBinCount-1u; b>0u; b--)
+                    {
+                        right.MinEdge = min_(right.MinEdge,bins[b].MinEdge);
+                        right.MaxEdge = max_(right.MaxEdge,bins[b].MaxEdge);
+                        right.count += bins[b].count;
+                        rightAreas[b] = right.count ? surfaceArea(right.MinEdge,right.MaxEdge):0.f;
+                        rightCounts[b] = right.count;
+                    }
+                }
+                SBin left;
+                for (uint32_t split=1u; split<BVHBinCount; split++)
+                {
+                    left.MinEdge = min_(left.MinEdge,bins[split-1u].MinEdge);
+                    left.MaxEdge = max_(left.MaxEdge,bins[split-1u].MaxEdge);
+                    left.count += bins[split-1u].count;
+                    if (!left.count || !rightCounts[split])
+                        continue;
+
+                    const float cost = surfaceArea(left.MinEdge,left.MaxEdge)*left.count+rightAreas[split]*rightCounts[split];
+                    if (cost<bestCost)
+                    {
+                        bestCost = cost;
+                        bestAxis = axis;
+                        bestSplit = split;
+                    }
+                }
+            }
+
+            // costs are in units of triangle tests relative to the parent's area
+            const float parentArea = surfaceArea(minEdge,maxEdge);
+            const bool splitFound = bestCost<FLT_MAX;
+            const bool splitIsCheaper = splitFound && BVHTraversalCost+(parentArea>0.f ? bestCost/parentArea:float(count))<float(count);
+            if (count<=BVHMaxLeafSize && !splitIsCheaper)
+            {
+                bvhNodes[nodeIx].setLinks(begin,count);
+                return nodeIx;
+            }
+
+            uint32_t middle;
+            if (splitFound)
+            {
+                const float binScale = float(BVHBinCount)/centroidExtent.pointer[bestAxis];
+                const float axisMin = minCentroid.pointer[bestAxis];
+                middle = std::partition(primitives.begin()+begin,primitives.begin()+end,[&](const SBuildPrimitive& prim)
+                {
+                    return std::min(uint32_t((prim.Centroid.pointer[bestAxis]-axisMin)*binScale),BVHBinCount-1u)<bestSplit;
+                })-primitives.begin();
             }
+            else // all centroids coincide, any split is as good as another
+                middle = begin+count/2u;
 
-            return false;
+            buildNode(primitives,begin,middle,depth+1u);
+            const uint32_t secondChild = buildNode(primitives,middle,end,depth+1u);
+            bvhNodes[nodeIx].setLinks(secondChild,0u);
+            return nodeIx;
         }
 /**
         inline bool UpdateTransformation(const matrix4x3& newTransform)
@@ -174,22 +174,13 @@ class CImageData : public asset::IAsset
         inline size_t getImageDataSizeInBytes() const
         {
             uint32_t size[3] = {maxCoord[0]-minCoord[0],maxCoord[1]-minCoord[1],maxCoord[2]-minCoord[2]};
-            const uint32_t blockAlignment = asset::isBlockCompressionFormat(getColorFormat()) ? asset::getTexelOrBlockSize(getColorFormat()) : 1u;
 
-            if (blockAlignment!=1)
+            if (asset::isBlockCompressionFormat(getColorFormat()))
             {
-                size[0] += blockAlignment-1;
-                size[1] += blockAlignment-1;
-                /*
-                size[0] /= blockAlignment;
-                size[1] /= blockAlignment;
-                size[0] *= blockAlignment;
-                size[1] *= blockAlignment;
-                */
-                size[0] &= ~(blockAlignment-1);
-                size[1] &= ~(blockAlignment-1);
-
-                return (size[0]*size[1]*getBitsPerPixel())/8*size[2];
+                // getBitsPerPixel() is per block for these
+                const core::vector3d<uint32_t> blockDims = asset::getBlockDimensions(getColorFormat());
+                const size_t blockCount = size_t((size[0]+blockDims.X-1u)/blockDims.X)*((size[1]+blockDims.Y-1u)/blockDims.Y)*size[2];
+                return blockCount*asset::getTexelOrBlockSize(getColorFormat());
             }
             else
             {
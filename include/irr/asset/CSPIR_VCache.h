@@ -0,0 +1,87 @@
+#ifndef __IRR_C_SPIR_V_CACHE_H_INCLUDED__
+#define __IRR_C_SPIR_V_CACHE_H_INCLUDED__
+
+#include <atomic>
+
+#include "irr/core/IReferenceCounted.h"
+#include "irr/asset/ICPUBuffer.h"
+#include "CConcurrentObjectCache.h"
+#include "IFileSystem.h"
+
+namespace irr { namespace asset
+{
+
+//! Content addressed store of SPIR-V bytecode which survives between runs
+/**
+Every blob lives in its own `<key in hex>.spv` file inside the cache directory.
+Files are written under a temporary name and renamed into place, so several threads or processes sharing
+the directory never see a half written blob, and losing the race to write the same key is harmless.
+
+Blobs found on disk or inserted are also kept in memory, lookups of those only take the shared read lock of one shard of the in-memory cache.
+Nothing ever gets evicted, so the directory can be wiped by hand whenever it grows too big.
+*/
+class CSPIR_VCache : public core::IReferenceCounted
+{
+    public:
+        //! XXHash_256 of everything the bytecode depends on
+        struct SKey
+        {
+            uint64_t hash[4];
+
+            inline bool operator==(const SKey& _other) const { return memcmp(hash, _other.hash, sizeof(hash)) == 0; }
+            inline bool operator<(const SKey& _other) const { return memcmp(hash, _other.hash, sizeof(hash)) < 0; }
+            inline bool operator>(const SKey& _other) const { return _other < *this; }
+        };
+
+        //! @param _directory Must already exist, gets shared with whoever else uses the same path.
+        CSPIR_VCache(io::IFileSystem* _fs, const io::path& _directory);
+
+        //! @returns Bytecode stored under `_key` or nullptr if nothing was, safe to call from any number of threads.
+        core::smart_refctd_ptr<ICPUBuffer> find(const SKey& _key) const;
+
+        //! Stores a copy of `_spirv` under `_key` in memory and on disk, safe to call from any number of threads.
+        /** @returns Whether the blob made it to disk. */
+        bool insert(const SKey& _key, const void* _spirv, size_t _size) const;
+
+    protected:
+        virtual ~CSPIR_VCache();
+
+    private:
+        struct SBlobHeader
+        {
+            _IRR_STATIC_INLINE_CONSTEXPR uint32_t Magic = 0x43565053u; // "SPVC"
+            _IRR_STATIC_INLINE_CONSTEXPR uint32_t Version = 1u;
+
+            uint32_t magic;
+            uint32_t version;
+            //! repeated in the file so a renamed or truncated blob never gets used
+            SKey key;
+            uint64_t byteSize;
+        };
+
+        io::path getBlobPath(const SKey& _key) const;
+        core::smart_refctd_ptr<ICPUBuffer> loadBlob(const SKey& _key) const;
+        //! keeps whichever of `_blob` and an already cached buffer got there first
+        core::smart_refctd_ptr<ICPUBuffer> cacheInMemory(const SKey& _key, core::smart_refctd_ptr<ICPUBuffer>&& _blob) const;
+
+        io::IFileSystem* m_fileSystem;
+        io::path m_directory;
+        //! distinguishes temporary files of different cache objects, possibly in different processes
+        uint64_t m_tmpFilePrefix;
+        mutable std::atomic<uint32_t> m_tmpFileCounter;
+        mutable core::CShardedConcurrentObjectCache<SKey, ICPUBuffer, std::map> m_loaded;
+};
+
+}}
+
+namespace std
+{
+    template<>
+    struct hash<irr::asset::CSPIR_VCache::SKey>
+    {
+        // the key already is a hash
+        size_t operator()(const irr::asset::CSPIR_VCache::SKey& _key) const { return static_cast<size_t>(_key.hash[0]); }
+    };
+}
+
+#endif//__IRR_C_SPIR_V_CACHE_H_INCLUDED__
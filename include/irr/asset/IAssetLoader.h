@@ -23,15 +23,28 @@ public:
         ECF_DUPLICATE_REFERENCES = 0xffffffffffffffffull
     };
 
+    //! Hints for the loaders, a loader ignores any flag which does not apply to its format
+    enum E_LOADER_PARAMETER_FLAGS : uint64_t
+    {
+        ELPF_NONE = 0,
+        //! merge bitwise identical vertices and output an indexed mesh, for formats which store unindexed triangle soups (e.g. STL)
+        ELPF_DEDUPLICATE_VERTICES = 0x1ull,
+        //! block compress images of formats which store them uncompressed (e.g. PNG, JPG, TGA, BMP) to BC1, BC3, BC4 or BC5, see video::getBlockCompressedFormat
+        ELPF_COMPRESS_TEXTURES = 0x2ull,
+        //! together with ELPF_COMPRESS_TEXTURES, compress RGB(A) images to BC7 at the highest quality, which is many times slower
+        ELPF_HIGH_QUALITY_TEXTURE_COMPRESSION = 0x4ull
+    };
+
     struct SAssetLoadParams
     {
-        SAssetLoadParams(const size_t& _decryptionKeyLen = 0u, const uint8_t* _decryptionKey = nullptr, const E_CACHING_FLAGS& _cacheFlags = ECF_CACHE_EVERYTHING)
-            : decryptionKeyLen(_decryptionKeyLen), decryptionKey(_decryptionKey), cacheFlags(_cacheFlags)
+        SAssetLoadParams(const size_t& _decryptionKeyLen = 0u, const uint8_t* _decryptionKey = nullptr, const E_CACHING_FLAGS& _cacheFlags = ECF_CACHE_EVERYTHING, const E_LOADER_PARAMETER_FLAGS& _loaderFlags = ELPF_NONE)
+            : decryptionKeyLen(_decryptionKeyLen), decryptionKey(_decryptionKey), cacheFlags(_cacheFlags), loaderFlags(_loaderFlags)
         {
         }
         size_t decryptionKeyLen;
         const uint8_t* decryptionKey;
         const E_CACHING_FLAGS cacheFlags;
+        const E_LOADER_PARAMETER_FLAGS loaderFlags;
     };
 
     //! Struct for keeping the state of the current loadoperation for safe threading
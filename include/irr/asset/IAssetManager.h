@@ -12,11 +12,14 @@
 #include "IAssetLoader.h"
 #include "IAssetWriter.h"
 #include "irr/core/Types.h"
+#include "irr/core/CThreadPool.h"
 
 #include <array>
+#include <future>
 #include <ostream>
 
-#define USE_MAPS_FOR_PATH_BASED_CACHE //benchmark and choose, paths can be full system paths
+#define USE_HASH_MAPS_FOR_PATH_BASED_CACHE //O(1) lookups, paths can be full system paths
+//#define USE_MAPS_FOR_PATH_BASED_CACHE
 
 namespace irr
 {
@@ -35,13 +38,19 @@ namespace asset
         friend std::function<void(IAsset*)> makeAssetDisposeFunc(const IAssetManager* const _mgr);
 
     public:
-#ifdef USE_MAPS_FOR_PATH_BASED_CACHE
-        using AssetCacheType = core::CConcurrentMultiObjectCache<std::string, IAsset, std::multimap>;
+#if defined(USE_HASH_MAPS_FOR_PATH_BASED_CACHE)
+        using AssetCacheType = core::CShardedConcurrentMultiObjectCache<std::string, IAsset, core::flat_hash_multimap>;
+#elif defined(USE_MAPS_FOR_PATH_BASED_CACHE)
+        using AssetCacheType = core::CShardedConcurrentMultiObjectCache<std::string, IAsset, std::multimap>;
 #else
-        using AssetCacheType = core::CConcurrentMultiObjectCache<std::string, IAsset, std::vector>;
-#endif //USE_MAPS_FOR_PATH_BASED_CACHE
+        using AssetCacheType = core::CShardedConcurrentMultiObjectCache<std::string, IAsset, std::vector>;
+#endif
+
+        //! Lookups (findAssets, findGPUObject) vastly outnumber insertions, so caches are sharded and readers never take a lock
+        using CpuGpuCacheType = core::CShardedConcurrentObjectCache<const IAsset*, core::IReferenceCounted>;
 
-        using CpuGpuCacheType = core::CConcurrentObjectCache<const IAsset*, core::IReferenceCounted>;
+        //! Called on a loading thread as soon as an asset requested with getAssetsAsync() is loaded, the asset is nullptr if loading failed
+        using AsyncLoadCallback = std::function<void(const std::string&, IAsset*)>;
 
     private:
         struct WriterKey
@@ -73,6 +82,18 @@ namespace asset
         std::array<AssetCacheType*, IAsset::ET_STANDARD_TYPES_COUNT> m_assetCache;
         std::array<CpuGpuCacheType*, IAsset::ET_STANDARD_TYPES_COUNT> m_cpuGpuCache;
 
+        //! Load which was started by getAssetsAsync() and has not finished yet, so that requests for the same file can join it instead of loading it again
+        struct SInFlightLoad
+        {
+            IAssetLoader::IAssetLoaderOverride* override;
+            std::shared_future<IAsset*> result;
+            core::vector<AsyncLoadCallback> callbacks;
+        };
+        //! Created on first use of getAssetsAsync()
+        core::CThreadPool* m_asyncLoadPool;
+        core::mutex m_asyncLoadMutex;
+        core::unordered_map<std::string, SInFlightLoad> m_inFlightLoads;
+
         struct Loaders {
             Loaders() : perFileExt{&refCtdGreet<IAssetLoader>, &refCtdDispose<IAssetLoader>} {}
 
@@ -110,7 +131,8 @@ namespace asset
         //! Constructor
         explicit IAssetManager(io::IFileSystem* _fs) :
             m_fileSystem{_fs},
-            m_defaultLoaderOverride{nullptr}
+            m_defaultLoaderOverride{nullptr},
+            m_asyncLoadPool{nullptr}
         {
             initializeMeshTools();
 
@@ -135,6 +157,10 @@ namespace asset
         */
         virtual ~IAssetManager()
         {
+            // finishes all loads still in flight, they need the caches
+            if (m_asyncLoadPool)
+                delete m_asyncLoadPool;
+
             for (size_t i = 0u; i < m_assetCache.size(); ++i)
                 if (m_assetCache[i])
                     delete m_assetCache[i];
@@ -265,6 +291,84 @@ namespace asset
             return getAsset(_file, _supposedFilename, _params, &m_defaultLoaderOverride);
         }
 
+        //! Starts loading all `_filenames` on a pool of loading threads and returns immediately.
+        /** The futures (and `_onLoaded`, called from a loading thread) yield exactly what getAsset() would have returned for the same arguments.
+        If the top level asset is going to be cached, a request for a file which is still being loaded by an earlier getAssetsAsync() call
+        (with the same override) joins that load instead of starting another one.
+        Loaders, `_override`, `_onLoaded` and the decryption key in `_params` must stay valid and be safe to use from multiple threads until all futures are ready,
+        and loaders must not be added or removed in the meantime.
+        Never wait on the futures from within a loader or `_onLoaded`, the loading threads could end up all waiting on each other.
+        */
+        core::vector<std::shared_future<IAsset*> > getAssetsAsync(const core::vector<std::string>& _filenames, const IAssetLoader::SAssetLoadParams& _params, IAssetLoader::IAssetLoaderOverride* _override, const AsyncLoadCallback& _onLoaded = nullptr)
+        {
+            // same condition as for getAssetInHierarchy() to insert the top level asset into the cache, otherwise every request has to get its own asset
+            const bool sharedResult = !(_params.cacheFlags & IAssetLoader::ECF_DONT_CACHE_TOP_LEVEL);
+
+            core::vector<std::shared_future<IAsset*> > results;
+            results.reserve(_filenames.size());
+
+            std::lock_guard<core::mutex> lock(m_asyncLoadMutex);
+            if (!m_asyncLoadPool)
+                m_asyncLoadPool = new core::CThreadPool();
+
+            for (const auto& filename : _filenames)
+            {
+                bool joinable = sharedResult;
+                if (joinable)
+                {
+                    auto found = m_inFlightLoads.find(filename);
+                    if (found != m_inFlightLoads.end())
+                    {
+                        if (found->second.override == _override)
+                        {
+                            if (_onLoaded)
+                                found->second.callbacks.push_back(_onLoaded);
+                            results.push_back(found->second.result);
+                            continue;
+                        }
+                        // the file is being loaded with another override, load it separately and leave the entry alone
+                        joinable = false;
+                    }
+                }
+
+                auto promise = std::make_shared<std::promise<IAsset*> >();
+                results.push_back(promise->get_future().share());
+                if (joinable)
+                {
+                    SInFlightLoad& load = m_inFlightLoads[filename];
+                    load.override = _override;
+                    load.result = results.back();
+                    if (_onLoaded)
+                        load.callbacks.push_back(_onLoaded);
+                }
+
+                m_asyncLoadPool->enqueue([this, filename, _params, _override, _onLoaded, joinable, promise]() {
+                    IAsset* asset = getAssetInHierarchy(filename, _params, 0u, _override);
+                    promise->set_value(asset);
+
+                    core::vector<AsyncLoadCallback> callbacks;
+                    if (joinable)
+                    {
+                        std::lock_guard<core::mutex> lock(m_asyncLoadMutex);
+                        auto found = m_inFlightLoads.find(filename);
+                        callbacks = std::move(found->second.callbacks);
+                        m_inFlightLoads.erase(found);
+                    }
+                    else if (_onLoaded)
+                        callbacks.push_back(_onLoaded);
+
+                    for (const auto& callback : callbacks)
+                        callback(filename, asset);
+                });
+            }
+
+            return results;
+        }
+        core::vector<std::shared_future<IAsset*> > getAssetsAsync(const core::vector<std::string>& _filenames, const IAssetLoader::SAssetLoadParams& _params, const AsyncLoadCallback& _onLoaded = nullptr)
+        {
+            return getAssetsAsync(_filenames, _params, &m_defaultLoaderOverride, _onLoaded);
+        }
+
         inline bool findAssets(size_t& _inOutStorageSize, IAsset** _out, const std::string& _key, const IAsset::E_TYPE* _types = nullptr) const
         {
             size_t availableSize = _inOutStorageSize;
@@ -5,6 +5,10 @@
 
 #include <functional>
 #include <regex>
+#include <mutex>
+#include <algorithm>
+#include <cstring>
+#include <cctype>
 
 namespace irr { namespace asset
 {
@@ -14,7 +18,10 @@ class IBuiltinIncludeLoader : public core::IReferenceCounted
 protected:
     using HandleFunc_t = std::function<std::string(const std::string&)>;
 
-    virtual core::vector<std::pair<std::regex, HandleFunc_t>> getBuiltinNamesToFunctionMapping() const = 0;
+    //! @returns Pairs of ECMAScript regex source and the function generating the include for paths fully matching it, earlier patterns win.
+    /** Only gets called once per loader, the first time an include is looked up.
+    The functions must only depend on the path they're given, because whatever they return gets cached under that path. */
+    virtual core::vector<std::pair<std::string, HandleFunc_t>> getBuiltinNamesToFunctionMapping() const = 0;
 
 public:
     virtual ~IBuiltinIncludeLoader() = default;
@@ -22,27 +29,176 @@ public:
     //! @param _name must be path relative to /irr/builtin/
     virtual std::string getBuiltinInclude(const std::string& _name) const
     {
-        std::string inclGuardName = _name;
-        std::transform(inclGuardName.begin(), inclGuardName.end(), inclGuardName.begin(), [](char c) {return ::toupper(int(c)); });
-        std::transform(inclGuardName.begin(), inclGuardName.end(), inclGuardName.begin(),
-            [](char c) { return (!::isalpha(c) && !::isdigit(c)) ? '_' : c; }
-        );
-        inclGuardName = "_" + inclGuardName + "_";
+        {
+            std::lock_guard<std::mutex> lock(m_generatedMutex);
+            auto found = m_generated.find(_name);
+            if (found != m_generated.end())
+                return found->second;
+        }
 
-        //const std::string inclGuardBegin = "#ifndef " + inclGuardName + "\n#define " + inclGuardName + "\n";
-        //const std::string inclGuardEnd = "\n#endif //" + inclGuardName;
+        std::call_once(m_dispatcherBuilt, [this]() { m_dispatcher.build(getBuiltinNamesToFunctionMapping()); });
+        // generate outside of the lock, worst case two threads produce the same string
+        std::string retval = m_dispatcher(_name);
+        if (retval.empty())
+            return retval;
 
-        core::vector<std::pair<std::regex, HandleFunc_t>> builtinNames = getBuiltinNamesToFunctionMapping();
-
-        for (const auto& pattern : builtinNames)
-            if (std::regex_match(_name, pattern.first))
-                return pattern.second(_name);
-
-        return {};
+        std::lock_guard<std::mutex> lock(m_generatedMutex);
+        return m_generated.emplace(_name, std::move(retval)).first->second;
     }
 
     //! @returns Path relative to /irr/builtin/
     virtual const char* getVirtualDirectoryName() const = 0;
+
+private:
+    //! Sorts the patterns into a trie by the literal text they must start with, so a lookup only runs the regexes of patterns whose prefix the path has
+    class CDispatcher
+    {
+    public:
+        void build(core::vector<std::pair<std::string, HandleFunc_t>>&& _mapping)
+        {
+            m_nodes.resize(1u);
+            m_patterns.reserve(_mapping.size());
+            for (auto& entry : _mapping)
+            {
+                SPattern pattern;
+                pattern.isLiteral = getLiteralPrefix(entry.first, pattern.prefix);
+                if (!pattern.isLiteral)
+                    pattern.regex = std::regex(entry.first, std::regex::ECMAScript|std::regex::optimize);
+                pattern.handler = std::move(entry.second);
+
+                uint32_t node = 0u;
+                for (char c : pattern.prefix)
+                    node = getOrAddChild(node, c);
+                m_nodes[node].patterns.push_back(static_cast<uint32_t>(m_patterns.size()));
+                m_patterns.push_back(std::move(pattern));
+            }
+        }
+
+        std::string operator()(const std::string& _name) const
+        {
+            // patterns ending at deeper nodes have longer prefixes, but the mapping order decides which one wins
+            core::vector<uint32_t> candidates;
+            uint32_t node = 0u;
+            for (size_t i = 0u; ; i++)
+            {
+                for (auto patternIx : m_nodes[node].patterns)
+                {
+                    const auto& pattern = m_patterns[patternIx];
+                    if (!pattern.isLiteral || pattern.prefix.size() == _name.size())
+                        candidates.push_back(patternIx);
+                }
+                if (i == _name.size() || (node = getChild(node, _name[i])) == InvalidNode)
+                    break;
+            }
+            std::sort(candidates.begin(), candidates.end());
+
+            for (auto patternIx : candidates)
+            {
+                const auto& pattern = m_patterns[patternIx];
+                if (pattern.isLiteral || std::regex_match(_name, pattern.regex))
+                    return pattern.handler(_name);
+            }
+            return {};
+        }
+
+    private:
+        _IRR_STATIC_INLINE_CONSTEXPR uint32_t InvalidNode = 0xdeadbeefu;
+
+        struct SPattern
+        {
+            std::string prefix;
+            //! whole pattern is the prefix, so an exact compare does instead of the regex
+            bool isLiteral;
+            std::regex regex;
+            HandleFunc_t handler;
+        };
+        struct SNode
+        {
+            core::vector<std::pair<char, uint32_t>> children;
+            //! patterns whose prefix ends here
+            core::vector<uint32_t> patterns;
+        };
+
+        uint32_t getOrAddChild(uint32_t _node, char _c)
+        {
+            uint32_t child = getChild(_node, _c);
+            if (child == InvalidNode)
+            {
+                child = static_cast<uint32_t>(m_nodes.size());
+                m_nodes[_node].children.emplace_back(_c, child);
+                m_nodes.emplace_back();
+            }
+            return child;
+        }
+        uint32_t getChild(uint32_t _node, char _c) const
+        {
+            for (const auto& child : m_nodes[_node].children)
+                if (child.first == _c)
+                    return child.second;
+            return InvalidNode;
+        }
+
+        //! Collects the characters every match has to start with, stopping at the first construct which is not a plain character.
+        /** A character followed by a quantifier is left out and alternation outside of a group voids the whole prefix.
+        @returns Whether the pattern is nothing but the prefix. */
+        static bool getLiteralPrefix(const std::string& _regex, std::string& _prefix)
+        {
+            _prefix.clear();
+            // `a|b` matches "b", so no prefix can be trusted if there is alternation at the top level
+            int32_t depth = 0;
+            for (size_t i = 0u; i < _regex.size(); i++)
+            {
+                switch (_regex[i])
+                {
+                    case '\\': i++; break;
+                    case '[': // `|` and `(` are plain characters inside a bracket expression
+                        for (i++; i < _regex.size() && _regex[i] != ']'; i++)
+                            if (_regex[i] == '\\')
+                                i++;
+                        break;
+                    case '(': depth++; break;
+                    case ')': depth--; break;
+                    case '|':
+                        if (depth == 0)
+                            return false;
+                        break;
+                    default: break;
+                }
+            }
+
+            auto isQuantifier = [](char c) { return c == '*' || c == '+' || c == '?' || c == '{'; };
+            size_t i = 0u;
+            while (i < _regex.size())
+            {
+                char c = _regex[i];
+                size_t next = i + 1u;
+                if (c == '\\')
+                {
+                    // only escaped punctuation stands for itself, `\d`, `\b`, `\1` and the like don't
+                    if (next == _regex.size() || std::isalnum(static_cast<unsigned char>(_regex[next])))
+                        return false;
+                    c = _regex[next++];
+                }
+                else if (std::strchr("^$.*+?()[]{}|", c))
+                    return false;
+
+                if (next < _regex.size() && isQuantifier(_regex[next]))
+                    return false;
+                _prefix.push_back(c);
+                i = next;
+            }
+            return true;
+        }
+
+        core::vector<SNode> m_nodes;
+        core::vector<SPattern> m_patterns;
+    };
+
+    mutable std::once_flag m_dispatcherBuilt;
+    mutable CDispatcher m_dispatcher;
+
+    mutable std::mutex m_generatedMutex;
+    mutable core::unordered_map<std::string, std::string> m_generated;
 };
 
 }}
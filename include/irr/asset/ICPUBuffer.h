@@ -109,7 +109,7 @@ class CCustomAllocatorCPUBuffer;
 template<typename Allocator>
 class CCustomAllocatorCPUBuffer<Allocator, true> : public ICPUBuffer
 {
-    static_assert(sizeof(Allocator::value_type) == 1u, "Allocator::value_type must be of size 1");
+    static_assert(sizeof(typename Allocator::value_type) == 1u, "Allocator::value_type must be of size 1");
 protected:
     Allocator m_allocator;
 
@@ -124,6 +124,15 @@ public:
     CCustomAllocatorCPUBuffer(size_t sizeInBytes, void* dat, core::adopt_memory_t, Allocator&& alctr = Allocator()) : ICPUBuffer(sizeInBytes, dat), m_allocator(std::move(alctr))
     {
     }
+
+    virtual void convertToDummyObject() override
+    {
+        if (ICPUBuffer::data)
+            m_allocator.deallocate(reinterpret_cast<typename Allocator::pointer>(ICPUBuffer::data), ICPUBuffer::size);
+        ICPUBuffer::data = nullptr; // so that ICPUBuffer won't try deallocating memory it didn't allocate
+        ICPUBuffer::size = 0ull;
+        isDummyObjectForCacheAliasing = true;
+    }
 };
 
 template<typename Allocator>
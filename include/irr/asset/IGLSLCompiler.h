@@ -1,9 +1,18 @@
 #ifndef __IRR_I_GLSL_COMPILER_H_INCLUDED__
 #define __IRR_I_GLSL_COMPILER_H_INCLUDED__
 
+#include <memory>
+#include <future>
+
 #include "irr/core/IReferenceCounted.h"
+#include "irr/core/CThreadPool.h"
 #include "irr/asset/ShaderCommons.h"
+#include "irr/asset/CSPIR_VCache.h"
 
+namespace shaderc
+{
+    class Compiler;
+}
 namespace irr { namespace asset
 {
 class ICPUShader;
@@ -11,7 +20,30 @@ class ICPUShader;
 //! Will be derivative of IShaderGenerator, but we have to establish interface first
 class IGLSLCompiler : public core::IReferenceCounted
 {
+protected:
+    virtual ~IGLSLCompiler();
+
 public:
+    //! One shader for createShadersAsync()
+    //! One of `glsl` and `spirv` has to be set, jobs with neither yield a null shader.
+    struct SCompileJob
+    {
+        //! Null terminated GLSL, ignored when `spirv` is set
+        const char* glsl = nullptr;
+        //! Already compiled bytecode which only needs introspecting
+        const void* spirv = nullptr;
+        size_t spirvSize = 0u;
+        E_SHADER_STAGE stage = ESS_UNKNOWN;
+        const char* entryPoint = "main";
+        bool debug = false;
+        const char* compilationId = nullptr;
+        //! Whether to run ICPUShader::enableIntrospection() on the worker as well
+        bool introspect = true;
+    };
+
+    //! @param _cache Optional, when present bytecode compiled before (possibly by an earlier run) gets reused for identical preprocessed sources.
+    IGLSLCompiler(core::smart_refctd_ptr<CSPIR_VCache>&& _cache = nullptr);
+
     /**
     If _stage is ESS_UNKNOWN, then compiler will try to deduce shader stage from #pragma annotation, i.e.:
     #pragma shader_stage(vertex),       or
@@ -22,8 +54,30 @@ public:
     #pragma shader_stage(compute)
 
     Such annotation should be placed right after #version directive.
+
+    Safe to call from several threads at once.
     */
     ICPUShader* createShaderFromGLSL(const char* _glslCode, E_SHADER_STAGE _stage, const char* _entryPoint, bool _debug = false, const char* compilationId = nullptr) const;
+
+    //! Starts compiling and introspecting all `_jobs` on a pool of compiler threads and returns immediately.
+    /** Each future yields what createShaderFromGLSL() (or the ICPUShader constructor for SPIR-V jobs) would have returned,
+    with introspection data for all entry points already in place when the job asked for it. Exceptions thrown by the reflection end up in the future.
+    The strings and bytecode a job points to must stay valid until its future is ready.
+    Destroying the compiler waits for all jobs still running.
+    */
+    core::vector<std::future<ICPUShader*> > createShadersAsync(const core::vector<SCompileJob>& _jobs) const;
+
+    const CSPIR_VCache* getSPIR_VCache() const { return m_cache.get(); }
+
+private:
+    ICPUShader* runCompileJob(const SCompileJob& _job) const;
+
+    //! shaderc compilers may be used by several threads at once as long as nobody changes them
+    std::unique_ptr<shaderc::Compiler> m_compiler;
+    core::smart_refctd_ptr<CSPIR_VCache> m_cache;
+    //! Created on first use of createShadersAsync()
+    mutable core::CThreadPool* m_compilePool;
+    mutable core::mutex m_compilePoolMutex;
 };
 
 }}
@@ -88,14 +88,16 @@ namespace asset
 		IReferenceCounted::drop() for more information. */
 		virtual asset::ICPUMeshBuffer* createMeshBufferUniquePrimitives(asset::ICPUMeshBuffer* inbuffer) const = 0;
 
-		//
+		//! Calculates normals by averaging the angle weighted face normals of all vertices within `epsilon` of each other which `vxcmp` accepts
+		/** The mesh buffer has to be unindexed.
+		\param threadCount Amount of threads to use, 0 means core::getDefaultThreadCount(). The result does not depend on it, but `vxcmp` gets called concurrently unless it is 1. */
 		virtual asset::ICPUMeshBuffer* calculateSmoothNormals(asset::ICPUMeshBuffer* inbuffer, bool makeNewMesh = false, float epsilon = 1.525e-5f,
 				asset::E_VERTEX_ATTRIBUTE_ID normalAttrID = asset::E_VERTEX_ATTRIBUTE_ID::EVAI_ATTR3, 
 				VxCmpFunction vxcmp = [](const IMeshManipulator::SSNGVertexData& v0, const IMeshManipulator::SSNGVertexData& v1, asset::ICPUMeshBuffer* buffer) 
 				{ 
 					static constexpr float cosOf45Deg = 0.70710678118f;
 					return v0.parentTriangleFaceNormal.dotProductAsFloat(v1.parentTriangleFaceNormal) > cosOf45Deg;
-				}) const = 0;
+				}, uint32_t threadCount = 0u) const = 0;
 
 		//! Creates a copy of a mesh with vertices welded
 		/** \param mesh Input mesh
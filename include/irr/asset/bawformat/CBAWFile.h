@@ -132,6 +132,9 @@ namespace asset
 	struct IRR_FORCE_EBO BAWFileVn {
         static constexpr const char* HEADER_STRING = "IrrlichtBaW BinaryFile";
         static constexpr uint64_t version = Version;
+        //! Since version 2 absolute file offsets of blobs are multiples of this, so that uncompressed blobs can be used in place from a memory mapped file.
+        //! The loader requires that padding between consecutive blobs is smaller than this, so older versions (tightly packed) have it equal to 1.
+        static constexpr uint32_t BLOB_ALIGNMENT = Version>=2ull ? 64u:1u;
 
 		//! 32-byte BaW binary format header, currently equal to "IrrlichtBaW BinaryFile" (and the rest filled with zeroes).
 		//! Also: last 8 bytes of file header is file-version number.
@@ -336,6 +339,8 @@ namespace asset
         static size_t calcNonInterpolatedAnimsOffset(const scene::CFinalBoneHierarchy* _fbh);
 		//! @copydoc calcBonesOffset(const scene::CFinalBoneHierarchy*)
         static size_t calcBoneNamesOffset(const scene::CFinalBoneHierarchy* _fbh);
+		//! @copydoc calcBonesOffset(const scene::CFinalBoneHierarchy*)
+        static size_t calcBoneNameIndexOffset(const scene::CFinalBoneHierarchy* _fbh);
 
 		//! Used for creating a blob. Calculates size (in bytes) of the block of blob resulting from exporting `*_fbh` object.
 		/** @param _fbh Pointer to object on the basis of which size of the block will be calculated.
@@ -352,6 +357,8 @@ namespace asset
         static size_t calcNonInterpolatedAnimsByteSize(const scene::CFinalBoneHierarchy* _fbh);
 		//! @copydoc calcBonesByteSize(const scene::CFinalBoneHierarchy*)
         static size_t calcBoneNamesByteSize(const scene::CFinalBoneHierarchy* _fbh);
+		//! @copydoc calcBonesByteSize(const scene::CFinalBoneHierarchy*)
+        static size_t calcBoneNameIndexByteSize(const scene::CFinalBoneHierarchy* _fbh);
 
 		//! Used for importing (unpacking) blob. Calculates offset of the block.
 		/** @returns Offset of the block based on corresponding member of the blob object.
@@ -380,7 +387,10 @@ namespace asset
 		size_t calcInterpolatedAnimsByteSize() const;
 		//! @copydoc calcBonesByteSize()
 		size_t calcNonInterpolatedAnimsByteSize() const;
-		// size of bone names is not dependent of any of 'count variables'. Since it's the last block its size can be calculated by {blobSize - boneNamesOffset}.
+		//! @copydoc calcBonesByteSize()
+		size_t calcBoneNameIndexByteSize() const;
+		// size of bone names is not dependent of any of 'count variables', the bone name index starts right after the last name.
+		// The index block is optional (older writers did not output it), it is present if it exactly fills the rest of the blob.
 
         size_t boneCount;
         size_t numLevelsInHierarchy;
@@ -437,6 +447,13 @@ namespace asset
         return sizeof(MeshDataFormatDescBlobV1);
     }
 
+    // ===============
+    // .baw VERSION 2
+    // ===============
+    //! Blobs are the same as in version 1, they are only padded to BAWFileV2::BLOB_ALIGNMENT within the file
+    using BlobHeaderV2 = BlobHeaderVn<2>;
+    using BAWFileV2 = BAWFileVn<2>;
+
 	template<typename>
 	struct CorrespondingBlobTypeFor;
 	template<>
@@ -30,6 +30,7 @@ namespace asset
 namespace io
 {
 	class IFileSystem;
+	class IReadFile;
 }
 
 namespace asset
@@ -43,6 +44,8 @@ namespace asset
 		io::path filePath;
         asset::IAssetLoader::SAssetLoadParams params;
         asset::IAssetLoader::IAssetLoaderOverride* loaderOverride;
+		//! File being loaded if its contents are memory mapped (blobs pointing into the mapping may be aliased instead of copied), nullptr otherwise
+		io::IReadFile* mappedFile;
 	};
 
 	//! Class abstracting blobs version from process of loading them from *.baw file.
@@ -0,0 +1,153 @@
+#ifndef __IRR_C_THREAD_POOL_H_INCLUDED__
+#define __IRR_C_THREAD_POOL_H_INCLUDED__
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <thread>
+
+#include "irr/core/Types.h"
+#include "irr/core/parallel_for.h"
+
+namespace irr
+{
+namespace core
+{
+
+//! Fixed set of worker threads executing fire-and-forget tasks, with a task queue per worker and work stealing.
+/**
+Tasks enqueued from within a worker go to the back of that worker's own queue and are popped LIFO (hot caches, depth first),
+tasks enqueued from other threads are dealt round-robin. An idle worker steals from the front of other workers' queues before going to sleep.
+Tasks must not block waiting on other tasks of the same pool, there is no guarantee a free worker is available to run them.
+The destructor runs every task which was already enqueued before joining the workers.
+*/
+class CThreadPool
+{
+	public:
+		typedef std::function<void()> task_type;
+
+		//! @param _threadCount Number of workers, 0 means getDefaultThreadCount().
+		explicit CThreadPool(uint32_t _threadCount=0u) : workerCount(_threadCount ? _threadCount:getDefaultThreadCount()), queues(new SQueue[workerCount]), nextQueue(0u), pendingTasks(0u), stopping(false)
+		{
+			workers.reserve(workerCount);
+			for (uint32_t i=0u; i<workerCount; i++)
+				workers.emplace_back(&CThreadPool::workerLoop,this,i);
+		}
+
+		~CThreadPool()
+		{
+			{
+				std::unique_lock<core::mutex> lock(sleepMutex);
+				stopping = true;
+			}
+			wakeUp.notify_all();
+			for (auto& worker : workers)
+				worker.join();
+			delete[] queues;
+		}
+
+		CThreadPool(const CThreadPool&) = delete;
+		CThreadPool& operator=(const CThreadPool&) = delete;
+
+		inline uint32_t getThreadCount() const { return workerCount; }
+
+		//! Schedules `_task` to run on one of the workers
+		inline void enqueue(task_type&& _task)
+		{
+			{
+				// taking the lock prevents the wake-up from slipping in between a worker's last check and its wait,
+				// counting before pushing means the count never drops below the number of queued tasks
+				std::lock_guard<core::mutex> lock(sleepMutex);
+				pendingTasks++;
+			}
+			const uint32_t queueIx = currentWorker().pool==this ? currentWorker().index:(nextQueue++%workerCount);
+			{
+				std::lock_guard<core::mutex> lock(queues[queueIx].mutex);
+				queues[queueIx].tasks.push_back(std::move(_task));
+			}
+			wakeUp.notify_one();
+		}
+
+	private:
+		struct alignas(_IRR_SIMD_ALIGNMENT*2) SQueue
+		{
+			core::mutex mutex;
+			std::deque<task_type> tasks;
+		};
+		struct SCurrentWorker
+		{
+			const CThreadPool* pool = nullptr;
+			uint32_t index = 0u;
+		};
+		static inline SCurrentWorker& currentWorker()
+		{
+			static thread_local SCurrentWorker worker;
+			return worker;
+		}
+
+		inline bool popOwn(uint32_t _ix, task_type& _out)
+		{
+			std::lock_guard<core::mutex> lock(queues[_ix].mutex);
+			if (queues[_ix].tasks.empty())
+				return false;
+			_out = std::move(queues[_ix].tasks.back());
+			queues[_ix].tasks.pop_back();
+			return true;
+		}
+		inline bool steal(uint32_t _thief, task_type& _out)
+		{
+			for (uint32_t i=1u; i<workerCount; i++)
+			{
+				SQueue& victim = queues[(_thief+i)%workerCount];
+				std::lock_guard<core::mutex> lock(victim.mutex);
+				if (victim.tasks.empty())
+					continue;
+				_out = std::move(victim.tasks.front());
+				victim.tasks.pop_front();
+				return true;
+			}
+			return false;
+		}
+
+		void workerLoop(uint32_t _ix)
+		{
+			currentWorker().pool = this;
+			currentWorker().index = _ix;
+
+			task_type task;
+			while (true)
+			{
+				if (popOwn(_ix,task) || steal(_ix,task))
+				{
+					{
+						std::lock_guard<core::mutex> lock(sleepMutex);
+						pendingTasks--;
+					}
+					task();
+					task = nullptr;
+					continue;
+				}
+
+				std::unique_lock<core::mutex> lock(sleepMutex);
+				wakeUp.wait(lock,[this]() {return pendingTasks!=0u || stopping;});
+				if (pendingTasks==0u && stopping)
+					return;
+			}
+		}
+
+		const uint32_t workerCount;
+		SQueue* queues;
+		core::vector<std::thread> workers;
+		std::atomic<uint32_t> nextQueue;
+
+		core::mutex sleepMutex;
+		std::condition_variable wakeUp;
+		uint32_t pendingTasks;
+		bool stopping;
+};
+
+} // end namespace core
+} // end namespace irr
+
+#endif
@@ -0,0 +1,189 @@
+#ifndef __IRR_FLAT_HASH_MAP_H_INCLUDED__
+#define __IRR_FLAT_HASH_MAP_H_INCLUDED__
+
+#include <functional>
+#include <utility>
+
+#include "irr/core/Types.h"
+#include "irr/core/math/irrMath.h"
+
+namespace irr
+{
+namespace core
+{
+
+//! Hash map with open addressing (linear probing) over a single contiguous array of slots.
+/**
+Unlike core::unordered_map there is no allocation per element and a lookup touches one or two cachelines in the common case.
+The full hash of every element is kept next to it, so mismatching keys are rejected without calling KeyEqual,
+and callers which already know the hash of a key (e.g. because they precomputed it) can pass it in to skip hashing.
+Erasure uses backward-shift deletion, so there are no tombstones and lookups never degrade over time.
+Pointers returned by find() and insert() are invalidated by any subsequent insert(), erase() or reserve().
+*/
+template<typename K, typename T, class Hash=std::hash<K>, class KeyEqual=std::equal_to<K>, class Allocator=allocator<std::pair<K,T> > >
+class flat_hash_map
+{
+	public:
+		typedef K key_type;
+		typedef T mapped_type;
+		typedef std::pair<K,T> value_type;
+
+		flat_hash_map(size_t _reserve=0u, const Hash& _hasher=Hash(), const KeyEqual& _equal=KeyEqual()) : hasher(_hasher), equal(_equal), elementCount(0u)
+		{
+			reserve(_reserve);
+		}
+
+		inline size_t size() const { return elementCount; }
+		inline bool empty() const { return elementCount==0u; }
+
+		//! Hash as stored in the table, never 0 since that marks an empty slot
+		inline size_t hash(const K& _key) const
+		{
+			// std::hash is often the identity, scramble it so the low bits used for the slot are well distributed
+			uint64_t h = hasher(_key);
+			h ^= h>>32;
+			h *= 0x9e3779b97f4a7c15ull;
+			h ^= h>>29;
+			return h ? static_cast<size_t>(h):1u;
+		}
+
+		//! Makes sure `_count` elements can be held without a rehash
+		inline void reserve(size_t _count)
+		{
+			// keep load factor at or below 0.5
+			const size_t wanted = core::roundUpToPoT<size_t>(core::max_<size_t>(_count,4u)*2u);
+			if (wanted>hashes.size())
+				rehash(wanted);
+		}
+
+		inline void clear()
+		{
+			slots.clear();
+			hashes.clear();
+			elementCount = 0u;
+		}
+
+		inline T* find(const K& _key) { return find(_key,hash(_key)); }
+		inline const T* find(const K& _key) const { return find(_key,hash(_key)); }
+		//! `_hash` must be the value returned by hash(_key)
+		inline T* find(const K& _key, size_t _hash) { return const_cast<T*>(static_cast<const flat_hash_map*>(this)->find(_key,_hash)); }
+		inline const T* find(const K& _key, size_t _hash) const
+		{
+			if (elementCount==0u)
+				return nullptr;
+
+			const size_t mask = hashes.size()-1u;
+			for (size_t slot=_hash&mask; hashes[slot]; slot=(slot+1u)&mask)
+			if (hashes[slot]==_hash && equal(slots[slot].first,_key))
+				return &slots[slot].second;
+
+			return nullptr;
+		}
+
+		//! Returns pointer to the value under `_key` and whether it was inserted (false means the key was already present and `_value` was discarded)
+		inline std::pair<T*,bool> insert(const K& _key, const T& _value) { return insert(K(_key),T(_value),hash(_key)); }
+		inline std::pair<T*,bool> insert(K&& _key, T&& _value)
+		{
+			const size_t h = hash(_key);
+			return insert(std::move(_key),std::move(_value),h);
+		}
+		//! `_hash` must be the value returned by hash(_key)
+		inline std::pair<T*,bool> insert(K&& _key, T&& _value, size_t _hash)
+		{
+			reserve(elementCount+1u);
+
+			const size_t mask = hashes.size()-1u;
+			size_t slot = _hash&mask;
+			for (; hashes[slot]; slot=(slot+1u)&mask)
+			if (hashes[slot]==_hash && equal(slots[slot].first,_key))
+				return {&slots[slot].second,false};
+
+			hashes[slot] = _hash;
+			slots[slot].first = std::move(_key);
+			slots[slot].second = std::move(_value);
+			elementCount++;
+			return {&slots[slot].second,true};
+		}
+
+		//! Returns whether anything was erased
+		inline bool erase(const K& _key) { return erase(_key,hash(_key)); }
+		inline bool erase(const K& _key, size_t _hash)
+		{
+			if (elementCount==0u)
+				return false;
+
+			const size_t mask = hashes.size()-1u;
+			size_t slot = _hash&mask;
+			for (; hashes[slot]; slot=(slot+1u)&mask)
+			if (hashes[slot]==_hash && equal(slots[slot].first,_key))
+				break;
+			if (!hashes[slot])
+				return false;
+
+			// backward shift the rest of the probe chain into the hole
+			for (size_t next=(slot+1u)&mask; hashes[next]; next=(next+1u)&mask)
+			{
+				const size_t home = hashes[next]&mask;
+				// can only move `next` into `slot` if its home is not cyclically within (slot,next]
+				if (((next-home)&mask) >= ((next-slot)&mask))
+				{
+					hashes[slot] = hashes[next];
+					slots[slot] = std::move(slots[next]);
+					slot = next;
+				}
+			}
+			hashes[slot] = 0u;
+			slots[slot] = value_type();
+			elementCount--;
+			return true;
+		}
+
+		//! Calls `_func(const K&, T&)` for every element, in unspecified order
+		template<class F>
+		inline void for_each(F&& _func)
+		{
+			for (size_t i=0u; i<hashes.size(); i++)
+			if (hashes[i])
+				_func(const_cast<const K&>(slots[i].first),slots[i].second);
+		}
+		template<class F>
+		inline void for_each(F&& _func) const
+		{
+			for (size_t i=0u; i<hashes.size(); i++)
+			if (hashes[i])
+				_func(slots[i].first,slots[i].second);
+		}
+
+	private:
+		inline void rehash(size_t _slotCount)
+		{
+			core::vector<value_type,Allocator> oldSlots(_slotCount);
+			core::vector<size_t> oldHashes(_slotCount,0u);
+			oldSlots.swap(slots);
+			oldHashes.swap(hashes);
+
+			const size_t mask = _slotCount-1u;
+			for (size_t i=0u; i<oldHashes.size(); i++)
+			{
+				if (!oldHashes[i])
+					continue;
+
+				size_t slot = oldHashes[i]&mask;
+				while (hashes[slot])
+					slot = (slot+1u)&mask;
+				hashes[slot] = oldHashes[i];
+				slots[slot] = std::move(oldSlots[i]);
+			}
+		}
+
+		Hash hasher;
+		KeyEqual equal;
+		core::vector<value_type,Allocator> slots;
+		core::vector<size_t> hashes;
+		size_t elementCount;
+};
+
+} // end namespace core
+} // end namespace irr
+
+#endif
@@ -0,0 +1,289 @@
+#ifndef __IRR_FLAT_HASH_MULTIMAP_H_INCLUDED__
+#define __IRR_FLAT_HASH_MULTIMAP_H_INCLUDED__
+
+#include <functional>
+#include <iterator>
+#include <list>
+#include <type_traits>
+#include <utility>
+
+#include "irr/core/Types.h"
+#include "irr/core/math/irrMath.h"
+
+namespace irr
+{
+namespace core
+{
+
+//! Multimap with O(1) average lookup, interface compatible with the subset of std::multimap used by CMultiObjectCache.
+/**
+Elements sharing a key form a group, groups live in a dense array and an open addressing (linear probing) index maps keys to groups.
+The index only stores group numbers, the full hash of every key is computed once on insertion and kept with its group,
+so probing compares integers and the key itself is compared (once, in the common case) only on a full hash match.
+Every distinct key is therefore hashed once per lookup and never duplicated into the index.
+Iteration visits group by group, which keeps equal_range() contiguous, but the order of groups is unspecified.
+
+The template signature mirrors std::multimap so the container can be plugged into CObjectCache's `ContainerT_T` parameter,
+`Unused` takes the place of the comparator and is ignored. Any erase() or insert() of a new key invalidates all iterators.
+*/
+template<typename K, typename T, class Unused=std::less<K>, class Allocator=allocator<std::pair<const typename std::remove_const<K>::type,T> >, class Hash=std::hash<typename std::remove_const<K>::type> >
+class flat_hash_multimap
+{
+	public:
+		typedef typename std::remove_const<K>::type key_type;
+		typedef T mapped_type;
+		typedef std::pair<const key_type,T> value_type;
+		typedef size_t size_type;
+		typedef ptrdiff_t difference_type;
+
+	private:
+		typedef std::list<value_type,Allocator> group_list_t;
+		struct SGroup
+		{
+			size_t hash;
+			group_list_t elements;
+		};
+		typedef core::vector<SGroup> group_array_t;
+
+		template<bool isConst>
+		class iterator_base
+		{
+				friend class flat_hash_multimap;
+				typedef typename std::conditional<isConst,const group_array_t,group_array_t>::type groups_t;
+				typedef typename std::conditional<isConst,typename group_list_t::const_iterator,typename group_list_t::iterator>::type list_iterator_t;
+
+				groups_t* groups;
+				size_t group;
+				list_iterator_t element;
+
+				iterator_base(groups_t* _groups, size_t _group, list_iterator_t _element) : groups(_groups), group(_group), element(_element) {}
+				//! Iterator to the first element of `_group`, or end() if `_group` is one past the last group
+				iterator_base(groups_t* _groups, size_t _group) : groups(_groups), group(_group), element()
+				{
+					if (group<groups->size())
+						element = (*groups)[group].elements.begin();
+				}
+
+			public:
+				typedef std::forward_iterator_tag iterator_category;
+				typedef typename flat_hash_multimap::value_type value_type;
+				typedef typename flat_hash_multimap::difference_type difference_type;
+				typedef typename std::conditional<isConst,const value_type*,value_type*>::type pointer;
+				typedef typename std::conditional<isConst,const value_type&,value_type&>::type reference;
+
+				iterator_base() : groups(nullptr), group(0u), element() {}
+				//! Allows iterator -> const_iterator conversion
+				template<bool otherConst, typename = typename std::enable_if<isConst && !otherConst>::type>
+				iterator_base(const iterator_base<otherConst>& _other) : groups(_other.groups), group(_other.group), element(_other.element) {}
+
+				inline reference operator*() const { return *element; }
+				inline pointer operator->() const { return &(*element); }
+
+				inline iterator_base& operator++()
+				{
+					if (++element == (*groups)[group].elements.end())
+						*this = iterator_base(groups,group+1u);
+					return *this;
+				}
+				inline iterator_base operator++(int)
+				{
+					iterator_base tmp(*this);
+					++(*this);
+					return tmp;
+				}
+
+				inline bool operator==(const iterator_base& _other) const
+				{
+					if (group!=_other.group)
+						return false;
+					// all end iterators are equal
+					return (groups && group>=groups->size()) || element==_other.element;
+				}
+				inline bool operator!=(const iterator_base& _other) const { return !operator==(_other); }
+
+				template<bool> friend class iterator_base;
+		};
+
+	public:
+		typedef iterator_base<false> iterator;
+		typedef iterator_base<true> const_iterator;
+		typedef std::reverse_iterator<iterator> reverse_iterator;
+		typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+		flat_hash_multimap(const Hash& _hasher=Hash()) : hasher(_hasher), elementCount(0u) {}
+
+		inline size_t size() const { return elementCount; }
+		inline bool empty() const { return elementCount==0u; }
+
+		inline iterator begin() { return iterator(&groups,0u); }
+		inline const_iterator begin() const { return const_iterator(&groups,0u); }
+		inline const_iterator cbegin() const { return begin(); }
+		inline iterator end() { return iterator(&groups,groups.size()); }
+		inline const_iterator end() const { return const_iterator(&groups,groups.size()); }
+		inline const_iterator cend() const { return end(); }
+
+		inline void clear()
+		{
+			groups.clear();
+			index.clear();
+			elementCount = 0u;
+		}
+
+		//! Hash as stored in the groups, computed exactly once per call of any of the key based methods
+		inline size_t hash(const key_type& _key) const
+		{
+			// std::hash is often the identity, scramble it so the low bits used for the slot are well distributed
+			uint64_t h = hasher(_key);
+			h ^= h>>32;
+			h *= 0x9e3779b97f4a7c15ull;
+			h ^= h>>29;
+			return static_cast<size_t>(h);
+		}
+
+		inline std::pair<iterator,iterator> equal_range(const key_type& _key)
+		{
+			const size_t g = findGroup(_key,hash(_key));
+			if (g==InvalidGroup)
+				return {end(),end()};
+			return {iterator(&groups,g),iterator(&groups,g+1u)};
+		}
+		inline std::pair<const_iterator,const_iterator> equal_range(const key_type& _key) const
+		{
+			const size_t g = findGroup(_key,hash(_key));
+			if (g==InvalidGroup)
+				return {end(),end()};
+			return {const_iterator(&groups,g),const_iterator(&groups,g+1u)};
+		}
+
+		//! Appends to the elements already under the key (if any)
+		inline iterator insert(const value_type& _value)
+		{
+			const size_t h = hash(_value.first);
+			size_t g = findGroup(_value.first,h);
+			if (g==InvalidGroup)
+				g = addGroup(h);
+			group_list_t& elements = groups[g].elements;
+			elements.push_back(_value);
+			elementCount++;
+			return iterator(&groups,g,std::prev(elements.end()));
+		}
+		//! Hint is ignored, position within a group does not matter for a cache
+		inline iterator insert(const_iterator, const value_type& _value) { return insert(_value); }
+
+		inline iterator erase(const_iterator _it)
+		{
+			const size_t g = _it.group;
+			group_list_t& elements = groups[g].elements;
+			auto next = elements.erase(_it.element);
+			elementCount--;
+			if (next!=elements.end())
+				return iterator(&groups,g,next);
+
+			if (elements.empty())
+			{
+				removeGroup(g);
+				// last group got moved into the hole
+				return iterator(&groups,g);
+			}
+			return iterator(&groups,g+1u);
+		}
+
+	private:
+		_IRR_STATIC_INLINE_CONSTEXPR size_t InvalidGroup = ~size_t(0u);
+		// slot value 0 marks an empty slot, otherwise it stores group+1
+		typedef uint32_t slot_t;
+
+		inline size_t findGroup(const key_type& _key, size_t _hash) const
+		{
+			if (index.empty())
+				return InvalidGroup;
+
+			const size_t mask = index.size()-1u;
+			for (size_t slot=_hash&mask; index[slot]; slot=(slot+1u)&mask)
+			{
+				const SGroup& group = groups[index[slot]-1u];
+				if (group.hash==_hash && group.elements.front().first==_key)
+					return index[slot]-1u;
+			}
+			return InvalidGroup;
+		}
+
+		inline size_t findSlot(size_t _group) const
+		{
+			const size_t mask = index.size()-1u;
+			size_t slot = groups[_group].hash&mask;
+			while (index[slot]!=_group+1u)
+				slot = (slot+1u)&mask;
+			return slot;
+		}
+
+		inline size_t addGroup(size_t _hash)
+		{
+			// keep load factor at or below 0.5
+			const size_t wanted = core::roundUpToPoT<size_t>(core::max_<size_t>(groups.size()+1u,4u)*2u);
+			if (wanted>index.size())
+				rehash(wanted);
+
+			const size_t g = groups.size();
+			groups.push_back({_hash,group_list_t()});
+
+			const size_t mask = index.size()-1u;
+			size_t slot = _hash&mask;
+			while (index[slot])
+				slot = (slot+1u)&mask;
+			index[slot] = static_cast<slot_t>(g+1u);
+			return g;
+		}
+
+		inline void removeGroup(size_t _group)
+		{
+			const size_t mask = index.size()-1u;
+			size_t slot = findSlot(_group);
+			// backward shift the rest of the probe chain into the hole
+			for (size_t next=(slot+1u)&mask; index[next]; next=(next+1u)&mask)
+			{
+				const size_t home = groups[index[next]-1u].hash&mask;
+				// can only move `next` into `slot` if its home is not cyclically within (slot,next]
+				if (((next-home)&mask) >= ((next-slot)&mask))
+				{
+					index[slot] = index[next];
+					slot = next;
+				}
+			}
+			index[slot] = 0u;
+
+			// keep groups dense by moving the last one into the hole
+			const size_t last = groups.size()-1u;
+			if (_group!=last)
+			{
+				index[findSlot(last)] = static_cast<slot_t>(_group+1u);
+				// swap instead of move assigning, which could end up assigning elements with a const key
+				groups[_group].hash = groups[last].hash;
+				groups[_group].elements.swap(groups[last].elements);
+			}
+			groups.pop_back();
+		}
+
+		inline void rehash(size_t _slotCount)
+		{
+			index.assign(_slotCount,0u);
+			const size_t mask = _slotCount-1u;
+			for (size_t g=0u; g<groups.size(); g++)
+			{
+				size_t slot = groups[g].hash&mask;
+				while (index[slot])
+					slot = (slot+1u)&mask;
+				index[slot] = static_cast<slot_t>(g+1u);
+			}
+		}
+
+		Hash hasher;
+		group_array_t groups;
+		core::vector<slot_t> index;
+		size_t elementCount;
+};
+
+} // end namespace core
+} // end namespace irr
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef __IRR_PARALLEL_FOR_H_INCLUDED__
+#define __IRR_PARALLEL_FOR_H_INCLUDED__
+
+#include <thread>
+#include <algorithm>
+
+#include "irr/core/Types.h"
+
+namespace irr
+{
+namespace core
+{
+
+//! Thread count used by the parallel algorithms when the caller passes 0
+inline uint32_t getDefaultThreadCount()
+{
+    const uint32_t hwThreads = std::thread::hardware_concurrency();
+    return hwThreads ? hwThreads:1u;
+}
+
+//! Splits [_begin,_end) into at most `_threadCount` contiguous chunks of at least `_minGrain` elements and runs `_func(chunkBegin,chunkEnd)` for each one.
+/**
+The calling thread processes the last chunk itself and the function only returns once all chunks are done.
+The chunk boundaries depend on the arguments alone, so a `_func` which only writes to its own range produces the same output regardless of scheduling.
+@param _threadCount Upper bound on the number of threads (including the calling one), 0 means getDefaultThreadCount().
+@param _minGrain Smallest chunk worth spawning a thread for, ranges smaller than this run inline.
+*/
+template<typename IndexT, class F>
+inline void parallel_for(IndexT _begin, IndexT _end, F&& _func, uint32_t _threadCount=0u, IndexT _minGrain=IndexT(1))
+{
+    if (_end<=_begin)
+        return;
+
+    const IndexT count = _end-_begin;
+    if (_threadCount==0u)
+        _threadCount = getDefaultThreadCount();
+    if (_minGrain<IndexT(1))
+        _minGrain = IndexT(1);
+    const IndexT chunkCount = std::max(IndexT(1),std::min(IndexT(_threadCount),count/_minGrain));
+    if (chunkCount==IndexT(1))
+    {
+        _func(_begin,_end);
+        return;
+    }
+
+    const IndexT chunkSize = count/chunkCount;
+    const IndexT remainder = count%chunkCount;
+
+    core::vector<std::thread> workers;
+    workers.reserve(static_cast<size_t>(chunkCount-IndexT(1)));
+    IndexT chunkBegin = _begin;
+    for (IndexT i=0; i<chunkCount-IndexT(1); i++)
+    {
+        const IndexT chunkEnd = chunkBegin+chunkSize+(i<remainder ? IndexT(1):IndexT(0));
+        workers.emplace_back([&_func,chunkBegin,chunkEnd]() {_func(chunkBegin,chunkEnd);});
+        chunkBegin = chunkEnd;
+    }
+    _func(chunkBegin,_end);
+
+    for (auto& worker : workers)
+        worker.join();
+}
+
+} // end namespace core
+} // end namespace irr
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef __IRR_COMPRESS_BLOCKS_H_INCLUDED__
+#define __IRR_COMPRESS_BLOCKS_H_INCLUDED__
+
+#include <cstdint>
+
+#include "irr/core/Types.h"
+#include "irr/asset/EFormat.h"
+#include "vector3d.h"
+
+namespace irr
+{
+namespace asset
+{
+    class CImageData;
+}
+
+namespace video
+{
+    //! Speed against quality trade-off of the block compressor
+    enum E_BLOCK_COMPRESSION_QUALITY : uint32_t
+    {
+        //! Endpoints from the bounding box of the block, indices picked once
+        EBCQ_FASTEST = 0u,
+        //! Endpoints along the principal axis of the block, refined once by least squares
+        EBCQ_NORMAL,
+        //! Several refinement passes, every alternative block mode and p-bit combination gets tried
+        EBCQ_HIGHEST
+    };
+
+    //! Whether compressBlocks can produce `_fmt`, that is BC1, BC2, BC3, BC4, BC5 and BC7
+    bool isBlockCompressorFormat(asset::E_FORMAT _fmt);
+
+    //! The format texels have to be in before being handed to compressBlocks to produce `_fmt`, always 4 bytes per texel in RGBA order
+    /** sRGB block formats take sRGB encoded texels and signed ones take signed texels, anything else takes EF_R8G8B8A8_UNORM. */
+    asset::E_FORMAT getBlockCompressorInputFormat(asset::E_FORMAT _fmt);
+
+    //! Block compressed format which fits `_fmt` best, or EF_UNKNOWN if there is none worth compressing to
+    /**
+    Opaque RGB goes to BC1, RGB with alpha to BC3, single and dual channel UNORM formats go to BC4 and BC5. With `_preferBC7` all RGB(A) formats go to BC7 instead.
+    Single and dual channel sRGB formats are left alone, because no block compressed format can hold them.
+    */
+    asset::E_FORMAT getBlockCompressedFormat(asset::E_FORMAT _fmt, bool _preferBC7=false);
+
+    //! Compresses a whole image of texels in the format returned by getBlockCompressorInputFormat(_fmt)
+    /**
+    Texels are tightly packed row by row and slice by slice, blocks are written the same way with partial blocks at the right and bottom edges padded by repeating the last column and row.
+    @param _threadCount Rows of blocks are spread over this many threads, 0 means getDefaultThreadCount(). The output does not depend on the thread count.
+    */
+    void compressBlocks(asset::E_FORMAT _fmt, const void* _texels, void* _blocks, const core::vector3d<uint32_t>& _imgSize, E_BLOCK_COMPRESSION_QUALITY _quality=EBCQ_NORMAL, uint32_t _threadCount=0u);
+
+    //! Creates a block compressed copy of `_image` in `_fmt`, @returns nullptr if `_fmt` is not a compressor format or the image is block compressed already
+    asset::CImageData* createBlockCompressedImage(const asset::CImageData* _image, asset::E_FORMAT _fmt, E_BLOCK_COMPRESSION_QUALITY _quality=EBCQ_NORMAL, uint32_t _threadCount=0u);
+
+    //! Replaces every image in `_images` which has a block compressed format (according to getBlockCompressedFormat) with its compressed copy, the replaced images are dropped
+    /** For the image loaders, with `_highQuality` RGB(A) images go to BC7 with EBCQ_HIGHEST, otherwise to BC1/BC3 with EBCQ_NORMAL. */
+    void blockCompressImages(core::vector<asset::CImageData*>& _images, bool _highQuality, uint32_t _threadCount=0u);
+
+    namespace impl
+    {
+        //! Compresses a single 4x4 block, `_texels` are in the format returned by getBlockCompressorInputFormat(_fmt) row by row
+        void compressBlock(asset::E_FORMAT _fmt, const uint8_t _texels[16][4], void* _block, E_BLOCK_COMPRESSION_QUALITY _quality);
+    }
+}
+}
+
+#endif
@@ -2,10 +2,14 @@
 #define __IRR_CONVERT_COLOR_H_INCLUDED__
 
 #include <cassert>
+#include <cstring>
+#include "IrrCompileConfig.h"
 #include "irr/static_if.h"
+#include "irr/core/parallel_for.h"
 #include "irr/asset/EFormat.h"
 #include "decodePixels.h"
 #include "encodePixels.h"
+#include "compressBlocks.h"
 
 #ifdef __GNUC__
     #pragma GCC diagnostic push
@@ -77,6 +81,7 @@ namespace irr { namespace video
     inline void convertColor(const void* srcPix[4], void* dstPix, uint32_t _blockX, uint32_t _blockY)
     {
         using namespace asset;
+        static_assert(!isBlockCompressionFormat<dF>(), "Block compressed formats can only be encoded a whole image at a time");
         if (isIntegerFormat<sF>() && isIntegerFormat<dF>())
         {
             using decT = typename std::conditional<isSignedFormat<sF>(), int64_t, uint64_t>::type;
@@ -122,53 +127,358 @@ namespace irr { namespace video
             impl::SCallEncode<dF, encT>{}(dstPix, encbuf);
         }
     }
-    template<asset::E_FORMAT sF, asset::E_FORMAT dF>
-    inline void convertColor(const void* srcPix[4], void* dstPix, size_t _pixOrBlockCnt, core::vector3d<uint32_t>& _imgSize)
+
+    namespace impl
     {
-        using namespace asset;
+        //! Bit layout of a texel format which can take part in a table driven conversion, channels are in RGBA order
+        struct SFastPathTexelLayout
+        {
+            uint32_t size; //!< in bytes, 0 if the format has no fast path
+            uint32_t offset[4];
+            uint32_t width[4]; //!< 0 if the format does not have the channel
+        };
 
-        const uint32_t srcStride = getTexelOrBlockSize(sF);
-        const uint32_t dstStride = getTexelOrBlockSize(dF);
+        constexpr SFastPathTexelLayout getFastPathTexelLayout(asset::E_FORMAT _fmt)
+        {
+            switch (_fmt)
+            {
+                case asset::EF_R8G8B8_UNORM:
+                case asset::EF_R8G8B8_SNORM:
+                case asset::EF_R8G8B8_USCALED:
+                case asset::EF_R8G8B8_SSCALED:
+                case asset::EF_R8G8B8_UINT:
+                case asset::EF_R8G8B8_SINT:
+                case asset::EF_R8G8B8_SRGB:
+                    return {3u,{0u,8u,16u,0u},{8u,8u,8u,0u}};
+                case asset::EF_B8G8R8_UNORM:
+                case asset::EF_B8G8R8_SNORM:
+                case asset::EF_B8G8R8_USCALED:
+                case asset::EF_B8G8R8_SSCALED:
+                case asset::EF_B8G8R8_UINT:
+                case asset::EF_B8G8R8_SINT:
+                case asset::EF_B8G8R8_SRGB:
+                    return {3u,{16u,8u,0u,0u},{8u,8u,8u,0u}};
+                case asset::EF_R8G8B8A8_UNORM:
+                case asset::EF_R8G8B8A8_SNORM:
+                case asset::EF_R8G8B8A8_USCALED:
+                case asset::EF_R8G8B8A8_SSCALED:
+                case asset::EF_R8G8B8A8_UINT:
+                case asset::EF_R8G8B8A8_SINT:
+                case asset::EF_R8G8B8A8_SRGB:
+                case asset::EF_A8B8G8R8_UNORM_PACK32:
+                case asset::EF_A8B8G8R8_SNORM_PACK32:
+                case asset::EF_A8B8G8R8_USCALED_PACK32:
+                case asset::EF_A8B8G8R8_SSCALED_PACK32:
+                case asset::EF_A8B8G8R8_UINT_PACK32:
+                case asset::EF_A8B8G8R8_SINT_PACK32:
+                case asset::EF_A8B8G8R8_SRGB_PACK32:
+                    return {4u,{0u,8u,16u,24u},{8u,8u,8u,8u}};
+                case asset::EF_B8G8R8A8_UNORM:
+                case asset::EF_B8G8R8A8_SNORM:
+                case asset::EF_B8G8R8A8_USCALED:
+                case asset::EF_B8G8R8A8_SSCALED:
+                case asset::EF_B8G8R8A8_UINT:
+                case asset::EF_B8G8R8A8_SINT:
+                case asset::EF_B8G8R8A8_SRGB:
+                    return {4u,{16u,8u,0u,24u},{8u,8u,8u,8u}};
+                case asset::EF_A2R10G10B10_UNORM_PACK32:
+                case asset::EF_A2R10G10B10_SNORM_PACK32:
+                case asset::EF_A2R10G10B10_USCALED_PACK32:
+                case asset::EF_A2R10G10B10_SSCALED_PACK32:
+                case asset::EF_A2R10G10B10_UINT_PACK32:
+                case asset::EF_A2R10G10B10_SINT_PACK32:
+                    return {4u,{20u,10u,0u,30u},{10u,10u,10u,2u}};
+                case asset::EF_A2B10G10R10_UNORM_PACK32:
+                case asset::EF_A2B10G10R10_SNORM_PACK32:
+                case asset::EF_A2B10G10R10_USCALED_PACK32:
+                case asset::EF_A2B10G10R10_SSCALED_PACK32:
+                case asset::EF_A2B10G10R10_UINT_PACK32:
+                case asset::EF_A2B10G10R10_SINT_PACK32:
+                    return {4u,{0u,10u,20u,30u},{10u,10u,10u,2u}};
+                // only as destination, 16bit source channels would need too large tables
+                case asset::EF_R16G16B16_SFLOAT:
+                    return {6u,{0u,16u,32u,0u},{16u,16u,16u,0u}};
+                case asset::EF_R16G16B16A16_SFLOAT:
+                    return {8u,{0u,16u,32u,48u},{16u,16u,16u,16u}};
+                default:
+                    return {0u,{0u,0u,0u,0u},{0u,0u,0u,0u}};
+            }
+        }
 
-        uint32_t hPlaneReduction[4], vPlaneReduction[4], chCntInPlane[4];
-        getHorizontalReductionFactorPerPlane(sF, hPlaneReduction);
-        getVerticalReductionFactorPerPlane(sF, vPlaneReduction);
-        getChannelsPerPlane(sF, chCntInPlane);
+        //! Widest channel of the source format, decides the size of the lookup tables
+        constexpr uint32_t getFastPathMaxSourceWidth(asset::E_FORMAT _fmt)
+        {
+            const SFastPathTexelLayout layout = getFastPathTexelLayout(_fmt);
+            uint32_t retval = 0u;
+            for (uint32_t i=0u; i<4u; i++)
+                retval = layout.width[i]>retval ? layout.width[i]:retval;
+            return retval;
+        }
 
-        const core::vector3d<uint32_t> sdims = getBlockDimensions(sF);
+        //! Whether the conversion can be done by looking up every channel separately, that is if both formats are plain texels with every source channel at most 10 bits wide
+        template<asset::E_FORMAT sF, asset::E_FORMAT dF>
+        constexpr bool hasFastPath()
+        {
+            return getFastPathTexelLayout(sF).size!=0u && getFastPathTexelLayout(sF).size<=4u && getFastPathMaxSourceWidth(sF)<=10u && getFastPathTexelLayout(dF).size!=0u;
+        }
 
-        const uint8_t** src = reinterpret_cast<const uint8_t**>(srcPix);
-        uint8_t* const dst_begin = reinterpret_cast<uint8_t*>(dstPix);
-        for (size_t i = 0u; i < _pixOrBlockCnt; ++i)
+        //! Converts whole runs of texels with per channel lookup tables, which makes it exactly as precise as the generic per texel path
+        /** Every table maps a raw source channel value to its bits in the destination texel, the tables are filled by running convertColor on one channel at a time.
+        Channels the destination has but the source lacks are set to what 1 encodes to (opaque alpha).
+        If all the tables turn out to just move bytes around (swizzles, adding or dropping alpha) a pshufb does 4 texels at a time. */
+        template<asset::E_FORMAT sF, asset::E_FORMAT dF>
+        class CFastPathConverter
         {
-            // assuming _imgSize is always represented in texels
-            const uint32_t px = i % (_imgSize.X / sdims.X);
-            const uint32_t py = i / (_imgSize.X / sdims.X);
-            //px, py are block or texel position
-            //x, y are position within block
-            for (uint32_t x = 0u; x < sdims.X; ++x)
-            {
-                for (uint32_t y = 0u; y < sdims.Y; ++y)
+                static_assert(hasFastPath<sF,dF>(), "No fast path for this pair of formats");
+                _IRR_STATIC_INLINE_CONSTEXPR uint32_t LUTSize = 1u<<getFastPathMaxSourceWidth(sF);
+
+            public:
+                //! Tables are built on first use, thread-safely
+                static inline const CFastPathConverter& get()
+                {
+                    static const CFastPathConverter converter;
+                    return converter;
+                }
+
+                inline void convert(const uint8_t* _src, uint8_t* _dst, size_t _texelCount) const
                 {
-                    const ptrdiff_t off = ((sdims.Y * py + y)*_imgSize.X + px * sdims.X + x);
-                    convertColor<sF, dF>(reinterpret_cast<const void**>(src), dst_begin + static_cast<ptrdiff_t>(dstStride)*off, x, y);
+                    constexpr SFastPathTexelLayout srcLayout = getFastPathTexelLayout(sF);
+                    constexpr SFastPathTexelLayout dstLayout = getFastPathTexelLayout(dF);
+
+                    size_t i = 0u;
+#ifdef __IRR_COMPILE_WITH_X86_SIMD_
+                    if (shuffleOnly)
+                    for (; (_texelCount-i)*srcLayout.size>=16u && (_texelCount-i)*dstLayout.size>=16u; i+=4u)
+                    {
+                        const __m128i texels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(_src+i*srcLayout.size));
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(_dst+i*dstLayout.size),_mm_or_si128(_mm_shuffle_epi8(texels,shuffleMask),shuffleConstant));
+                    }
+#endif
+                    for (; i<_texelCount; i++)
+                    {
+                        const uint8_t* srcBytes = _src+i*srcLayout.size;
+                        uint32_t srcTexel;
+                        if (srcLayout.size==4u)
+                            memcpy(&srcTexel,srcBytes,4u);
+                        else // a 3 byte memcpy into a 4 byte variable would stall store forwarding
+                            srcTexel = srcBytes[0]|(uint32_t(srcBytes[1])<<8u)|(uint32_t(srcBytes[2])<<16u);
+                        const uint64_t dstTexel = constantBits|lookUp<0u>(srcTexel)|lookUp<1u>(srcTexel)|lookUp<2u>(srcTexel)|lookUp<3u>(srcTexel);
+                        memcpy(_dst+i*dstLayout.size,&dstTexel,dstLayout.size);
+                    }
                 }
+
+            private:
+                //! Separate template per channel so the shifts and masks become immediates
+                template<uint32_t ch>
+                inline uint64_t lookUp(uint32_t _srcTexel) const
+                {
+                    constexpr uint32_t srcWidth = getFastPathTexelLayout(sF).width[ch];
+                    constexpr uint32_t srcOffset = getFastPathTexelLayout(sF).offset[ch];
+                    if (!srcWidth || !getFastPathTexelLayout(dF).width[ch])
+                        return 0u;
+                    return lut[ch][(_srcTexel>>srcOffset)&((0x1u<<srcWidth)-1u)];
+                }
+
+                CFastPathConverter() : constantBits(0u), shuffleOnly(false)
+                {
+                    using namespace asset;
+                    constexpr SFastPathTexelLayout srcLayout = getFastPathTexelLayout(sF);
+                    constexpr SFastPathTexelLayout dstLayout = getFastPathTexelLayout(dF);
+
+                    bool bytesOnly = (srcLayout.size==3u||srcLayout.size==4u) && (dstLayout.size==3u||dstLayout.size==4u);
+                    for (uint32_t ch=0u; ch<4u; ch++)
+                    {
+                        if (!dstLayout.width[ch])
+                            continue;
+                        const uint64_t dstMask = ((0x1ull<<dstLayout.width[ch])-1ull)<<dstLayout.offset[ch];
+                        bytesOnly = bytesOnly && dstLayout.width[ch]==8u && (srcLayout.width[ch]==8u||srcLayout.width[ch]==0u);
+
+                        if (srcLayout.width[ch])
+                        {
+                            for (uint32_t value=0u; value<(0x1u<<srcLayout.width[ch]); value++)
+                            {
+                                // byte buffers because the encoders and decoders access texels through all sorts of types
+                                alignas(8) uint8_t srcTexel[8] = {};
+                                alignas(8) uint8_t dstTexel[8] = {};
+                                const uint32_t srcBits = value<<srcLayout.offset[ch];
+                                memcpy(srcTexel,&srcBits,sizeof(srcBits));
+                                const void* srcPix[4] = {srcTexel,nullptr,nullptr,nullptr};
+                                convertColor<sF,dF>(srcPix,dstTexel,0u,0u);
+                                uint64_t dstBits;
+                                memcpy(&dstBits,dstTexel,sizeof(dstBits));
+                                lut[ch][value] = dstBits&dstMask;
+                                bytesOnly = bytesOnly && lut[ch][value]==(uint64_t(value)<<dstLayout.offset[ch]);
+                            }
+                        }
+                        else
+                        {
+                            using encT = typename std::conditional<isIntegerFormat<dF>(),typename std::conditional<isSignedFormat<dF>(),int64_t,uint64_t>::type,double>::type;
+                            encT one[4] = {0,0,0,0};
+                            one[ch] = 1;
+                            alignas(8) uint8_t dstTexel[8] = {};
+                            SCallEncode<dF,encT>{}(dstTexel,one);
+                            uint64_t dstBits;
+                            memcpy(&dstBits,dstTexel,sizeof(dstBits));
+                            constantBits |= dstBits&dstMask;
+                        }
+                    }
+
+#ifdef __IRR_COMPILE_WITH_X86_SIMD_
+                    shuffleOnly = bytesOnly;
+                    if (!shuffleOnly)
+                        return;
+
+                    alignas(16) uint8_t mask[16];
+                    alignas(16) uint8_t constant[16];
+                    memset(mask,0x80,sizeof(mask));
+                    memset(constant,0,sizeof(constant));
+                    for (uint32_t texel=0u; texel<4u; texel++)
+                    for (uint32_t ch=0u; ch<4u; ch++)
+                    {
+                        if (!dstLayout.width[ch])
+                            continue;
+                        const uint32_t dstByte = texel*dstLayout.size+dstLayout.offset[ch]/8u;
+                        if (srcLayout.width[ch])
+                            mask[dstByte] = texel*srcLayout.size+srcLayout.offset[ch]/8u;
+                        else
+                            constant[dstByte] = (constantBits>>dstLayout.offset[ch])&0xffu;
+                    }
+                    shuffleMask = _mm_load_si128(reinterpret_cast<const __m128i*>(mask));
+                    shuffleConstant = _mm_load_si128(reinterpret_cast<const __m128i*>(constant));
+#endif
+                }
+
+                uint64_t lut[4][LUTSize];
+                uint64_t constantBits;
+                bool shuffleOnly;
+#ifdef __IRR_COMPILE_WITH_X86_SIMD_
+                __m128i shuffleMask;
+                __m128i shuffleConstant;
+#endif
+        };
+
+        //! Runs the fast path if there is one for the pair, @returns whether it did
+        template<asset::E_FORMAT sF, asset::E_FORMAT dF, bool available = hasFastPath<sF,dF>()>
+        struct SCallFastPath
+        {
+            inline bool operator()(const void* _srcPix[4], void* _dstPix, size_t _texelCount) { return false; }
+        };
+        template<asset::E_FORMAT sF, asset::E_FORMAT dF>
+        struct SCallFastPath<sF,dF,true>
+        {
+            inline bool operator()(const void* _srcPix[4], void* _dstPix, size_t _texelCount)
+            {
+                const uint8_t* src = reinterpret_cast<const uint8_t*>(_srcPix[0]);
+                CFastPathConverter<sF,dF>::get().convert(src,reinterpret_cast<uint8_t*>(_dstPix),_texelCount);
+                // same as the generic loop leaves it
+                _srcPix[0] = src+_texelCount*getFastPathTexelLayout(sF).size;
+                return true;
             }
-            if (!isPlanarFormat<sF>())
+        };
+
+        //! Converts the texels or blocks [_begin,_end) of the image, `srcPix` must already point at block `_begin` and is left past the last one converted
+        /** Planar sources are only supported with `_begin==0`, because their plane pointers are advanced incrementally. */
+        template<asset::E_FORMAT sF, asset::E_FORMAT dF>
+        inline void convertColorRange(const void* srcPix[4], void* dstPix, size_t _begin, size_t _end, const core::vector3d<uint32_t>& _imgSize)
+        {
+            using namespace asset;
+
+            const uint32_t srcStride = getTexelOrBlockSize(sF);
+            const uint32_t dstStride = getTexelOrBlockSize(dF);
+
+            uint8_t* const dst_begin = reinterpret_cast<uint8_t*>(dstPix);
+            // plain texels are laid out linearly in both images, so the whole run can go through the table driven converter
+            if (SCallFastPath<sF,dF>{}(srcPix,dst_begin+static_cast<ptrdiff_t>(dstStride)*_begin,_end-_begin))
+                return;
+
+            uint32_t hPlaneReduction[4], vPlaneReduction[4], chCntInPlane[4];
+            getHorizontalReductionFactorPerPlane(sF, hPlaneReduction);
+            getVerticalReductionFactorPerPlane(sF, vPlaneReduction);
+            getChannelsPerPlane(sF, chCntInPlane);
+
+            const core::vector3d<uint32_t> sdims = getBlockDimensions(sF);
+
+            const uint8_t** src = reinterpret_cast<const uint8_t**>(srcPix);
+            for (size_t i = _begin; i < _end; ++i)
             {
-                src[0] += srcStride;
+                // assuming _imgSize is always represented in texels
+                const uint32_t px = i % (_imgSize.X / sdims.X);
+                const uint32_t py = i / (_imgSize.X / sdims.X);
+                //px, py are block or texel position
+                //x, y are position within block
+                for (uint32_t x = 0u; x < sdims.X; ++x)
+                {
+                    for (uint32_t y = 0u; y < sdims.Y; ++y)
+                    {
+                        const ptrdiff_t off = ((sdims.Y * py + y)*_imgSize.X + px * sdims.X + x);
+                        convertColor<sF, dF>(reinterpret_cast<const void**>(src), dst_begin + static_cast<ptrdiff_t>(dstStride)*off, x, y);
+                    }
+                }
+                if (!isPlanarFormat<sF>())
+                {
+                    src[0] += srcStride;
+                }
+                else
+                {
+                    const uint32_t px = i % _imgSize.X;
+                    const uint32_t py = i / _imgSize.X;
+                    for (uint32_t j = 0u; j < 4u; ++j)
+                        src[j] = reinterpret_cast<const uint8_t*>(srcPix[j]) + chCntInPlane[j]*((_imgSize.X/hPlaneReduction[j]) * (py/vPlaneReduction[j]) + px/hPlaneReduction[j]);
+                }
             }
-            else
+        }
+
+        //! Smallest amount of texels worth handing to a separate thread
+        _IRR_STATIC_INLINE_CONSTEXPR size_t MinTexelsPerTile = 1u<<14;
+
+        //! Decodes into the format taken by compressBlocks and compresses the rows of blocks covered by the `_pixOrBlockCnt` source texels or blocks
+        void convertColorToBlocks(asset::E_FORMAT _sfmt, asset::E_FORMAT _dfmt, const void* _srcPix[4], void* _dstPix, size_t _pixOrBlockCnt, core::vector3d<uint32_t>& _imgSize, uint32_t _threadCount, E_BLOCK_COMPRESSION_QUALITY _quality);
+    } //namespace impl
+
+    //! Converts `_pixOrBlockCnt` texels (or blocks for block compressed `sF`) laid out row by row in an image `_imgSize` texels wide
+    /**
+    @param _threadCount With anything else than 1 the image is split into tiles of whole block rows which get converted concurrently by up to `_threadCount` threads (0 means getDefaultThreadCount()).
+    The output does not depend on the thread count, every tile writes only its own texels. Planar source formats are always converted on the calling thread.
+    @param _quality Only used when `dF` is block compressed (BC1 to BC5 and BC7). The image is then decoded to 8bit texels first and handed to compressBlocks, which writes whole rows of blocks.
+    */
+    template<asset::E_FORMAT sF, asset::E_FORMAT dF>
+    inline void convertColor(const void* srcPix[4], void* dstPix, size_t _pixOrBlockCnt, core::vector3d<uint32_t>& _imgSize, uint32_t _threadCount=1u, E_BLOCK_COMPRESSION_QUALITY _quality=EBCQ_NORMAL)
+    {
+        using namespace asset;
+
+        IRR_PSEUDO_IF_CONSTEXPR_BEGIN(isBlockCompressionFormat<dF>())
+        {
+            impl::convertColorToBlocks(sF,dF,srcPix,dstPix,_pixOrBlockCnt,_imgSize,_threadCount,_quality);
+        }
+        IRR_PSEUDO_ELSE_CONSTEXPR
+        {
+            const core::vector3d<uint32_t> sdims = getBlockDimensions(sF);
+            const size_t blocksPerRow = _imgSize.X / sdims.X;
+            if (_threadCount==1u || isPlanarFormat<sF>() || blocksPerRow==0u)
             {
-                const uint32_t px = i % _imgSize.X;
-                const uint32_t py = i / _imgSize.X;
-                for (uint32_t j = 0u; j < 4u; ++j)
-                    src[j] = reinterpret_cast<const uint8_t*>(srcPix[j]) + chCntInPlane[j]*((_imgSize.X/hPlaneReduction[j]) * (py/vPlaneReduction[j]) + px/hPlaneReduction[j]);
+                impl::convertColorRange<sF,dF>(srcPix,dstPix,0u,_pixOrBlockCnt,_imgSize);
+                return;
             }
+
+            const size_t srcStride = getTexelOrBlockSize(sF);
+            const size_t rowCount = (_pixOrBlockCnt+blocksPerRow-1u)/blocksPerRow;
+            const size_t minRowsPerTile = std::max<size_t>(impl::MinTexelsPerTile/(blocksPerRow*sdims.X*sdims.Y),1u);
+            const uint8_t* const srcBegin = reinterpret_cast<const uint8_t*>(srcPix[0]);
+            core::parallel_for<size_t>(0u,rowCount,[&](size_t _rowBegin, size_t _rowEnd)
+            {
+                const size_t begin = _rowBegin*blocksPerRow;
+                const size_t end = std::min(_rowEnd*blocksPerRow,_pixOrBlockCnt);
+                const void* tileSrc[4] = {srcBegin+begin*srcStride,srcPix[1],srcPix[2],srcPix[3]};
+                impl::convertColorRange<sF,dF>(tileSrc,dstPix,begin,end,_imgSize);
+            },_threadCount,minRowsPerTile);
+            // same as the serial loop leaves it
+            srcPix[0] = srcBegin+_pixOrBlockCnt*srcStride;
         }
+        IRR_PSEUDO_IF_CONSTEXPR_END
     }
 
-    void convertColor(asset::E_FORMAT _sfmt, asset::E_FORMAT _dfmt, const void* _srcPix[4], void* _dstPix, size_t _pixOrBlockCnt, core::vector3d<uint32_t>& _imgSize);
+    //! Runtime dispatch of the above, `_threadCount` and `_quality` have the same meaning
+    void convertColor(asset::E_FORMAT _sfmt, asset::E_FORMAT _dfmt, const void* _srcPix[4], void* _dstPix, size_t _pixOrBlockCnt, core::vector3d<uint32_t>& _imgSize, uint32_t _threadCount=1u, E_BLOCK_COMPRESSION_QUALITY _quality=EBCQ_NORMAL);
 }} //irr:video
 
 #ifdef __GNUC__
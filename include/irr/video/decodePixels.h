@@ -1161,33 +1161,40 @@ namespace irr { namespace video
 
             uint16_t r0, g0, b0, r1, g1, b1;
 
+            // BC1 endpoints have red in the most significant bits, B5G6R5 has it in the least significant ones
             const void* input = &col.c0;
             decodePixels<asset::EF_B5G6R5_UNORM_PACK16, uint64_t>(&input, p[0].c, 0u, 0u);
-            r0 = p[0].r;
+            r0 = p[0].b;
             g0 = p[0].g;
-            b0 = p[0].b;
+            b0 = p[0].r;
             input = &col.c1;
             decodePixels<asset::EF_B5G6R5_UNORM_PACK16, uint64_t>(&input, p[1].c, 0u, 0u);
-            r1 = p[1].r;
+            r1 = p[1].b;
             g1 = p[1].g;
-            b1 = p[1].b;
+            b1 = p[1].r;
+            p[0].r = r0;
+            p[0].b = b0;
+            p[0].a = 1;
+            p[1].r = r1;
+            p[1].b = b1;
+            p[1].a = 1;
             if (col.c0 > col.c1)
             {
                 p[2].r = (2 * r0 + 1 * r1) / 3;
                 p[2].g = (2 * g0 + 1 * g1) / 3;
                 p[2].b = (2 * b0 + 1 * b1) / 3;
-                p[2].a = 0xff;
+                p[2].a = 1;
                 p[3].r = (1 * r0 + 2 * r1) / 3;
                 p[3].g = (1 * g0 + 2 * g1) / 3;
                 p[3].b = (1 * b0 + 2 * b1) / 3;
-                p[3].a = 0xff;
+                p[3].a = 1;
             }
             else
             {
                 p[2].r = (r0 + r1) / 2;
                 p[2].g = (g0 + g1) / 2;
                 p[2].b = (b0 + b1) / 2;
-                p[2].a = 0xff;
+                p[2].a = 1;
                 p[3].r = 0;
                 p[3].g = 0;
                 p[3].b = 0;
@@ -1257,7 +1264,7 @@ namespace irr { namespace video
             else
             {
                 int lut = int(b.lut[3]) | int(b.lut[4] << 8) | int(b.lut[5] << 16);
-                int aw = 7 & (lut >> (3 * idx));
+                int aw = 7 & (lut >> (3 * (idx - 8u)));
                 _output[_offset] = a[aw];
             }
         }
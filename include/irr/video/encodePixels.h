@@ -6,6 +6,7 @@
 
 #include "coreutil.h"
 #include "irr/asset/EFormat.h"
+#include "compressBlocks.h"
 
 
 namespace irr { namespace video
@@ -2481,6 +2482,44 @@ namespace irr { namespace video
         pix |= exp;
     }
 	
+    // Block Compression formats
+    namespace impl
+    {
+        template<asset::E_FORMAT blockFmt, asset::E_FORMAT texelFmt>
+        inline void encodeBlock(void* _pix, const double* _input)
+        {
+            uint8_t texels[16][4] = {};
+            for (uint32_t i = 0u; i < 16u; ++i)
+                encodePixels<texelFmt, double>(texels[i], _input+4u*i);
+            compressBlock(blockFmt, texels, _pix, EBCQ_NORMAL);
+        }
+    }
+
+    //! Encodes a whole 4x4 block of a format compressBlocks supports (BC1 to BC5 and BC7), unlike encodePixels which takes a single texel
+    /** @param _input 16 texels row by row with 4 channels each, so 64 values.
+    @returns false if `_fmt` is not such a format. */
+    inline bool encodeBlock(asset::E_FORMAT _fmt, void* _pix, const double* _input)
+    {
+        switch (_fmt)
+        {
+        case asset::EF_BC1_RGB_UNORM_BLOCK: impl::encodeBlock<asset::EF_BC1_RGB_UNORM_BLOCK, asset::EF_R8G8B8A8_UNORM>(_pix, _input); return true;
+        case asset::EF_BC1_RGB_SRGB_BLOCK: impl::encodeBlock<asset::EF_BC1_RGB_SRGB_BLOCK, asset::EF_R8G8B8A8_SRGB>(_pix, _input); return true;
+        case asset::EF_BC1_RGBA_UNORM_BLOCK: impl::encodeBlock<asset::EF_BC1_RGBA_UNORM_BLOCK, asset::EF_R8G8B8A8_UNORM>(_pix, _input); return true;
+        case asset::EF_BC1_RGBA_SRGB_BLOCK: impl::encodeBlock<asset::EF_BC1_RGBA_SRGB_BLOCK, asset::EF_R8G8B8A8_SRGB>(_pix, _input); return true;
+        case asset::EF_BC2_UNORM_BLOCK: impl::encodeBlock<asset::EF_BC2_UNORM_BLOCK, asset::EF_R8G8B8A8_UNORM>(_pix, _input); return true;
+        case asset::EF_BC2_SRGB_BLOCK: impl::encodeBlock<asset::EF_BC2_SRGB_BLOCK, asset::EF_R8G8B8A8_SRGB>(_pix, _input); return true;
+        case asset::EF_BC3_UNORM_BLOCK: impl::encodeBlock<asset::EF_BC3_UNORM_BLOCK, asset::EF_R8G8B8A8_UNORM>(_pix, _input); return true;
+        case asset::EF_BC3_SRGB_BLOCK: impl::encodeBlock<asset::EF_BC3_SRGB_BLOCK, asset::EF_R8G8B8A8_SRGB>(_pix, _input); return true;
+        case asset::EF_BC4_UNORM_BLOCK: impl::encodeBlock<asset::EF_BC4_UNORM_BLOCK, asset::EF_R8G8B8A8_UNORM>(_pix, _input); return true;
+        case asset::EF_BC4_SNORM_BLOCK: impl::encodeBlock<asset::EF_BC4_SNORM_BLOCK, asset::EF_R8G8B8A8_SNORM>(_pix, _input); return true;
+        case asset::EF_BC5_UNORM_BLOCK: impl::encodeBlock<asset::EF_BC5_UNORM_BLOCK, asset::EF_R8G8B8A8_UNORM>(_pix, _input); return true;
+        case asset::EF_BC5_SNORM_BLOCK: impl::encodeBlock<asset::EF_BC5_SNORM_BLOCK, asset::EF_R8G8B8A8_SNORM>(_pix, _input); return true;
+        case asset::EF_BC7_UNORM_BLOCK: impl::encodeBlock<asset::EF_BC7_UNORM_BLOCK, asset::EF_R8G8B8A8_UNORM>(_pix, _input); return true;
+        case asset::EF_BC7_SRGB_BLOCK: impl::encodeBlock<asset::EF_BC7_SRGB_BLOCK, asset::EF_R8G8B8A8_SRGB>(_pix, _input); return true;
+        default: return false;
+        }
+    }
+
     template<typename T>
     inline bool encodePixels(asset::E_FORMAT _fmt, void* _pix, const T* _input);
 	
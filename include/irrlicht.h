@@ -37,6 +37,9 @@
 #include "irr/core/BaseClasses.h"
 #include "irr/core/irrString.h" //kill this abomination
 #include "irr/core/IThreadBound.h"
+#include "irr/core/flat_hash_map.h"
+#include "irr/core/flat_hash_multimap.h"
+#include "irr/core/parallel_for.h"
 #include "irr/core/Types.h"
 
 // core math
@@ -690,8 +690,8 @@ REALINLINE void CBurningShader_Raster_Reference::depthWrite ()
 REALINLINE void CBurningShader_Raster_Reference::scanline2()
 {
 	// apply top-left fill-convention, left
-	pShader.xStart = core::ceil32( line.x[0] );
-	pShader.xEnd = core::ceil32( line.x[1] ) - 1;
+	pShader.xStart = core::s32_max( core::ceil32( line.x[0] ), Scissor.UpperLeftCorner.X );
+	pShader.xEnd = core::s32_min( core::ceil32( line.x[1] ) - 1, Scissor.LowerRightCorner.X - 1 );
 
 	pShader.dx = pShader.xEnd - pShader.xStart;
 	if ( pShader.dx < 0 )
@@ -756,10 +756,10 @@ REALINLINE void CBurningShader_Raster_Reference::scanline ()
 
 	// apply top-left fill-convention, left
 	pShader.xStart = core::ceil32( line.x[0] );
-	pShader.xEnd = core::ceil32( line.x[1] ) - 1;
+	pShader.xEnd = core::s32_min( core::ceil32( line.x[1] ) - 1, Scissor.LowerRightCorner.X - 1 );
 
 	pShader.dx = pShader.xEnd - pShader.xStart;
-	if ( pShader.dx < 0 )
+	if ( pShader.dx < 0 || pShader.xEnd < Scissor.UpperLeftCorner.X )
 		return;
 
 	// slopes
@@ -776,6 +776,13 @@ REALINLINE void CBurningShader_Raster_Reference::scanline ()
 
 	pShader.i = 0;
 
+	// pixels left of the scissor are skipped with a single step of the depth
+	if ( pShader.xStart < Scissor.UpperLeftCorner.X )
+	{
+		pShader.i = Scissor.UpperLeftCorner.X - pShader.xStart;
+		a += b * (float) pShader.i;
+	}
+
 	if ( ShaderParam.RenderState [ BD3DRS_ZENABLE ] )
 	{
 		while ( a < pShader.z[pShader.i] )
@@ -922,7 +929,7 @@ void CBurningShader_Raster_Reference::drawTriangle ( const s4DVertex *a,const s4
 
 		// apply top-left fill convention, top part
 		yStart = core::ceil32( a->Pos.y );
-		yEnd = core::ceil32( b->Pos.y ) - 1;
+		yEnd = core::s32_min( core::ceil32( b->Pos.y ) - 1, Scissor.LowerRightCorner.Y - 1 );
 
 		subPixel = ( (float) yStart ) - a->Pos.y;
 
@@ -945,6 +952,30 @@ void CBurningShader_Raster_Reference::drawTriangle ( const s4DVertex *a,const s4
 			scan.t[i][1] += scan.slopeT[i][1] * subPixel;
 		}
 
+		// rows above the scissor are skipped with a single step of the edges
+		if ( yStart < Scissor.UpperLeftCorner.Y )
+		{
+			const float skip = (float) ( Scissor.UpperLeftCorner.Y - yStart );
+			scan.x[0] += scan.slopeX[0] * skip;
+			scan.x[1] += scan.slopeX[1] * skip;
+
+			scan.w[0] += scan.slopeW[0] * skip;
+			scan.w[1] += scan.slopeW[1] * skip;
+
+			for ( i = 0; i != ShaderParam.ColorUnits; ++i )
+			{
+				scan.c[i][0] += scan.slopeC[i][0] * skip;
+				scan.c[i][1] += scan.slopeC[i][1] * skip;
+			}
+
+			for ( i = 0; i != ShaderParam.TextureUnits; ++i )
+			{
+				scan.t[i][0] += scan.slopeT[i][0] * skip;
+				scan.t[i][1] += scan.slopeT[i][1] * skip;
+			}
+			yStart = Scissor.UpperLeftCorner.Y;
+		}
+
 		// rasterize the edge scanlines
 		for( line.y = yStart; line.y <= yEnd; ++line.y)
 		{
@@ -1036,7 +1067,7 @@ void CBurningShader_Raster_Reference::drawTriangle ( const s4DVertex *a,const s4
 
 		// apply top-left fill convention, top part
 		yStart = core::ceil32( b->Pos.y );
-		yEnd = core::ceil32( c->Pos.y ) - 1;
+		yEnd = core::s32_min( core::ceil32( c->Pos.y ) - 1, Scissor.LowerRightCorner.Y - 1 );
 
 
 		subPixel = ( (float) yStart ) - b->Pos.y;
@@ -1060,6 +1091,30 @@ void CBurningShader_Raster_Reference::drawTriangle ( const s4DVertex *a,const s4
 			scan.t[i][1] += scan.slopeT[i][1] * subPixel;
 		}
 
+		// rows above the scissor are skipped with a single step of the edges
+		if ( yStart < Scissor.UpperLeftCorner.Y )
+		{
+			const float skip = (float) ( Scissor.UpperLeftCorner.Y - yStart );
+			scan.x[0] += scan.slopeX[0] * skip;
+			scan.x[1] += scan.slopeX[1] * skip;
+
+			scan.w[0] += scan.slopeW[0] * skip;
+			scan.w[1] += scan.slopeW[1] * skip;
+
+			for ( i = 0; i != ShaderParam.TextureUnits; ++i )
+			{
+				scan.c[i][0] += scan.slopeC[i][0] * skip;
+				scan.c[i][1] += scan.slopeC[i][1] * skip;
+			}
+
+			for ( i = 0; i != ShaderParam.TextureUnits; ++i )
+			{
+				scan.t[i][0] += scan.slopeT[i][0] * skip;
+				scan.t[i][1] += scan.slopeT[i][1] * skip;
+			}
+			yStart = Scissor.UpperLeftCorner.Y;
+		}
+
 		// rasterize the edge scanlines
 		for( line.y = yStart; line.y <= yEnd; ++line.y)
 		{
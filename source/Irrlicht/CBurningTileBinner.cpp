@@ -0,0 +1,169 @@
+#include "IrrCompileConfig.h"
+#ifdef _IRR_COMPILE_WITH_BURNINGSVIDEO_
+
+#include "CBurningTileBinner.h"
+#include <atomic>
+#include <algorithm>
+#include <condition_variable>
+
+namespace irr
+{
+namespace video
+{
+
+CBurningTileBinner::CBurningTileBinner(CBurningVideoDriver* driver)
+	: IBurningShader(driver), TilesX(0u), TilesY(0u)
+{
+	#ifdef _IRR_DEBUG
+	setDebugName("CBurningTileBinner");
+	#endif
+}
+
+
+void CBurningTileBinner::setRenderTarget(video::IImage* surface, const core::rect<int32_t>& viewPort)
+{
+	_IRR_DEBUG_BREAK_IF(!Triangles.empty());
+	IBurningShader::setRenderTarget(surface, viewPort);
+
+	const int32_t tileMask = (1<<TileSizeLog2)-1;
+	TilesX = (core::s32_max(Scissor.getWidth(),0)+tileMask)>>TileSizeLog2;
+	TilesY = (core::s32_max(Scissor.getHeight(),0)+tileMask)>>TileSizeLog2;
+	Bins.resize(TilesX*TilesY);
+}
+
+
+void CBurningTileBinner::drawTriangle ( const s4DVertex *a,const s4DVertex *b,const s4DVertex *c )
+{
+	// same rows and columns as the top-left fill convention of the shaders would cover
+	const int32_t xStart = core::s32_max( core::ceil32( core::min_( a->Pos.x, b->Pos.x, c->Pos.x ) ), Scissor.UpperLeftCorner.X );
+	const int32_t xEnd = core::s32_min( core::ceil32( core::max_( a->Pos.x, b->Pos.x, c->Pos.x ) ) - 1, Scissor.LowerRightCorner.X - 1 );
+	const int32_t yStart = core::s32_max( core::ceil32( core::min_( a->Pos.y, b->Pos.y, c->Pos.y ) ), Scissor.UpperLeftCorner.Y );
+	const int32_t yEnd = core::s32_min( core::ceil32( core::max_( a->Pos.y, b->Pos.y, c->Pos.y ) ) - 1, Scissor.LowerRightCorner.Y - 1 );
+	if ( xStart > xEnd || yStart > yEnd )
+		return;
+
+	const uint32_t index = static_cast<uint32_t>(Triangles.size());
+	Triangles.emplace_back();
+	STriangle& triangle = Triangles.back();
+	triangle.Vertex[0] = *a;
+	triangle.Vertex[1] = *b;
+	triangle.Vertex[2] = *c;
+	for ( uint32_t i = 0; i != BURNING_MATERIAL_MAX_TEXTURES; ++i )
+		triangle.Texture[i] = IT[i];
+
+	const uint32_t tileXStart = (xStart-Scissor.UpperLeftCorner.X)>>TileSizeLog2;
+	const uint32_t tileXEnd = (xEnd-Scissor.UpperLeftCorner.X)>>TileSizeLog2;
+	const uint32_t tileYStart = (yStart-Scissor.UpperLeftCorner.Y)>>TileSizeLog2;
+	const uint32_t tileYEnd = (yEnd-Scissor.UpperLeftCorner.Y)>>TileSizeLog2;
+	for ( uint32_t y = tileYStart; y <= tileYEnd; ++y )
+	for ( uint32_t x = tileXStart; x <= tileXEnd; ++x )
+	{
+		const uint32_t tile = y*TilesX+x;
+		if ( Bins[tile].empty() )
+			BinnedTiles.push_back(tile);
+		Bins[tile].push_back(index);
+	}
+}
+
+
+void CBurningTileBinner::flush(IBurningShader* const* shaders, uint32_t shaderCount, core::CThreadPool* pool)
+{
+	if ( Triangles.empty() )
+		return;
+
+	if ( shaderCount <= 1u )
+	{
+		IBurningShader* shader = shaders[0];
+		shader->setScissor(Scissor);
+		const STriangle* previous = nullptr;
+		for ( const auto& triangle : Triangles )
+		{
+			drawBinned(shader, triangle, previous);
+			previous = &triangle;
+		}
+		discard();
+		return;
+	}
+
+	// busiest tiles first, so that no worker starts on a big one when the others are running out of work
+	std::sort(BinnedTiles.begin(),BinnedTiles.end(),[this](uint32_t lhs, uint32_t rhs) {return Bins[lhs].size()>Bins[rhs].size();});
+
+	std::atomic<uint32_t> nextTile(0u);
+	const uint32_t tileCount = static_cast<uint32_t>(BinnedTiles.size());
+	auto work = [&](uint32_t worker)
+	{
+		uint32_t tile;
+		while ((tile=nextTile.fetch_add(1u,std::memory_order_relaxed))<tileCount)
+			drawTile(shaders[worker],BinnedTiles[tile]);
+		shaders[worker]->setScissor(Scissor);
+	};
+
+	// the calling thread is worker 0, the pool's workers pull tiles as the others
+	_IRR_DEBUG_BREAK_IF(!pool);
+	core::mutex doneMutex;
+	std::condition_variable done;
+	uint32_t pendingWorkers = shaderCount-1u;
+	for (uint32_t worker=1u; worker<shaderCount; worker++)
+	{
+		pool->enqueue([&,worker]()
+		{
+			work(worker);
+			// notified under the lock, since the waiting thread destroys `done` as soon as it sees the count drop to 0
+			std::lock_guard<core::mutex> lock(doneMutex);
+			if (--pendingWorkers==0u)
+				done.notify_one();
+		});
+	}
+	work(0u);
+	{
+		std::unique_lock<core::mutex> lock(doneMutex);
+		done.wait(lock,[&pendingWorkers]() {return pendingWorkers==0u;});
+	}
+
+	discard();
+}
+
+
+void CBurningTileBinner::discard()
+{
+	for ( auto tile : BinnedTiles )
+		Bins[tile].clear();
+	BinnedTiles.clear();
+	Triangles.clear();
+}
+
+
+void CBurningTileBinner::drawBinned(IBurningShader* shader, const STriangle& triangle, const STriangle* previous)
+{
+	for ( uint32_t i = 0; i != BURNING_MATERIAL_MAX_TEXTURES; ++i )
+	{
+		const sInternalTexture& texture = triangle.Texture[i];
+		if ( !previous || previous->Texture[i].Texture != texture.Texture || previous->Texture[i].data != texture.data )
+			shader->setTextureParam(i, texture);
+	}
+
+	shader->drawTriangle(triangle.Vertex + 0, triangle.Vertex + 1, triangle.Vertex + 2);
+}
+
+
+void CBurningTileBinner::drawTile(IBurningShader* shader, uint32_t tile) const
+{
+	const int32_t x = Scissor.UpperLeftCorner.X+int32_t((tile%TilesX)<<TileSizeLog2);
+	const int32_t y = Scissor.UpperLeftCorner.Y+int32_t((tile/TilesX)<<TileSizeLog2);
+	core::rect<int32_t> scissor(x, y, x+(1<<TileSizeLog2), y+(1<<TileSizeLog2));
+	scissor.clipAgainst(Scissor);
+	shader->setScissor(scissor);
+
+	const STriangle* previous = nullptr;
+	for ( auto index : Bins[tile] )
+	{
+		drawBinned(shader, Triangles[index], previous);
+		previous = &Triangles[index];
+	}
+}
+
+
+} // end namespace video
+} // end namespace irr
+
+#endif // _IRR_COMPILE_WITH_BURNINGSVIDEO_
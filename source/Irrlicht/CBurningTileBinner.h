@@ -0,0 +1,77 @@
+#ifndef __C_BURNING_TILE_BINNER_H_INCLUDED__
+#define __C_BURNING_TILE_BINNER_H_INCLUDED__
+
+#include "IBurningShader.h"
+#include "irr/core/CThreadPool.h"
+
+namespace irr
+{
+namespace video
+{
+
+	/*!
+		Front end which lets several threads rasterize for the software driver.
+		Triangles handed to drawTriangle have been clipped and projected already, they get stored
+		and sorted into every screen tile their bounding box touches. flush then gives each worker thread
+		a shader of its own and hands out whole tiles, with the shader's scissor set to the tile.
+		Every pixel belongs to exactly one tile and the triangles of a tile are drawn in submission order,
+		so the image does not depend on how many workers there are. It can differ from the single threaded one
+		by rounding, as the shaders jump their interpolators to the scissor edge instead of stepping there.
+	*/
+	class CBurningTileBinner : public IBurningShader
+	{
+	public:
+		_IRR_STATIC_INLINE_CONSTEXPR int32_t TileSizeLog2 = 6;
+		//! below this many triangles starting the workers costs more than it saves
+		_IRR_STATIC_INLINE_CONSTEXPR uint32_t MinParallelTriangles = 64u;
+
+		CBurningTileBinner(CBurningVideoDriver* driver);
+
+		//! lays the tile grid over the viewport, nothing may be binned at that point
+		virtual void setRenderTarget(video::IImage* surface, const core::rect<int32_t>& viewPort) override;
+
+		//! stores a copy of the triangle together with the texture state from the last setTextureParam calls
+		virtual void drawTriangle ( const s4DVertex *a,const s4DVertex *b,const s4DVertex *c ) override;
+
+		uint32_t getTriangleCount() const { return static_cast<uint32_t>(Triangles.size()); }
+
+		//! rasterizes everything binned so far and empties the bins
+		/**
+		@param shaders One per worker thread, all of them set up like the shader the triangles are meant for.
+		With a single shader the triangles are drawn on the calling thread in submission order without going through the tiles.
+		@param pool Runs the workers besides the calling thread, needs at least shaderCount-1 threads to keep them all busy.
+		*/
+		void flush(IBurningShader* const* shaders, uint32_t shaderCount, core::CThreadPool* pool = 0);
+
+		//! empties the bins without drawing anything
+		void discard();
+
+	protected:
+		virtual ~CBurningTileBinner() {}
+
+	private:
+		struct STriangle
+		{
+			s4DVertex Vertex[3];
+			//! the textures are kept alive by IT, they only change together with the material which flushes first
+			sInternalTexture Texture[BURNING_MATERIAL_MAX_TEXTURES];
+		};
+
+		//! draws one triangle with `shader`, texture state only gets passed on when it differs from `previous`
+		static void drawBinned(IBurningShader* shader, const STriangle& triangle, const STriangle* previous);
+
+		void drawTile(IBurningShader* shader, uint32_t tile) const;
+
+		core::vector<STriangle> Triangles;
+		//! indices of the triangles touching each tile, in submission order
+		core::vector<core::vector<uint32_t> > Bins;
+		//! tiles with a non empty bin
+		core::vector<uint32_t> BinnedTiles;
+		uint32_t TilesX;
+		uint32_t TilesY;
+	};
+
+} // end namespace video
+} // end namespace irr
+
+#endif
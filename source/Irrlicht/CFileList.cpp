@@ -34,6 +34,13 @@ CFileList::~CFileList()
 
 //! adds a file or folder
 void CFileList::addItem(const io::path& fullPath, uint32_t offset, uint32_t size, bool isDirectory, uint32_t id)
+{
+	SFileListEntry entry = createEntry(fullPath, offset, size, isDirectory, id);
+
+	Files.insert(std::lower_bound(Files.begin(),Files.end(),entry),entry);
+}
+
+SFileListEntry CFileList::createEntry(const io::path& fullPath, uint32_t offset, uint32_t size, bool isDirectory, uint32_t id) const
 {
 	SFileListEntry entry;
 	entry.ID   = id ? id : Files.size();
@@ -63,35 +70,43 @@ void CFileList::addItem(const io::path& fullPath, uint32_t offset, uint32_t size
 
 	//os::Printer::log(Path.c_str(), entry.FullName);
 
-	Files.insert(std::lower_bound(Files.begin(),Files.end(),entry),entry);
+	return entry;
 }
 
-
-
-//! Searches for a file or folder within the list, returns the index
-IFileList::ListCIterator CFileList::findFile(IFileList::ListCIterator _begin, IFileList::ListCIterator _end, const io::path& filename, bool isDirectory) const
+void CFileList::sortFiles()
 {
-    SFileListEntry entry;
-    // we only need FullName to be set for the search
-    entry.FullName = filename;
-    entry.IsDirectory = isDirectory;
+	std::stable_sort(Files.begin(),Files.end());
+}
 
+void CFileList::normalizeFileName(io::path& filename, bool& isDirectory) const
+{
     // exchange
-    handleBackslashes(&entry.FullName);
+    handleBackslashes(&filename);
 
     // remove trailing slash
-    if (entry.FullName.lastChar() == '/')
+    if (filename.lastChar() == '/')
     {
-        entry.IsDirectory = true;
-        entry.FullName[entry.FullName.size()-1] = 0;
-        entry.FullName.validate();
+        isDirectory = true;
+        filename[filename.size()-1] = 0;
+        filename.validate();
     }
 
     if (IgnoreCase)
-        entry.FullName.make_lower();
+        filename.make_lower();
 
     if (IgnorePaths)
-        core::deletePathFromFilename(entry.FullName);
+        core::deletePathFromFilename(filename);
+}
+
+
+//! Searches for a file or folder within the list, returns the index
+IFileList::ListCIterator CFileList::findFile(IFileList::ListCIterator _begin, IFileList::ListCIterator _end, const io::path& filename, bool isDirectory) const
+{
+    SFileListEntry entry;
+    // we only need FullName to be set for the search
+    entry.FullName = filename;
+    entry.IsDirectory = isDirectory;
+    normalizeFileName(entry.FullName,entry.IsDirectory);
 
     auto retval = std::lower_bound(_begin,_end,entry);
     if (retval!=_end && entry<*retval)
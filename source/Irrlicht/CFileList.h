@@ -49,6 +49,16 @@ class CFileList : public IFileList
         virtual const io::path& getPath() const {return Path;}
 
     protected:
+        //! Builds the entry addItem would add, without adding it
+        /** Archives with many files should push_back these and call sortFiles() once instead of calling addItem for each. */
+        SFileListEntry createEntry(const io::path& fullPath, uint32_t offset, uint32_t size, bool isDirectory, uint32_t id) const;
+
+        //! Restores the order findFile relies on after entries were appended to Files directly, equal entries keep their order
+        void sortFiles();
+
+        //! Converts `filename` to the form FullName has in the list, sets `isDirectory` if it had a trailing slash
+        void normalizeFileName(io::path& filename, bool& isDirectory) const;
+
         //! Ignore paths when adding or searching for files
         bool IgnorePaths;
 
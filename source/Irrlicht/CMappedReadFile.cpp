@@ -0,0 +1,130 @@
+#include "IrrCompileConfig.h"
+#include "CMappedReadFile.h"
+
+#include <string.h>
+
+#if defined(_IRR_WINDOWS_API_)
+	#define WIN32_LEAN_AND_MEAN
+	#include <windows.h>
+#elif defined(_IRR_POSIX_API_) || defined(_IRR_OSX_PLATFORM_)
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+namespace irr
+{
+namespace io
+{
+
+
+CMappedReadFile::CMappedReadFile(const io::path& fileName)
+: Mapping(nullptr), FileSize(0), Pos(0), Filename(fileName)
+{
+	#ifdef _IRR_DEBUG
+	setDebugName("CMappedReadFile");
+	#endif
+
+	openFile();
+}
+
+
+CMappedReadFile::~CMappedReadFile()
+{
+	if (!Mapping)
+		return;
+
+#if defined(_IRR_WINDOWS_API_)
+	UnmapViewOfFile(Mapping);
+#elif defined(_IRR_POSIX_API_) || defined(_IRR_OSX_PLATFORM_)
+	munmap(Mapping, FileSize);
+#endif
+}
+
+
+//! returns how much was read
+int32_t CMappedReadFile::read(void* buffer, uint32_t sizeToRead)
+{
+	if (!isOpen() || Pos >= FileSize)
+		return 0;
+
+	const size_t amount = core::min_<size_t>(sizeToRead, FileSize-Pos);
+	memcpy(buffer, reinterpret_cast<const uint8_t*>(Mapping)+Pos, amount);
+	Pos += amount;
+
+	return static_cast<int32_t>(amount);
+}
+
+
+//! changes position in file, returns true if successful
+//! if relativeMovement==true, the pos is changed relative to current pos,
+//! otherwise from begin of file
+bool CMappedReadFile::seek(const size_t& finalPos, bool relativeMovement)
+{
+	if (!isOpen())
+		return false;
+
+	const size_t newPos = relativeMovement ? Pos+finalPos : finalPos;
+	if (newPos > FileSize)
+		return false;
+
+	Pos = newPos;
+	return true;
+}
+
+
+//! opens and maps the file
+void CMappedReadFile::openFile()
+{
+	if (Filename.size() == 0)
+		return;
+
+#if defined(_IRR_WINDOWS_API_)
+	#if defined(_IRR_WCHAR_FILESYSTEM)
+	HANDLE file = CreateFileW(Filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	#else
+	HANDLE file = CreateFileA(Filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	#endif
+	if (file == INVALID_HANDLE_VALUE)
+		return;
+
+	LARGE_INTEGER size;
+	if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+	{
+		// the view keeps its own reference to the mapping object, and the mapping object to the file
+		HANDLE mappingObj = CreateFileMapping(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+		if (mappingObj)
+		{
+			Mapping = MapViewOfFile(mappingObj, FILE_MAP_COPY, 0, 0, 0);
+			if (Mapping)
+				FileSize = static_cast<size_t>(size.QuadPart);
+			CloseHandle(mappingObj);
+		}
+	}
+	CloseHandle(file);
+#elif defined(_IRR_POSIX_API_) || defined(_IRR_OSX_PLATFORM_)
+	const int fd = open(Filename.c_str(), O_RDONLY);
+	if (fd < 0)
+		return;
+
+	struct stat st;
+	if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0)
+	{
+		// private mapping, so that anyone writing through an aliasing buffer only ever touches their own copy of the page
+		void* ptr = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ|PROT_WRITE, MAP_PRIVATE, fd, 0);
+		if (ptr != MAP_FAILED)
+		{
+			Mapping = ptr;
+			FileSize = static_cast<size_t>(st.st_size);
+		}
+	}
+	// the mapping stays valid after the descriptor is closed
+	close(fd);
+#endif
+}
+
+
+} // end namespace io
+} // end namespace irr
+
@@ -0,0 +1,111 @@
+#ifndef __C_MAPPED_READ_FILE_H_INCLUDED__
+#define __C_MAPPED_READ_FILE_H_INCLUDED__
+
+#include "IReadFile.h"
+#include "irr/core/irrString.h"
+#include "irr/core/alloc/AllocatorTrivialBases.h"
+
+namespace irr
+{
+
+namespace io
+{
+
+	/*!
+		Class for reading a real file from disk through a memory mapping of the whole file.
+		Pages are only brought in when touched and the mapping is private (copy-on-write),
+		so memory handed out through getMappedPointer() can be aliased by assets without copying.
+	*/
+	class CMappedReadFile : public IReadFile
+	{
+        protected:
+            virtual ~CMappedReadFile();
+
+        public:
+            CMappedReadFile(const io::path& fileName);
+
+            //! returns how much was read
+            virtual int32_t read(void* buffer, uint32_t sizeToRead) override;
+
+            //! changes position in file, returns true if successful
+            virtual bool seek(const size_t& finalPos, bool relativeMovement = false) override;
+
+            //! returns size of file
+            virtual size_t getSize() const override { return FileSize; }
+
+            //! returns if file is open and mapped
+            virtual bool isOpen() const
+            {
+                return Mapping != nullptr;
+            }
+
+            //! returns where in the file we are.
+            virtual size_t getPos() const override { return Pos; }
+
+            //! returns name of file
+            virtual const io::path& getFileName() const override { return Filename; }
+
+            //! returns the beginning of the mapping
+            virtual const void* getMappedPointer() const override { return Mapping; }
+
+        private:
+
+            //! opens and maps the file
+            void openFile();
+
+            void* Mapping;
+            size_t FileSize;
+            size_t Pos;
+            io::path Filename;
+	};
+
+	//! Allocator for asset::CCustomAllocatorCPUBuffer aliasing the memory of a mapped file, keeps the file grabbed until the memory is deallocated.
+	/** It cannot allocate, so only construct the buffer with core::adopt_memory and a pointer into getMappedPointer(). */
+	template<typename T>
+	class CMappedFileAllocator : public core::AllocatorTrivialBase<T>
+	{
+        public:
+            typedef size_t      size_type;
+
+            template<class U> struct rebind { typedef CMappedFileAllocator<U> other; };
+
+            explicit CMappedFileAllocator(const IReadFile* _file) : File(_file)
+            {
+                File->grab();
+            }
+            CMappedFileAllocator(const CMappedFileAllocator& other) : File(other.File)
+            {
+                if (File)
+                    File->grab();
+            }
+            CMappedFileAllocator(CMappedFileAllocator&& other) : File(other.File)
+            {
+                other.File = nullptr;
+            }
+            ~CMappedFileAllocator()
+            {
+                if (File)
+                    File->drop();
+            }
+
+            inline typename CMappedFileAllocator::pointer allocate(size_type n, typename CMappedFileAllocator::const_void_pointer hint=nullptr) noexcept
+            {
+                return nullptr;
+            }
+            //! the memory is the file's, so all that happens is letting go of the file
+            inline void deallocate(typename CMappedFileAllocator::pointer p, size_type n) noexcept
+            {
+                if (File)
+                    File->drop();
+                File = nullptr;
+            }
+
+        private:
+            const IReadFile* File;
+	};
+
+} // end namespace io
+} // end namespace irr
+
+#endif
+
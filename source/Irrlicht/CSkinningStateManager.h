@@ -5,6 +5,7 @@
 #include "ISkinningStateManager.h"
 #include "ITextureBufferObject.h"
 #include "IVideoDriver.h"
+#include "irr/core/parallel_for.h"
 
 ///#define UPDATE_WHOLE_BUFFER
 
@@ -16,6 +17,9 @@ namespace scene
 
     class CSkinningStateManager : public ISkinningStateManager
     {
+            //! smallest amount of instances worth giving a thread in performBoning
+            _IRR_STATIC_INLINE_CONSTEXPR uint32_t MinInstancesPerThread = 32u;
+
             video::IVideoDriver* Driver;
 #ifdef _IRR_COMPILE_WITH_OPENGL_
             video::ITextureBufferObject* TBO;
@@ -86,6 +90,7 @@ namespace scene
                 tmp->refCount = 1;
                 tmp->frame = 0.f;
                 tmp->interpolateAnimation = true;
+                tmp->keyframeCursor = 0u;
                 tmp->attachedNode = attachedNode;
                 if (boneControlMode!=EBUM_CONTROL)
                 {
@@ -217,7 +222,7 @@ namespace scene
 
 
                 float interpolationFactor;
-                size_t foundKeyIx = referenceHierarchy->getLowerBoundBoneKeyframes(interpolationFactor,currentInstance->frame);
+                size_t foundKeyIx = referenceHierarchy->getLowerBoundBoneKeyframes(interpolationFactor,currentInstance->frame,currentInstance->keyframeCursor);
                 float interpolantPrecalcTerm2,interpolantPrecalcTerm3;
                 core::quaternion::flerp_interpolant_terms(interpolantPrecalcTerm2,interpolantPrecalcTerm3,interpolationFactor);
 
@@ -279,6 +284,101 @@ namespace scene
                 }
             }
 
+            //! Brings all bones of an instance not animated yet to the instance's current frame, @returns whether any bone had to be updated
+            /** Goes through the hierarchy level by level, bones of a level only depend on bones from the levels above so SoABatchSize of them are interpolated at once.
+            Only touches the instance's own data and bone scene nodes, so different instances can be animated in parallel. */
+            inline bool animateInstance(BoneHierarchyInstanceData* currentInstance, FinalBoneData* boneDataForInstance)
+            {
+                core::matrix4x3 attachedNodeTform;
+                if (currentInstance->attachedNode)
+                    attachedNodeTform = currentInstance->attachedNode->getAbsoluteTransformation();
+
+                float interpolationFactor;
+                size_t foundKeyIx = referenceHierarchy->getLowerBoundBoneKeyframes(interpolationFactor,currentInstance->frame,currentInstance->keyframeCursor);
+                float interpolantPrecalcTerm2,interpolantPrecalcTerm3;
+                const float* upperFrame = referenceHierarchy->getSoAAnimationData(foundKeyIx,currentInstance->interpolateAnimation);
+                const float* lowerFrame = upperFrame;
+                if (currentInstance->interpolateAnimation&&interpolationFactor<1.f)
+                {
+                    lowerFrame = referenceHierarchy->getSoAAnimationData(foundKeyIx-1,true);
+                    core::quaternion::flerp_interpolant_terms(interpolantPrecalcTerm2,interpolantPrecalcTerm3,interpolationFactor);
+                }
+                else // same as getMatrixFromKey
+                {
+                    interpolationFactor = 1.f;
+                    interpolantPrecalcTerm2 = 0.25f;
+                    interpolantPrecalcTerm3 = 0.f;
+                }
+
+                core::matrix4x3* globalMatrices = getGlobalMatrices(currentInstance);
+                IBoneSceneNode** bones = boneControlMode==EBUM_READ ? getBones(currentInstance):nullptr;
+                const CFinalBoneHierarchy::BoneReferenceData* referenceBoneData = referenceHierarchy->getBoneData();
+                bool modified = false;
+                for (size_t level=0; level<referenceHierarchy->getHierarchyLevels(); level++)
+                {
+                    const size_t levelEnd = referenceHierarchy->getBoneLevelRangeEnd(level);
+                    for (size_t batchStart=referenceHierarchy->getBoneLevelRangeStart(level); batchStart<levelEnd; batchStart+=CFinalBoneHierarchy::SoABatchSize)
+                    {
+                        core::matrix3x4SIMD interpolatedLocalTforms[CFinalBoneHierarchy::SoABatchSize];
+                        CFinalBoneHierarchy::getMatricesFromKeys(interpolatedLocalTforms,lowerFrame,upperFrame,referenceHierarchy->getSoARowPitch(),batchStart,
+                                                                 interpolationFactor,interpolantPrecalcTerm2,interpolantPrecalcTerm3);
+
+                        const size_t batchEnd = std::min(batchStart+CFinalBoneHierarchy::SoABatchSize,levelEnd);
+                        for (size_t j=batchStart; j<batchEnd; j++)
+                        {
+                            if (boneDataForInstance[j].lastAnimatedFrame==currentInstance->frame)
+                                continue;
+                            modified = true;
+                            boneDataForInstance[j].lastAnimatedFrame = currentInstance->frame;
+
+                            const core::matrix3x4SIMD& interpolatedLocalTform = interpolatedLocalTforms[j-batchStart];
+                            if (level==0)
+                                globalMatrices[j] = interpolatedLocalTform.getAsRetardedIrrlichtMatrix();
+                            else
+                            {
+                                const core::matrix4x3& parentTform = globalMatrices[referenceBoneData[j].parentOffsetFromTop];
+                                globalMatrices[j] = core::matrix3x4SIMD::concatenateBFollowedByA(core::matrix3x4SIMD().set(parentTform), interpolatedLocalTform).getAsRetardedIrrlichtMatrix();
+                            }
+                            boneDataForInstance[j].SkinningTransform = core::matrix3x4SIMD::concatenateBFollowedByA(core::matrix3x4SIMD().set(globalMatrices[j]), core::matrix3x4SIMD().set(referenceBoneData[j].PoseBindMatrix)).getAsRetardedIrrlichtMatrix();
+
+
+                            core::aabbox3df bbox;
+                            bbox.MinEdge.X = referenceBoneData[j].MinBBoxEdge[0];
+                            bbox.MinEdge.Y = referenceBoneData[j].MinBBoxEdge[1];
+                            bbox.MinEdge.Z = referenceBoneData[j].MinBBoxEdge[2];
+                            bbox.MaxEdge.X = referenceBoneData[j].MaxBBoxEdge[0];
+                            bbox.MaxEdge.Y = referenceBoneData[j].MaxBBoxEdge[1];
+                            bbox.MaxEdge.Z = referenceBoneData[j].MaxBBoxEdge[2];
+                            bbox = core::transformBoxEx(bbox, core::matrix3x4SIMD().set(boneDataForInstance[j].SkinningTransform));
+                            //
+                            if (bones)
+                            {
+                                IBoneSceneNode* bone = bones[j];
+                                if (bone)
+                                {
+                                    if (bone->getSkinningSpace() != IBoneSceneNode::EBSS_LOCAL)
+                                        bone->setRelativeTransformationMatrix(core::matrix3x4SIMD::concatenateBFollowedByA(core::matrix3x4SIMD().set(attachedNodeTform), core::matrix3x4SIMD().set(globalMatrices[j])).getAsRetardedIrrlichtMatrix());
+                                    else
+                                    {
+                                        bone->setRelativeTransformationMatrix(interpolatedLocalTform.getAsRetardedIrrlichtMatrix());
+                                        bone->updateAbsolutePosition();
+                                    }
+                                }
+                            }
+
+                            boneDataForInstance[j].MinBBoxEdge[0] = bbox.MinEdge.X;
+                            boneDataForInstance[j].MinBBoxEdge[1] = bbox.MinEdge.Y;
+                            boneDataForInstance[j].MinBBoxEdge[2] = bbox.MinEdge.Z;
+                            boneDataForInstance[j].MaxBBoxEdge[0] = bbox.MaxEdge.X;
+                            boneDataForInstance[j].MaxBBoxEdge[1] = bbox.MaxEdge.Y;
+                            boneDataForInstance[j].MaxBBoxEdge[2] = bbox.MaxEdge.Z;
+                            boneDataForInstance[j].SkinningTransform.getSub3x3InverseTranspose(boneDataForInstance[j].SkinningNormalMatrix);
+                        }
+                    }
+                }
+                return modified;
+            }
+
             inline void TrySwapBoneBuffer()
             {
                 instanceBoneDataAllocator->pushBuffer(Driver->getDefaultUpStreamingBuffer());
@@ -307,138 +407,100 @@ namespace scene
                         case EBUM_READ:
                             {
                                 uint8_t* boneData = reinterpret_cast<uint8_t*>(instanceBoneDataAllocator->getBackBufferPointer());
+                                const auto& addressAllocator = instanceBoneDataAllocator->getAddressAllocator();
+                                const uint32_t firstInstanceAddr = addressAllocator.get_align_offset();
+                                const uint32_t instanceSlots = (addressAllocator.get_total_size()-firstInstanceAddr+instanceFinalBoneDataSize-1u)/instanceFinalBoneDataSize;
+
+                                // every thread tracks the dirty range of its own instances, the ranges get merged at the end
+                                core::mutex dirtyRangeMutex;
                                 bool notModified = true;
                                 uint32_t localFirstDirtyInstance,localLastDirtyInstance;
-                                for (size_t i=instanceBoneDataAllocator->getAddressAllocator().get_align_offset(); i<instanceBoneDataAllocator->getAddressAllocator().get_total_size(); i+=instanceFinalBoneDataSize)
+                                core::parallel_for<uint32_t>(0u,instanceSlots,[&](uint32_t slotBegin, uint32_t slotEnd)
                                 {
-                                    BoneHierarchyInstanceData* currentInstance = getBoneHierarchyInstanceFromAddr(i);
-                                    if (!currentInstance->refCount || currentInstance->frame==currentInstance->lastAnimatedFrame) //in other modes, check if also has no bones!!!
-                                        continue;
-
-                                    core::matrix4x3 attachedNodeTform;
-                                    if (currentInstance->attachedNode)
-                                        attachedNodeTform = currentInstance->attachedNode->getAbsoluteTransformation();
-
-
-                                    float interpolationFactor;
-                                    size_t foundKeyIx = referenceHierarchy->getLowerBoundBoneKeyframes(interpolationFactor,currentInstance->frame);
-                                    float interpolantPrecalcTerm2,interpolantPrecalcTerm3;
-                                    core::quaternion::flerp_interpolant_terms(interpolantPrecalcTerm2,interpolantPrecalcTerm3,interpolationFactor);
-
-
-                                    FinalBoneData* boneDataForInstance = reinterpret_cast<FinalBoneData*>(boneData+i);
-                                    for (size_t j=0; j<referenceHierarchy->getBoneCount(); j++)
+                                    bool chunkNotModified = true;
+                                    uint32_t chunkFirstDirtyInstance,chunkLastDirtyInstance;
+                                    for (uint32_t slot=slotBegin; slot<slotEnd; slot++)
                                     {
-                                        if (boneDataForInstance[j].lastAnimatedFrame==currentInstance->frame)
+                                        const uint32_t i = firstInstanceAddr+slot*instanceFinalBoneDataSize;
+                                        BoneHierarchyInstanceData* currentInstance = getBoneHierarchyInstanceFromAddr(i);
+                                        if (!currentInstance->refCount || currentInstance->frame==currentInstance->lastAnimatedFrame) //in other modes, check if also has no bones!!!
                                             continue;
-                                        if (notModified)
-                                        {
-                                            localFirstDirtyInstance = i;
-                                            notModified = false;
-                                        }
-                                        localLastDirtyInstance = i;
-                                        boneDataForInstance[j].lastAnimatedFrame = currentInstance->frame;
-
-                                        CFinalBoneHierarchy::AnimationKeyData upperFrame = (currentInstance->interpolateAnimation ? referenceHierarchy->getInterpolatedAnimationData(j):referenceHierarchy->getNonInterpolatedAnimationData(j))[foundKeyIx];
-
-                                        core::matrix3x4SIMD interpolatedLocalTform;
-                                        if (currentInstance->interpolateAnimation&&interpolationFactor<1.f)
-                                        {
-                                            CFinalBoneHierarchy::AnimationKeyData lowerFrame =  (currentInstance->interpolateAnimation ? referenceHierarchy->getInterpolatedAnimationData(j):referenceHierarchy->getNonInterpolatedAnimationData(j))[foundKeyIx-1];
-                                            interpolatedLocalTform = referenceHierarchy->getMatrixFromKeys(lowerFrame,upperFrame,interpolationFactor,interpolantPrecalcTerm2,interpolantPrecalcTerm3);
-                                        }
-                                        else
-                                            interpolatedLocalTform = referenceHierarchy->getMatrixFromKey(upperFrame);
-
-                                        if (j < referenceHierarchy->getBoneLevelRangeEnd(0))
-                                            getGlobalMatrices(currentInstance)[j] = interpolatedLocalTform.getAsRetardedIrrlichtMatrix();
-                                        else
-                                        {
-                                            const core::matrix4x3& parentTform = getGlobalMatrices(currentInstance)[referenceHierarchy->getBoneData()[j].parentOffsetFromTop];
-                                            getGlobalMatrices(currentInstance)[j] = core::matrix3x4SIMD::concatenateBFollowedByA(core::matrix3x4SIMD().set(parentTform), interpolatedLocalTform).getAsRetardedIrrlichtMatrix();
-                                        }
-                                        boneDataForInstance[j].SkinningTransform = core::matrix3x4SIMD::concatenateBFollowedByA(core::matrix3x4SIMD().set(getGlobalMatrices(currentInstance)[j]), core::matrix3x4SIMD().set(referenceHierarchy->getBoneData()[j].PoseBindMatrix)).getAsRetardedIrrlichtMatrix();
 
-
-                                        core::aabbox3df bbox;
-                                        bbox.MinEdge.X = referenceHierarchy->getBoneData()[j].MinBBoxEdge[0];
-                                        bbox.MinEdge.Y = referenceHierarchy->getBoneData()[j].MinBBoxEdge[1];
-                                        bbox.MinEdge.Z = referenceHierarchy->getBoneData()[j].MinBBoxEdge[2];
-                                        bbox.MaxEdge.X = referenceHierarchy->getBoneData()[j].MaxBBoxEdge[0];
-                                        bbox.MaxEdge.Y = referenceHierarchy->getBoneData()[j].MaxBBoxEdge[1];
-                                        bbox.MaxEdge.Z = referenceHierarchy->getBoneData()[j].MaxBBoxEdge[2];
-                                        //boneDataForInstance[j].SkinningTransform.transformBoxEx(bbox);
-										bbox = core::transformBoxEx(bbox, core::matrix3x4SIMD().set(boneDataForInstance[j].SkinningTransform));
-                                        //
-                                        if (boneControlMode==EBUM_READ)
+                                        if (!animateInstance(currentInstance,reinterpret_cast<FinalBoneData*>(boneData+i)))
+                                            continue;
+                                        if (chunkNotModified)
                                         {
-                                            IBoneSceneNode* bone = getBones(currentInstance)[j];
-                                            if (bone)
-                                            {
-												if (bone->getSkinningSpace() != IBoneSceneNode::EBSS_LOCAL)
-													bone->setRelativeTransformationMatrix(core::matrix3x4SIMD::concatenateBFollowedByA(core::matrix3x4SIMD().set(attachedNodeTform), core::matrix3x4SIMD().set(getGlobalMatrices(currentInstance)[j])).getAsRetardedIrrlichtMatrix()/*concatenateBFollowedByA(attachedNodeTform,getGlobalMatrices(currentInstance)[j])*/);
-                                                else
-                                                {
-                                                    bone->setRelativeTransformationMatrix(interpolatedLocalTform.getAsRetardedIrrlichtMatrix());
-                                                    bone->updateAbsolutePosition();
-                                                }
-                                            }
+                                            chunkFirstDirtyInstance = i;
+                                            chunkNotModified = false;
                                         }
+                                        chunkLastDirtyInstance = i;
+                                    }
 
-                                        boneDataForInstance[j].MinBBoxEdge[0] = bbox.MinEdge.X;
-                                        boneDataForInstance[j].MinBBoxEdge[1] = bbox.MinEdge.Y;
-                                        boneDataForInstance[j].MinBBoxEdge[2] = bbox.MinEdge.Z;
-                                        boneDataForInstance[j].MaxBBoxEdge[0] = bbox.MaxEdge.X;
-                                        boneDataForInstance[j].MaxBBoxEdge[1] = bbox.MaxEdge.Y;
-                                        boneDataForInstance[j].MaxBBoxEdge[2] = bbox.MaxEdge.Z;
-                                        boneDataForInstance[j].SkinningTransform.getSub3x3InverseTranspose(boneDataForInstance[j].SkinningNormalMatrix);
+                                    if (chunkNotModified)
+                                        return;
+                                    std::lock_guard<core::mutex> lock(dirtyRangeMutex);
+                                    if (notModified)
+                                    {
+                                        localFirstDirtyInstance = chunkFirstDirtyInstance;
+                                        localLastDirtyInstance = chunkLastDirtyInstance;
+                                        notModified = false;
                                     }
-                                }
+                                    else
+                                    {
+                                        localFirstDirtyInstance = std::min(localFirstDirtyInstance,chunkFirstDirtyInstance);
+                                        localLastDirtyInstance = std::max(localLastDirtyInstance,chunkLastDirtyInstance);
+                                    }
+                                },0u,MinInstancesPerThread);
 
-                                if (!notModified)
+                                if (!notModified)
                                     instanceBoneDataAllocator->markRangeForPush(localFirstDirtyInstance,localLastDirtyInstance+instanceFinalBoneDataSize);
 
                                 TrySwapBoneBuffer();
 
                                 if (!notModified)
                                 {
-                                    for (size_t i=localFirstDirtyInstance; i<=localLastDirtyInstance; i+=instanceFinalBoneDataSize)
+                                    const uint32_t dirtySlots = (localLastDirtyInstance-localFirstDirtyInstance)/instanceFinalBoneDataSize+1u;
+                                    core::parallel_for<uint32_t>(0u,dirtySlots,[&](uint32_t slotBegin, uint32_t slotEnd)
                                     {
-                                        BoneHierarchyInstanceData* currentInstance = getBoneHierarchyInstanceFromAddr(i);
-                                        if (!currentInstance->refCount || currentInstance->frame==currentInstance->lastAnimatedFrame) //in other modes, check if also has no bones!!!
-                                            continue;
-                                        currentInstance->lastAnimatedFrame = currentInstance->frame;
-
-                                        core::aabbox3df nodeBBox;
-                                        FinalBoneData* boneDataForInstance = reinterpret_cast<FinalBoneData*>(boneData+i);
-                                        for (size_t j=0; j<referenceHierarchy->getBoneCount(); j++)
+                                        for (uint32_t slot=slotBegin; slot<slotEnd; slot++)
                                         {
-                                            if (boneControlMode==EBUM_READ)
+                                            const uint32_t i = localFirstDirtyInstance+slot*instanceFinalBoneDataSize;
+                                            BoneHierarchyInstanceData* currentInstance = getBoneHierarchyInstanceFromAddr(i);
+                                            if (!currentInstance->refCount || currentInstance->frame==currentInstance->lastAnimatedFrame) //in other modes, check if also has no bones!!!
+                                                continue;
+                                            currentInstance->lastAnimatedFrame = currentInstance->frame;
+
+                                            core::aabbox3df nodeBBox;
+                                            FinalBoneData* boneDataForInstance = reinterpret_cast<FinalBoneData*>(boneData+i);
+                                            for (size_t j=0; j<referenceHierarchy->getBoneCount(); j++)
                                             {
-                                                IBoneSceneNode* bone = getBones(currentInstance)[j];
-                                                if (bone)
-                                                    bone->updateAbsolutePosition();
-                                            }
+                                                if (boneControlMode==EBUM_READ)
+                                                {
+                                                    IBoneSceneNode* bone = getBones(currentInstance)[j];
+                                                    if (bone)
+                                                        bone->updateAbsolutePosition();
+                                                }
 
-                                            if (!currentInstance->attachedNode)
-                                                continue;
+                                                if (!currentInstance->attachedNode)
+                                                    continue;
+
+                                                core::aabbox3df bbox;
+                                                bbox.MinEdge.X = boneDataForInstance[j].MinBBoxEdge[0];
+                                                bbox.MinEdge.Y = boneDataForInstance[j].MinBBoxEdge[1];
+                                                bbox.MinEdge.Z = boneDataForInstance[j].MinBBoxEdge[2];
+                                                bbox.MaxEdge.X = boneDataForInstance[j].MaxBBoxEdge[0];
+                                                bbox.MaxEdge.Y = boneDataForInstance[j].MaxBBoxEdge[1];
+                                                bbox.MaxEdge.Z = boneDataForInstance[j].MaxBBoxEdge[2];
+                                                if (j)
+                                                    nodeBBox.addInternalBox(bbox);
+                                                else
+                                                    nodeBBox = bbox;
+                                            }
 
-                                            core::aabbox3df bbox;
-                                            bbox.MinEdge.X = boneDataForInstance[j].MinBBoxEdge[0];
-                                            bbox.MinEdge.Y = boneDataForInstance[j].MinBBoxEdge[1];
-                                            bbox.MinEdge.Z = boneDataForInstance[j].MinBBoxEdge[2];
-                                            bbox.MaxEdge.X = boneDataForInstance[j].MaxBBoxEdge[0];
-                                            bbox.MaxEdge.Y = boneDataForInstance[j].MaxBBoxEdge[1];
-                                            bbox.MaxEdge.Z = boneDataForInstance[j].MaxBBoxEdge[2];
-                                            if (j)
-                                                nodeBBox.addInternalBox(bbox);
-                                            else
-                                                nodeBBox = bbox;
+                                            if (currentInstance->attachedNode)
+                                                currentInstance->attachedNode->setBoundingBox(nodeBBox);
                                         }
-
-                                        if (currentInstance->attachedNode)
-                                            currentInstance->attachedNode->setBoundingBox(nodeBBox);
-                                    }
+                                    },0u,MinInstancesPerThread);
                                 }
                             }
                             break;
@@ -13,6 +13,7 @@
 
 #include "S4DVertex.h"
 #include "CBlit.h"
+#include "irr/core/parallel_for.h"
 
 
 #define MAT_TEXTURE(tex) ( (video::CSoftwareTexture2*) Material.org.getTexture ( tex ) )
@@ -335,7 +336,8 @@ struct program1
 CBurningVideoDriver::CBurningVideoDriver(IrrlichtDevice* dev, const irr::SIrrlichtCreationParameters& params, io::IFileSystem* io, video::IImagePresenter* presenter)
 : CNullDriver(dev, io, params.WindowSize), BackBuffer(0), Presenter(presenter),
 	WindowId(0), SceneSourceRect(0),
-	RenderTargetTexture(0), RenderTargetSurface(0), CurrentShader(0),
+	RenderTargetTexture(0), RenderTargetSurface(0), CurrentShader(0), CurrentShaderType(ETR_INVALID),
+	TileBinner(0), BinnedShaderType(ETR_INVALID), TileWorkerCount(1u), TilePool(0),
 	 DepthBuffer(0), StencilBuffer ( 0 ),
 	 CurrentOut ( 12 * 2, 128 ), Temp ( 12 * 2, 128 )
 {
@@ -360,20 +362,17 @@ CBurningVideoDriver::CBurningVideoDriver(IrrlichtDevice* dev, const irr::SIrrlic
 
 	// create triangle renderers
 
-	irr::memset32 ( BurningShader, 0, sizeof ( BurningShader ) );
-	BurningShader[ETR_GOURAUD] = createTriangleRendererGouraud2(this);
-	BurningShader[ETR_TEXTURE_GOURAUD] = createTriangleRendererTextureGouraud2(this);
-
-	BurningShader[ETR_TEXTURE_GOURAUD_NOZ] = createTRTextureGouraudNoZ2(this);
-	BurningShader[ETR_TEXTURE_GOURAUD_ADD] = createTRTextureGouraudAdd2(this);
-	BurningShader[ETR_TEXTURE_GOURAUD_ADD_NO_Z] = createTRTextureGouraudAddNoZ2(this);
-	BurningShader[ETR_TEXTURE_GOURAUD_VERTEX_ALPHA] = createTriangleRendererTextureVertexAlpha2 ( this );
-
-	BurningShader[ETR_TEXTURE_GOURAUD_ALPHA] = createTRTextureGouraudAlpha(this );
-	BurningShader[ETR_TEXTURE_GOURAUD_ALPHA_NOZ] = createTRTextureGouraudAlphaNoZ( this );
-
-	BurningShader[ETR_REFERENCE] = createTriangleRendererReference ( this );
+	for ( uint32_t i = 0; i != ETR2_COUNT; ++i )
+		BurningShader[i] = createBurningShader ( (EBurningFFShader) i );
 
+	// screen tiles get rasterized by several threads, each with its own copies of the triangle renderers
+	TileWorkerCount = params.SoftwareRasterizerThreads ? params.SoftwareRasterizerThreads : core::getDefaultThreadCount();
+	if ( TileWorkerCount > 1u )
+	{
+		TileBinner = new CBurningTileBinner ( this );
+		TileShaders.resize ( TileWorkerCount * ETR2_COUNT, 0 );
+		TilePool = new core::CThreadPool ( TileWorkerCount - 1u );
+	}
 
 
 	// add the same renderer for all solid types
@@ -417,6 +416,17 @@ CBurningVideoDriver::~CBurningVideoDriver()
 			BurningShader[i]->drop();
 	}
 
+	if (TileBinner)
+		TileBinner->drop();
+
+	delete TilePool;
+
+	for (auto shader : TileShaders)
+	{
+		if (shader)
+			shader->drop();
+	}
+
 	// delete Additional buffer
 	if (StencilBuffer)
 		StencilBuffer->drop();
@@ -489,23 +499,101 @@ void CBurningVideoDriver::setCurrentShader()
 
 	// switchToTriangleRenderer
 	CurrentShader = BurningShader[shader];
+	CurrentShaderType = shader;
 	if ( CurrentShader )
-	{
-		CurrentShader->setZCompareFunc ( Material.org.ZBuffer );
-		CurrentShader->setRenderTarget(RenderTargetSurface, ViewPort);
-		CurrentShader->setMaterial ( Material );
+		applyShaderState ( CurrentShader, shader );
 
-		switch ( shader )
-		{
-			case ETR_TEXTURE_GOURAUD_ALPHA:
-			case ETR_TEXTURE_GOURAUD_ALPHA_NOZ:
-				CurrentShader->setParam ( 0, Material.org.MaterialTypeParam );
-				break;
-			default:
+}
+
+
+void CBurningVideoDriver::applyShaderState(IBurningShader* shader, EBurningFFShader type)
+{
+	shader->setZCompareFunc ( Material.org.ZBuffer );
+	shader->setRenderTarget(RenderTargetSurface, ViewPort);
+	shader->setMaterial ( Material );
+
+	switch ( type )
+	{
+		case ETR_TEXTURE_GOURAUD_ALPHA:
+		case ETR_TEXTURE_GOURAUD_ALPHA_NOZ:
+			shader->setParam ( 0, Material.org.MaterialTypeParam );
 			break;
-		}
+		default:
+		break;
 	}
+}
+
 
+IBurningShader* CBurningVideoDriver::createBurningShader(EBurningFFShader type)
+{
+	switch ( type )
+	{
+		case ETR_GOURAUD:
+			return createTriangleRendererGouraud2(this);
+		case ETR_GOURAUD_ALPHA_NOZ:
+			return createTRGouraudAlphaNoZ2(this);
+		case ETR_TEXTURE_GOURAUD:
+			return createTriangleRendererTextureGouraud2(this);
+		case ETR_TEXTURE_GOURAUD_NOZ:
+			return createTRTextureGouraudNoZ2(this);
+		case ETR_TEXTURE_GOURAUD_ADD:
+			return createTRTextureGouraudAdd2(this);
+		case ETR_TEXTURE_GOURAUD_ADD_NO_Z:
+			return createTRTextureGouraudAddNoZ2(this);
+		case ETR_TEXTURE_GOURAUD_VERTEX_ALPHA:
+			return createTriangleRendererTextureVertexAlpha2 ( this );
+		case ETR_TEXTURE_GOURAUD_ALPHA:
+			return createTRTextureGouraudAlpha(this );
+		case ETR_TEXTURE_GOURAUD_ALPHA_NOZ:
+			return createTRTextureGouraudAlphaNoZ( this );
+		case ETR_REFERENCE:
+			return createTriangleRendererReference ( this );
+		default:
+			return 0;
+	}
+}
+
+
+IBurningShader* CBurningVideoDriver::getTriangleSink(EBurningFFShader type)
+{
+	if ( !TileBinner )
+		return BurningShader[type];
+
+	// one batch of binned triangles is rasterized by one type of renderer
+	if ( BinnedShaderType != type )
+		flushBinnedTriangles ();
+
+	BinnedShaderType = type;
+	return TileBinner;
+}
+
+
+/*!
+	Everything binned since the last flush gets drawn by the renderer the triangles were meant for,
+	small batches on this thread and bigger ones by TileWorkerCount copies of it in screen tiles.
+	The renderers pick up the current render states here, which are still the ones the triangles were binned with.
+*/
+void CBurningVideoDriver::flushBinnedTriangles()
+{
+	if ( !TileBinner || !TileBinner->getTriangleCount() )
+		return;
+
+	if ( TileBinner->getTriangleCount() < uint32_t(CBurningTileBinner::MinParallelTriangles) )
+	{
+		applyShaderState ( BurningShader[BinnedShaderType], BinnedShaderType );
+		TileBinner->flush ( BurningShader + BinnedShaderType, 1u );
+		return;
+	}
+
+	IBurningShader** workers = TileShaders.data() + BinnedShaderType * TileWorkerCount;
+	for ( uint32_t i = 0; i != TileWorkerCount; ++i )
+	{
+		if ( !workers[i] )
+			workers[i] = createBurningShader ( BinnedShaderType );
+		applyShaderState ( workers[i], BinnedShaderType );
+	}
+
+	TileBinner->flush ( workers, TileWorkerCount, TilePool );
 }
 
 
@@ -516,6 +604,7 @@ bool CBurningVideoDriver::beginScene(bool backBuffer, bool zBuffer,
 		core::rect<int32_t>* sourceRect)
 {
 	CNullDriver::beginScene(backBuffer, zBuffer, color, videoData, sourceRect);
+	flushBinnedTriangles();
 	WindowId = videoData.OpenGLWin32.HWnd;
 	SceneSourceRect = sourceRect;
 
@@ -533,6 +622,7 @@ bool CBurningVideoDriver::beginScene(bool backBuffer, bool zBuffer,
 bool CBurningVideoDriver::endScene()
 {
 	CNullDriver::endScene();
+	flushBinnedTriangles();
 
 	return Presenter->present(BackBuffer, WindowId, SceneSourceRect);
 }
@@ -579,6 +669,8 @@ bool CBurningVideoDriver::setRenderTarget(video::ITexture* texture, bool clearBa
 //! sets a render target
 void CBurningVideoDriver::setRenderTarget(video::CImage* image)
 {
+	flushBinnedTriangles();
+
 	if (RenderTargetSurface)
 		RenderTargetSurface->drop();
 
@@ -606,6 +698,8 @@ void CBurningVideoDriver::setRenderTarget(video::CImage* image)
 //! sets a viewport
 void CBurningVideoDriver::setViewPort(const core::rect<int32_t>& area)
 {
+	flushBinnedTriangles();
+
 	ViewPort = area;
 
 	core::rect<int32_t> rendert(0,0,RenderTargetSize.Width,RenderTargetSize.Height);
@@ -630,6 +724,9 @@ void CBurningVideoDriver::setViewPort(const core::rect<int32_t>& area)
 
 	if (CurrentShader)
 		CurrentShader->setRenderTarget(RenderTargetSurface, ViewPort);
+
+	if (TileBinner)
+		TileBinner->setRenderTarget(RenderTargetSurface, ViewPort);
 }
 
 /*
@@ -1488,6 +1585,9 @@ void CBurningVideoDriver::drawVertexPrimitiveList(const void* vertices, uint32_t
 
 	VertexCache_reset ( vertices, vertexCount, indexList, primitiveCount, vType, pType, iType );
 
+	// straight to the current renderer, or binned into screen tiles to be rasterized by several threads later on
+	IBurningShader* render = getTriangleSink ( CurrentShaderType );
+
 	const s4DVertex * face[3];
 
 	float dc_area;
@@ -1523,17 +1623,17 @@ void CBurningVideoDriver::drawVertexPrimitiveList(const void* vertices, uint32_t
 			{
 				if ( 0 == (tex = MAT_TEXTURE ( m )) )
 				{
-					CurrentShader->setTextureParam(m, 0, 0);
+					render->setTextureParam(m, 0, 0);
 					continue;
 				}
 
 				lodLevel = s32_log2_f32 ( texelarea2 ( face, m ) * dc_area  );
-				CurrentShader->setTextureParam(m, tex, lodLevel );
+				render->setTextureParam(m, tex, lodLevel );
 				select_polygon_mipmap2 ( (s4DVertex**) face, m, tex->getSize() );
 			}
 
 			// rasterize
-			CurrentShader->drawTriangle ( face[0] + 1, face[1] + 1, face[2] + 1 );
+			render->drawTriangle ( face[0] + 1, face[1] + 1, face[2] + 1 );
 			continue;
 		}
 
@@ -1598,12 +1698,12 @@ void CBurningVideoDriver::drawVertexPrimitiveList(const void* vertices, uint32_t
 		{
 			if ( 0 == (tex = MAT_TEXTURE ( m )) )
 			{
-				CurrentShader->setTextureParam(m, 0, 0);
+				render->setTextureParam(m, 0, 0);
 				continue;
 			}
 
 			lodLevel = s32_log2_f32 ( texelarea ( CurrentOut.data, m ) * dc_area );
-			CurrentShader->setTextureParam(m, tex, lodLevel );
+			render->setTextureParam(m, tex, lodLevel );
 			select_polygon_mipmap ( CurrentOut.data, vOut, m, tex->getSize() );
 		}
 
@@ -1612,7 +1712,7 @@ void CBurningVideoDriver::drawVertexPrimitiveList(const void* vertices, uint32_t
 		for ( g = 0; g <= vOut - 6; g += 2 )
 		{
 			// rasterize
-			CurrentShader->drawTriangle ( CurrentOut.data + 0 + 1,
+			render->drawTriangle ( CurrentOut.data + 0 + 1,
 							CurrentOut.data + g + 3,
 							CurrentOut.data + g + 5);
 		}
@@ -1636,6 +1736,8 @@ void CBurningVideoDriver::drawVertexPrimitiveList(const void* vertices, uint32_t
 //! sets a material
 void CBurningVideoDriver::setMaterial(const SGPUMaterial& material)
 {
+	flushBinnedTriangles();
+
 	Material.org = material;
 
 
@@ -1680,6 +1782,8 @@ void CBurningVideoDriver::draw2DImage(const video::ITexture* texture, const core
 					 const core::rect<int32_t>* clipRect, SColor color,
 					 bool useAlphaChannelOfTexture)
 {
+	flushBinnedTriangles();
+
 	if (texture)
 	{
 		if (texture->getDriverType() != EDT_BURNINGSVIDEO)
@@ -1703,6 +1807,8 @@ void CBurningVideoDriver::draw2DImage(const video::ITexture* texture, const core
 		const core::rect<int32_t>& sourceRect, const core::rect<int32_t>* clipRect,
 		const video::SColor* const colors, bool useAlphaChannelOfTexture)
 {
+	flushBinnedTriangles();
+
 	if (texture)
 	{
 		if (texture->getDriverType() != EDT_BURNINGSVIDEO)
@@ -1725,6 +1831,7 @@ void CBurningVideoDriver::draw2DLine(const core::position2d<int32_t>& start,
 					const core::position2d<int32_t>& end,
 					SColor color)
 {
+	flushBinnedTriangles();
 	drawLine(BackBuffer, start, end, color );
 }
 
@@ -1732,6 +1839,7 @@ void CBurningVideoDriver::draw2DLine(const core::position2d<int32_t>& start,
 //! Draws a pixel
 void CBurningVideoDriver::drawPixel(uint32_t x, uint32_t y, const SColor & color)
 {
+	flushBinnedTriangles();
 	BackBuffer->setPixel(x, y, color, true);
 }
 
@@ -1740,6 +1848,8 @@ void CBurningVideoDriver::drawPixel(uint32_t x, uint32_t y, const SColor & color
 void CBurningVideoDriver::draw2DRectangle(SColor color, const core::rect<int32_t>& pos,
 									 const core::rect<int32_t>* clip)
 {
+	flushBinnedTriangles();
+
 	if (clip)
 	{
 		core::rect<int32_t> p(pos);
@@ -1820,18 +1930,8 @@ void CBurningVideoDriver::draw2DRectangle(const core::rect<int32_t>& position,
 	const int32_t yPlus = renderTargetSize.Height-(renderTargetSize.Height>>1);
 	const float yFact = 1.0f / (renderTargetSize.Height>>1);
 
-	// fill VertexCache direct
-	s4DVertex *v;
-#ifndef NEW_MESHES
-#error "VERTICES ARE NO LONGER WITH US"
-	VertexCache.vertexCount = 4;
-
-	VertexCache.info[0].index = 0;
-	VertexCache.info[1].index = 1;
-	VertexCache.info[2].index = 2;
-	VertexCache.info[3].index = 3;
-
-	v = &VertexCache.mem.data [ 0 ];
+	// pairs of the clip space vertex and its projection, the corners go clockwise from the upper left
+	s4DVertex v[8];
 
 	v[0].Pos.set ( (float)(pos.UpperLeftCorner.X+xPlus) * xFact, (float)(yPlus-pos.UpperLeftCorner.Y) * yFact, 0.f, 1.f );
 	v[0].Color[0].setA8R8G8B8 ( colorLeftUp.color );
@@ -1850,7 +1950,7 @@ void CBurningVideoDriver::draw2DRectangle(const core::rect<int32_t>& position,
 
 	for ( i = 0; i!= 8; i += 2 )
 	{
-		v[i + 0].flag = clipToFrustumTest ( v + i );
+		v[i + 0].flag = clipToFrustumTest ( v + i ) | VERTEX4D_FORMAT_COLOR_1;
 		v[i + 1].flag = 0;
 		if ( (v[i].flag & VERTEX4D_INSIDE ) == VERTEX4D_INSIDE )
 		{
@@ -1860,8 +1960,9 @@ void CBurningVideoDriver::draw2DRectangle(const core::rect<int32_t>& position,
 
 	IBurningShader * render;
 
-	render = BurningShader [ ETR_GOURAUD_ALPHA_NOZ ];
-	render->setRenderTarget(RenderTargetSurface, ViewPort);
+	render = getTriangleSink ( ETR_GOURAUD_ALPHA_NOZ );
+	if ( render == BurningShader [ ETR_GOURAUD_ALPHA_NOZ ] )
+		applyShaderState ( render, ETR_GOURAUD_ALPHA_NOZ );
 
 	static const int16_t indexList[6] = {0,1,2,0,2,3};
 
@@ -1869,9 +1970,9 @@ void CBurningVideoDriver::draw2DRectangle(const core::rect<int32_t>& position,
 
 	for ( i = 0; i!= 6; i += 3 )
 	{
-		face[0] = VertexCache_getVertex ( indexList [ i + 0 ] );
-		face[1] = VertexCache_getVertex ( indexList [ i + 1 ] );
-		face[2] = VertexCache_getVertex ( indexList [ i + 2 ] );
+		face[0] = v + ( indexList [ i + 0 ] << 1 );
+		face[1] = v + ( indexList [ i + 1 ] << 1 );
+		face[2] = v + ( indexList [ i + 2 ] << 1 );
 
 		// test clipping
 		uint32_t test = face[0]->flag & face[1]->flag & face[2]->flag & VERTEX4D_INSIDE;
@@ -1884,9 +1985,18 @@ void CBurningVideoDriver::draw2DRectangle(const core::rect<int32_t>& position,
 		// Todo: all vertices are clipped in 2d..
 		// is this true ?
 		uint32_t vOut = 6;
-		memcpy ( CurrentOut.data + 0, face[0], sizeof ( s4DVertex ) * 2 );
-		memcpy ( CurrentOut.data + 2, face[1], sizeof ( s4DVertex ) * 2 );
-		memcpy ( CurrentOut.data + 4, face[2], sizeof ( s4DVertex ) * 2 );
+		for ( g = 0; g != 3; ++g )
+		{
+			CurrentOut.data[ ( g << 1 ) + 0 ] = face[g][0];
+			CurrentOut.data[ ( g << 1 ) + 1 ] = face[g][1];
+		}
+
+		// the clipper only writes the clip space half of each pair, none may pass for projected already
+		for ( g = 0; g != CurrentOut.ElementSize; ++g )
+		{
+			CurrentOut.data[g].flag = VERTEX4D_FORMAT_COLOR_1;
+			Temp.data[g].flag = VERTEX4D_FORMAT_COLOR_1;
+		}
 
 		vOut = clipToFrustum ( CurrentOut.data, Temp.data, 3 );
 		if ( vOut < 3 )
@@ -1904,7 +2014,6 @@ void CBurningVideoDriver::draw2DRectangle(const core::rect<int32_t>& position,
 		}
 
 	}
-#endif // NEW_MESHES
 
 #else
 	draw2DRectangle ( colorLeftUp, position, clip );
@@ -1951,6 +2060,8 @@ asset::E_FORMAT CBurningVideoDriver::getColorFormat() const
 //! Clears the DepthBuffer.
 void CBurningVideoDriver::clearZBuffer()
 {
+	flushBinnedTriangles();
+
 	if (DepthBuffer)
 		DepthBuffer->clear();
 }
@@ -7,6 +7,7 @@
 
 #include "SoftwareDriver2_compile_config.h"
 #include "IBurningShader.h"
+#include "CBurningTileBinner.h"
 #include "CNullDriver.h"
 #include "CImage.h"
 #include "os.h"
@@ -129,9 +130,29 @@ namespace video
 		//! selects the right triangle renderer based on the render states.
 		void setCurrentShader();
 
+		//! passes the render states on to one of the triangle renderers
+		void applyShaderState(IBurningShader* shader, EBurningFFShader type);
+
+		IBurningShader* createBurningShader(EBurningFFShader type);
+
 		IBurningShader* CurrentShader;
+		EBurningFFShader CurrentShaderType;
 		IBurningShader* BurningShader[ETR2_COUNT];
 
+		//! where triangles for BurningShader[type] have to be sent, the tile binner when rasterizing on several threads
+		IBurningShader* getTriangleSink(EBurningFFShader type);
+
+		//! rasterizes the binned triangles, needs to be called before anything else touches the render target or the render states
+		void flushBinnedTriangles();
+
+		CBurningTileBinner* TileBinner;
+		EBurningFFShader BinnedShaderType;
+		uint32_t TileWorkerCount;
+		//! runs all workers but the first, kept around since a frame flushes the bins many times
+		core::CThreadPool* TilePool;
+		//! TileWorkerCount shaders of each type, created the first time a type is rasterized in tiles
+		core::vector<IBurningShader*> TileShaders;
+
 		IDepthBuffer* DepthBuffer;
 		IStencilBuffer* StencilBuffer;
 
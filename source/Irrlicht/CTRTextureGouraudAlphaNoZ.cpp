@@ -155,11 +155,11 @@ void CTRTextureGouraudAlphaNoZ::scanline_bilinear ()
 
 	// apply top-left fill-convention, left
 	xStart = core::ceil32( line.x[0] );
-	xEnd = core::ceil32( line.x[1] ) - 1;
+	xEnd = core::s32_min( core::ceil32( line.x[1] ) - 1, Scissor.LowerRightCorner.X - 1 );
 
 	dx = xEnd - xStart;
 
-	if ( dx < 0 )
+	if ( dx < 0 || xEnd < Scissor.UpperLeftCorner.X )
 		return;
 
 	// slopes
@@ -224,7 +224,99 @@ void CTRTextureGouraudAlphaNoZ::scanline_bilinear ()
 	tFixPoint r2, g2, b2;
 #endif
 
-	for ( int32_t i = 0; i <= dx; ++i )
+	// pixels left of the scissor are skipped with a single step of the interpolators
+	int32_t i = 0;
+	if ( xStart < Scissor.UpperLeftCorner.X )
+	{
+		i = Scissor.UpperLeftCorner.X - xStart;
+		const float skip = (float) i;
+#ifdef IPOL_Z
+		line.z[0] += slopeZ * skip;
+#endif
+#ifdef IPOL_W
+		line.w[0] += slopeW * skip;
+#endif
+#ifdef IPOL_C0
+		line.c[0][0] += slopeC[0] * skip;
+#endif
+#ifdef IPOL_T0
+		line.t[0][0] += slopeT[0] * skip;
+#endif
+#ifdef IPOL_T1
+		line.t[1][0] += slopeT[1] * skip;
+#endif
+	}
+
+#ifdef SOFTWARE_DRIVER_2_SIMD_SPANS
+	// 4 pixels at a time, the interpolators take the same steps as in the loop below which does the rest
+	for ( ; i + 3 <= dx; i += 4 )
+	{
+		const __m128 w = step_x4 ( line.w[0], slopeW );
+		const __m128 tx = step_x4 ( line.t[0][0].x, slopeT[0].x );
+		const __m128 ty = step_x4 ( line.t[0][0].y, slopeT[0].y );
+#ifdef IPOL_C0
+		__m128 ca, cr, cg, cb;
+		step_x4 ( ca, cr, cg, cb, line.c[0][0], slopeC[0] );
+#endif
+
+#ifdef CMP_W
+		const __m128 mask = _mm_cmpge_ps ( w, _mm_loadu_ps ( z + i ) );
+		if ( !_mm_movemask_ps ( mask ) )
+			continue;
+#endif
+
+#ifdef INVERSE_W
+		const __m128 inversew = fix_inverse32_x4 ( w );
+		const __m128i tx0 = tofix_x4 ( tx, inversew );
+		const __m128i ty0 = tofix_x4 ( ty, inversew );
+#else
+		const __m128i tx0 = tofix_x4 ( tx );
+		const __m128i ty0 = tofix_x4 ( ty );
+#endif
+
+		__m128i a0, r0, g0, b0;
+		getSample_texture_x4 ( a0, r0, g0, b0, &IT[0], tx0, ty0 );
+
+		// (tFixPointu) a0 > AlphaRef, SSE only compares signed
+		const __m128i sign = _mm_set1_epi32 ( (int32_t) 0x80000000 );
+		const __m128 alphaMask = _mm_castsi128_ps ( _mm_cmpgt_epi32 ( _mm_xor_si128 ( a0, sign ), _mm_xor_si128 ( _mm_set1_epi32 ( AlphaRef ), sign ) ) );
+#ifdef CMP_W
+		const __m128 pass = _mm_and_ps ( mask, alphaMask );
+#else
+		const __m128 pass = alphaMask;
+#endif
+		if ( !_mm_movemask_ps ( pass ) )
+			continue;
+
+#ifdef INVERSE_W
+		__m128i r2 = tofix_x4 ( cr, inversew );
+		__m128i g2 = tofix_x4 ( cg, inversew );
+		__m128i b2 = tofix_x4 ( cb, inversew );
+#else
+		__m128i r2 = tofix_x4 ( cr, COLOR_MAX * FIX_POINT_F32_MUL );
+		__m128i g2 = tofix_x4 ( cg, COLOR_MAX * FIX_POINT_F32_MUL );
+		__m128i b2 = tofix_x4 ( cb, COLOR_MAX * FIX_POINT_F32_MUL );
+#endif
+		r0 = imulFix_x4 ( r0, r2 );
+		g0 = imulFix_x4 ( g0, g2 );
+		b0 = imulFix_x4 ( b0, b2 );
+
+		__m128i r1, g1, b1;
+		color_to_fix_x4 ( r1, g1, b1, _mm_loadu_si128 ( (const __m128i*) ( dst + i ) ) );
+
+		a0 = _mm_srai_epi32 ( a0, 8 );
+
+		r2 = _mm_add_epi32 ( r1, imulFix_x4 ( a0, _mm_sub_epi32 ( r0, r1 ) ) );
+		g2 = _mm_add_epi32 ( g1, imulFix_x4 ( a0, _mm_sub_epi32 ( g0, g1 ) ) );
+		b2 = _mm_add_epi32 ( b1, imulFix_x4 ( a0, _mm_sub_epi32 ( b0, b1 ) ) );
+		store_masked_x4 ( dst + i, fix4_to_color_x4 ( a0, r2, g2, b2 ), pass );
+#ifdef WRITE_W
+		store_masked_x4 ( z + i, w, pass );
+#endif
+	}
+#endif
+
+	for ( ; i <= dx; ++i )
 	{
 #ifdef CMP_Z
 		if ( line.z[0] < z[i] )
@@ -452,7 +544,7 @@ void CTRTextureGouraudAlphaNoZ::drawTriangle ( const s4DVertex *a,const s4DVerte
 
 		// apply top-left fill convention, top part
 		yStart = core::ceil32( a->Pos.y );
-		yEnd = core::ceil32( b->Pos.y ) - 1;
+		yEnd = core::s32_min( core::ceil32( b->Pos.y ) - 1, Scissor.LowerRightCorner.Y - 1 );
 
 #ifdef SUBTEXEL
 		subPixel = ( (float) yStart ) - a->Pos.y;
@@ -488,6 +580,40 @@ void CTRTextureGouraudAlphaNoZ::drawTriangle ( const s4DVertex *a,const s4DVerte
 
 #endif
 
+		// rows above the scissor are skipped with a single step of the edges
+		if ( yStart < Scissor.UpperLeftCorner.Y )
+		{
+			const float skip = (float) ( Scissor.UpperLeftCorner.Y - yStart );
+			scan.x[0] += scan.slopeX[0] * skip;
+			scan.x[1] += scan.slopeX[1] * skip;
+
+#ifdef IPOL_Z
+			scan.z[0] += scan.slopeZ[0] * skip;
+			scan.z[1] += scan.slopeZ[1] * skip;
+#endif
+
+#ifdef IPOL_W
+			scan.w[0] += scan.slopeW[0] * skip;
+			scan.w[1] += scan.slopeW[1] * skip;
+#endif
+
+#ifdef IPOL_C0
+			scan.c[0][0] += scan.slopeC[0][0] * skip;
+			scan.c[0][1] += scan.slopeC[0][1] * skip;
+#endif
+
+#ifdef IPOL_T0
+			scan.t[0][0] += scan.slopeT[0][0] * skip;
+			scan.t[0][1] += scan.slopeT[0][1] * skip;
+#endif
+
+#ifdef IPOL_T1
+			scan.t[1][0] += scan.slopeT[1][0] * skip;
+			scan.t[1][1] += scan.slopeT[1][1] * skip;
+#endif
+			yStart = Scissor.UpperLeftCorner.Y;
+		}
+
 		// rasterize the edge scanlines
 		for( line.y = yStart; line.y <= yEnd; ++line.y)
 		{
@@ -611,7 +737,7 @@ void CTRTextureGouraudAlphaNoZ::drawTriangle ( const s4DVertex *a,const s4DVerte
 
 		// apply top-left fill convention, top part
 		yStart = core::ceil32( b->Pos.y );
-		yEnd = core::ceil32( c->Pos.y ) - 1;
+		yEnd = core::s32_min( core::ceil32( c->Pos.y ) - 1, Scissor.LowerRightCorner.Y - 1 );
 
 #ifdef SUBTEXEL
 
@@ -648,6 +774,40 @@ void CTRTextureGouraudAlphaNoZ::drawTriangle ( const s4DVertex *a,const s4DVerte
 
 #endif
 
+		// rows above the scissor are skipped with a single step of the edges
+		if ( yStart < Scissor.UpperLeftCorner.Y )
+		{
+			const float skip = (float) ( Scissor.UpperLeftCorner.Y - yStart );
+			scan.x[0] += scan.slopeX[0] * skip;
+			scan.x[1] += scan.slopeX[1] * skip;
+
+#ifdef IPOL_Z
+			scan.z[0] += scan.slopeZ[0] * skip;
+			scan.z[1] += scan.slopeZ[1] * skip;
+#endif
+
+#ifdef IPOL_W
+			scan.w[0] += scan.slopeW[0] * skip;
+			scan.w[1] += scan.slopeW[1] * skip;
+#endif
+
+#ifdef IPOL_C0
+			scan.c[0][0] += scan.slopeC[0][0] * skip;
+			scan.c[0][1] += scan.slopeC[0][1] * skip;
+#endif
+
+#ifdef IPOL_T0
+			scan.t[0][0] += scan.slopeT[0][0] * skip;
+			scan.t[0][1] += scan.slopeT[0][1] * skip;
+#endif
+
+#ifdef IPOL_T1
+			scan.t[1][0] += scan.slopeT[1][0] * skip;
+			scan.t[1][1] += scan.slopeT[1][1] * skip;
+#endif
+			yStart = Scissor.UpperLeftCorner.Y;
+		}
+
 		// rasterize the edge scanlines
 		for( line.y = yStart; line.y <= yEnd; ++line.y)
 		{
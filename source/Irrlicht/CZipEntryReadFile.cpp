@@ -0,0 +1,383 @@
+#include "IrrCompileConfig.h"
+#include "CZipEntryReadFile.h"
+
+#include "os.h"
+
+#include <string.h>
+
+#ifdef _IRR_COMPILE_WITH_ZLIB_
+	#ifndef _IRR_USE_NON_SYSTEM_ZLIB_
+	#include <zlib.h> // use system lib
+	#else
+	#include "zlib/zlib.h"
+	#endif
+
+	#ifdef _IRR_COMPILE_WITH_BZIP2_
+	#ifndef _IRR_USE_NON_SYSTEM_BZLIB_
+	#include <bzlib.h>
+	#else
+	#include "bzip2/bzlib.h"
+	#endif
+	#endif
+	#ifdef _IRR_COMPILE_WITH_LZMA_
+	#include "lzma/LzmaDec.h"
+	#endif
+#endif
+
+namespace irr
+{
+namespace io
+{
+
+#ifdef _IRR_COMPILE_WITH_LZMA_
+//! Used for LZMA decompression. The lib has no default memory management
+namespace
+{
+	void *SzAlloc(ISzAllocPtr p, size_t size) { return _IRR_ALIGNED_MALLOC(size,_IRR_SIMD_ALIGNMENT); }
+	void SzFree(ISzAllocPtr p, void *address) { _IRR_ALIGNED_FREE(address); }
+	const ISzAlloc lzmaAlloc = { SzAlloc, SzFree };
+}
+#endif
+
+//! Plain data, so that it can be zeroed as a whole before the decompressor gets initialized
+struct CZipEntryReadFile::SDecoder
+{
+	union
+	{
+#ifdef _IRR_COMPILE_WITH_ZLIB_
+		z_stream Inflate;
+#endif
+#ifdef _IRR_COMPILE_WITH_BZIP2_
+		bz_stream Bunzip;
+#endif
+#ifdef _IRR_COMPILE_WITH_LZMA_
+		CLzmaDec Lzma;
+#endif
+		uint8_t Unused;
+	};
+
+	//! the LZMA properties precede the stream, this many bytes of the entry are not part of it
+	size_t HeaderSize;
+};
+
+CZipEntryReadFile::CZipEntryReadFile(IReadFile* compressedFile, const size_t& offset, const size_t& compressedSize, const size_t& uncompressedSize, E_COMPRESSION_METHOD method, const io::path& name)
+	: Filename(name), File(compressedFile), DataStart(offset), CompressedSize(compressedSize), UncompressedSize(uncompressedSize), Method(method), Decoder(nullptr),
+	Pos(0u), InputPos(0u), InputBegin(0u), InputEnd(0u), WindowStart(0u), WindowFill(0u), StreamEnd(false), Failed(false)
+{
+	#ifdef _IRR_DEBUG
+	setDebugName("CZipEntryReadFile");
+	#endif
+
+	if (!File)
+		return;
+	File->grab();
+
+	SDecoder* decoder = new SDecoder;
+	memset(decoder, 0, sizeof(SDecoder));
+	bool ok = false;
+	switch (Method)
+	{
+		case ECM_DEFLATE:
+#ifdef _IRR_COMPILE_WITH_ZLIB_
+			// wbits < 0 indicates no zlib header inside the data.
+			ok = inflateInit2(&decoder->Inflate, -MAX_WBITS)==Z_OK;
+#else
+			os::Printer::log("zlib decompression not supported. File cannot be read.", ELL_ERROR);
+#endif
+			break;
+		case ECM_BZIP2:
+#ifdef _IRR_COMPILE_WITH_BZIP2_
+			ok = BZ2_bzDecompressInit(&decoder->Bunzip, 0, 0)==BZ_OK;
+#else
+			os::Printer::log("bzip2 decompression not supported. File cannot be read.", ELL_ERROR);
+#endif
+			break;
+		case ECM_LZMA:
+#ifdef _IRR_COMPILE_WITH_LZMA_
+			{
+				// 2 bytes of version, 2 bytes of properties size and the properties
+				uint8_t header[4+LZMA_PROPS_SIZE];
+				File->seek(DataStart);
+				if (CompressedSize<sizeof(header) || File->read(header, sizeof(header))!=int32_t(sizeof(header)))
+					break;
+				const uint32_t propSize = (header[3]<<8)+header[2];
+				if (propSize!=LZMA_PROPS_SIZE)
+					break;
+				decoder->HeaderSize = 4u+propSize;
+				LzmaDec_Construct(&decoder->Lzma);
+				ok = LzmaDec_Allocate(&decoder->Lzma, header+4, propSize, &lzmaAlloc)==SZ_OK;
+				if (ok)
+					LzmaDec_Init(&decoder->Lzma);
+			}
+#else
+			os::Printer::log("lzma decompression not supported. File cannot be read.", ELL_ERROR);
+#endif
+			break;
+		default:
+			break;
+	}
+
+	if (!ok)
+	{
+		delete decoder;
+		return;
+	}
+	Decoder = decoder;
+	InputPos = Decoder->HeaderSize;
+	Input.resize(size_t(InputBufferSize));
+	Window.resize(core::min_<size_t>(size_t(WindowSize),UncompressedSize));
+}
+
+
+CZipEntryReadFile::~CZipEntryReadFile()
+{
+	if (Decoder)
+	{
+		switch (Method)
+		{
+#ifdef _IRR_COMPILE_WITH_ZLIB_
+			case ECM_DEFLATE:
+				inflateEnd(&Decoder->Inflate);
+				break;
+#endif
+#ifdef _IRR_COMPILE_WITH_BZIP2_
+			case ECM_BZIP2:
+				BZ2_bzDecompressEnd(&Decoder->Bunzip);
+				break;
+#endif
+#ifdef _IRR_COMPILE_WITH_LZMA_
+			case ECM_LZMA:
+				LzmaDec_Free(&Decoder->Lzma, &lzmaAlloc);
+				break;
+#endif
+			default:
+				break;
+		}
+		delete Decoder;
+	}
+
+	if (File)
+		File->drop();
+}
+
+
+//! returns how much was read
+int32_t CZipEntryReadFile::read(void* buffer, uint32_t sizeToRead)
+{
+	if (!isOpen() || Pos >= UncompressedSize)
+		return 0;
+
+	if (Pos < WindowStart && !restart())
+		return 0;
+
+	uint8_t* out = reinterpret_cast<uint8_t*>(buffer);
+	size_t remaining = core::min_<size_t>(sizeToRead, UncompressedSize-Pos);
+	while (remaining)
+	{
+		const size_t windowEnd = WindowStart+WindowFill;
+		if (Pos < windowEnd)
+		{
+			const size_t amount = core::min_<size_t>(remaining, windowEnd-Pos);
+			memcpy(out, Window.data()+(Pos-WindowStart), amount);
+			out += amount;
+			Pos += amount;
+			remaining -= amount;
+			continue;
+		}
+
+		size_t produced;
+		if (Pos == windowEnd && remaining >= Window.size())
+		{
+			// large read, decompress straight into the buffer and keep only its tail in the window for short backward seeks
+			produced = decompress(out, remaining);
+			const size_t kept = core::min_<size_t>(produced, Window.size());
+			memcpy(Window.data(), out+produced-kept, kept);
+			WindowStart = windowEnd+produced-kept;
+			WindowFill = kept;
+			out += produced;
+			Pos += produced;
+			remaining -= produced;
+		}
+		else
+		{
+			// slide the window forward, also skips over whatever a forward seek jumped past
+			produced = decompress(Window.data(), Window.size());
+			WindowStart = windowEnd;
+			WindowFill = produced;
+		}
+
+		if (!produced)
+			break;
+	}
+
+	return static_cast<int32_t>(out-reinterpret_cast<uint8_t*>(buffer));
+}
+
+
+//! changes position in file, returns true if successful
+//! if relativeMovement==true, the pos is changed relative to current pos,
+//! otherwise from begin of file
+bool CZipEntryReadFile::seek(const size_t& finalPos, bool relativeMovement)
+{
+	if (!isOpen())
+		return false;
+
+	const size_t newPos = relativeMovement ? Pos+finalPos : finalPos;
+	if (newPos > UncompressedSize)
+		return false;
+
+	// nothing gets decompressed until the next read
+	Pos = newPos;
+	return true;
+}
+
+
+bool CZipEntryReadFile::restart()
+{
+	if (Failed)
+		return false;
+
+	bool ok = false;
+	switch (Method)
+	{
+#ifdef _IRR_COMPILE_WITH_ZLIB_
+		case ECM_DEFLATE:
+			ok = inflateReset(&Decoder->Inflate)==Z_OK;
+			break;
+#endif
+#ifdef _IRR_COMPILE_WITH_BZIP2_
+		case ECM_BZIP2:
+			BZ2_bzDecompressEnd(&Decoder->Bunzip);
+			memset(&Decoder->Bunzip, 0, sizeof(bz_stream));
+			ok = BZ2_bzDecompressInit(&Decoder->Bunzip, 0, 0)==BZ_OK;
+			break;
+#endif
+#ifdef _IRR_COMPILE_WITH_LZMA_
+		case ECM_LZMA:
+			LzmaDec_Init(&Decoder->Lzma);
+			ok = true;
+			break;
+#endif
+		default:
+			break;
+	}
+	if (!ok)
+	{
+		fail();
+		return false;
+	}
+
+	InputPos = Decoder->HeaderSize;
+	InputBegin = InputEnd = 0u;
+	WindowStart = WindowFill = 0u;
+	StreamEnd = false;
+	return true;
+}
+
+
+size_t CZipEntryReadFile::decompress(uint8_t* out, size_t size)
+{
+	const size_t decompressed = WindowStart+WindowFill;
+	size = core::min_<size_t>(size, UncompressedSize-decompressed);
+
+	size_t produced = 0u;
+	while (produced < size && !StreamEnd && !Failed)
+	{
+		if (InputBegin == InputEnd && InputPos < CompressedSize)
+		{
+			File->seek(DataStart+InputPos);
+			const int32_t r = File->read(Input.data(), core::min_<size_t>(Input.size(), CompressedSize-InputPos));
+			if (r <= 0)
+			{
+				fail();
+				break;
+			}
+			InputBegin = 0u;
+			InputEnd = r;
+			InputPos += r;
+		}
+
+		const size_t inAvailable = InputEnd-InputBegin;
+		// the decompressors take 32bit sizes
+		const size_t outAvailable = core::min_<size_t>(size-produced, 0x40000000u);
+		size_t consumed = 0u, written = 0u;
+		switch (Method)
+		{
+#ifdef _IRR_COMPILE_WITH_ZLIB_
+			case ECM_DEFLATE:
+				{
+					z_stream& stream = Decoder->Inflate;
+					stream.next_in = reinterpret_cast<Bytef*>(Input.data()+InputBegin);
+					stream.avail_in = static_cast<uInt>(inAvailable);
+					stream.next_out = reinterpret_cast<Bytef*>(out+produced);
+					stream.avail_out = static_cast<uInt>(outAvailable);
+					const int err = inflate(&stream, Z_NO_FLUSH);
+					consumed = inAvailable-stream.avail_in;
+					written = outAvailable-stream.avail_out;
+					if (err == Z_STREAM_END)
+						StreamEnd = true;
+					else if (err != Z_OK && err != Z_BUF_ERROR)
+						fail();
+				}
+				break;
+#endif
+#ifdef _IRR_COMPILE_WITH_BZIP2_
+			case ECM_BZIP2:
+				{
+					bz_stream& stream = Decoder->Bunzip;
+					stream.next_in = reinterpret_cast<char*>(Input.data()+InputBegin);
+					stream.avail_in = static_cast<unsigned int>(inAvailable);
+					stream.next_out = reinterpret_cast<char*>(out+produced);
+					stream.avail_out = static_cast<unsigned int>(outAvailable);
+					const int err = BZ2_bzDecompress(&stream);
+					consumed = inAvailable-stream.avail_in;
+					written = outAvailable-stream.avail_out;
+					if (err == BZ_STREAM_END)
+						StreamEnd = true;
+					else if (err != BZ_OK)
+						fail();
+				}
+				break;
+#endif
+#ifdef _IRR_COMPILE_WITH_LZMA_
+			case ECM_LZMA:
+				{
+					SizeT inSize = inAvailable;
+					SizeT outSize = outAvailable;
+					ELzmaStatus status;
+					const SRes err = LzmaDec_DecodeToBuf(&Decoder->Lzma, out+produced, &outSize, Input.data()+InputBegin, &inSize, LZMA_FINISH_ANY, &status);
+					consumed = inSize;
+					written = outSize;
+					if (err != SZ_OK)
+						fail();
+					else if (status == LZMA_STATUS_FINISHED_WITH_MARK)
+						StreamEnd = true;
+				}
+				break;
+#endif
+			default:
+				fail();
+				break;
+		}
+
+		InputBegin += consumed;
+		produced += written;
+		// truncated entry, the decompressor wants more input than there is
+		if (!consumed && !written && InputBegin == InputEnd && InputPos >= CompressedSize)
+			StreamEnd = true;
+	}
+
+	return produced;
+}
+
+
+void CZipEntryReadFile::fail()
+{
+	if (!Failed)
+		os::Printer::log("Error decompressing", Filename.c_str(), ELL_ERROR);
+	Failed = true;
+}
+
+
+} // end namespace io
+} // end namespace irr
@@ -0,0 +1,96 @@
+#ifndef __C_ZIP_ENTRY_READ_FILE_H_INCLUDED__
+#define __C_ZIP_ENTRY_READ_FILE_H_INCLUDED__
+
+#include "IReadFile.h"
+#include "irr/core/Types.h"
+#include "irr/core/irrString.h"
+
+namespace irr
+{
+
+namespace io
+{
+
+	/*!
+		Read file over a compressed entry of an archive, the entry is decompressed lazily while it is being read.
+		Only a bounded window of decompressed data is kept, so the memory needed does not depend on the size of the entry.
+		Seeking forward is free until the next read which then decompresses up to the new position,
+		seeking back before the window restarts decompression from the beginning of the entry.
+		Reads larger than the window are decompressed straight into the caller's buffer.
+	*/
+	class CZipEntryReadFile : public IReadFile
+	{
+        protected:
+            virtual ~CZipEntryReadFile();
+
+        public:
+            //! Compression methods as numbered by the ZIP format
+            enum E_COMPRESSION_METHOD
+            {
+                ECM_DEFLATE = 8,
+                ECM_BZIP2 = 12,
+                ECM_LZMA = 14
+            };
+
+            //! `compressedFile` is grabbed and seeked to `offset` before every read, so it can be shared with other readers
+            CZipEntryReadFile(IReadFile* compressedFile, const size_t& offset, const size_t& compressedSize, const size_t& uncompressedSize, E_COMPRESSION_METHOD method, const io::path& name);
+
+            //! returns how much was read
+            virtual int32_t read(void* buffer, uint32_t sizeToRead) override;
+
+            //! changes position in file, returns true if successful
+            virtual bool seek(const size_t& finalPos, bool relativeMovement = false) override;
+
+            //! returns size of file
+            virtual size_t getSize() const override { return UncompressedSize; }
+
+            //! returns if the decompressor could be set up for the entry
+            virtual bool isOpen() const { return Decoder != nullptr; }
+
+            //! returns where in the file we are.
+            virtual size_t getPos() const override { return Pos; }
+
+            //! returns name of file
+            virtual const io::path& getFileName() const override { return Filename; }
+
+        private:
+            //! holds the zlib, bzip2 or LZMA state, so that their headers stay out of this one
+            struct SDecoder;
+
+            _IRR_STATIC_INLINE_CONSTEXPR size_t InputBufferSize = 0x8000u;
+            _IRR_STATIC_INLINE_CONSTEXPR size_t WindowSize = 0x10000u;
+
+            //! rewinds to the first byte of the entry
+            bool restart();
+
+            //! decompresses up to `size` bytes following the ones already decompressed into `out`, @returns how many were written
+            size_t decompress(uint8_t* out, size_t size);
+
+            //! logs the first error only and stops all further decompression
+            void fail();
+
+            io::path Filename;
+            IReadFile* File;
+            size_t DataStart;
+            size_t CompressedSize;
+            size_t UncompressedSize;
+            E_COMPRESSION_METHOD Method;
+            SDecoder* Decoder;
+
+            size_t Pos;
+            //! compressed bytes taken from File so far, and the ones not yet consumed by the decoder
+            size_t InputPos;
+            size_t InputBegin, InputEnd;
+            core::vector<uint8_t> Input;
+            //! decompressed bytes [WindowStart,WindowStart+WindowFill) of the entry, everything before is gone
+            size_t WindowStart;
+            size_t WindowFill;
+            core::vector<uint8_t> Window;
+            bool StreamEnd;
+            bool Failed;
+	};
+
+} // end namespace io
+} // end namespace irr
+
+#endif
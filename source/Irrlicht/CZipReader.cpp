@@ -5,6 +5,7 @@
 #include "CZipReader.h"
 #include "CMemoryFile.h"
 #include "CLimitReadFile.h"
+#include "CZipEntryReadFile.h"
 
 #include "os.h"
 #include <sstream>
@@ -25,25 +26,9 @@ extern "C" void bz_internal_error(int errorCode)
 
 #include "IrrCompileConfig.h"
 #ifdef _IRR_COMPILE_WITH_ZLIB_
-	#ifndef _IRR_USE_NON_SYSTEM_ZLIB_
-	#include <zlib.h> // use system lib
-	#else
-	#include "zlib/zlib.h"
-	#endif
-
 	#ifdef _IRR_COMPILE_WITH_ZIP_ENCRYPTION_
 	#include "aesGladman/fileenc.h"
 	#endif
-	#ifdef _IRR_COMPILE_WITH_BZIP2_
-	#ifndef _IRR_USE_NON_SYSTEM_BZLIB_
-	#include <bzlib.h>
-	#else
-	#include "bzip2/bzlib.h"
-	#endif
-	#endif
-	#ifdef _IRR_COMPILE_WITH_LZMA_
-	#include "lzma/LzmaDec.h"
-	#endif
 #endif
 
 namespace irr
@@ -156,8 +141,10 @@ CZipReader::CZipReader(IReadFile* file, bool ignoreCase, bool ignorePaths, bool
 		// load file entries
 		if (IsGZip)
 			while (scanGZipHeader()) { }
-		else
+		else if (!readCentralDirectory())
 			while (scanZipHeader()) { }
+
+		buildFileIndex();
 	}
 }
 
@@ -187,6 +174,7 @@ bool CZipReader::scanGZipHeader()
 {
 	SZipFileEntry entry;
 	entry.Offset = 0;
+	entry.LocalHeaderOffset = 0;
 	memset(&entry.header, 0, sizeof(SZIPFileHeader));
 
 	// read header
@@ -296,6 +284,7 @@ bool CZipReader::scanZipHeader(bool ignoreGPBits)
 	io::path ZipFileName = "";
 	SZipFileEntry entry;
 	entry.Offset = 0;
+	entry.LocalHeaderOffset = File->getPos();
 	memset(&entry.header, 0, sizeof(SZIPFileHeader));
 
 	File->read(&entry.header, sizeof(SZIPFileHeader));
@@ -480,12 +469,232 @@ bool CZipReader::scanCentralDirectoryHeader()
 }
 
 
+bool CZipReader::readCentralDirectory()
+{
+	const size_t fileSize = File->getSize();
+	if (fileSize<sizeof(SZIPFileCentralDirEnd))
+		return false;
+
+	// the end record is followed by a comment of at most 64kb, read everything it could be in at once
+	const size_t tailSize = core::min_<size_t>(fileSize,sizeof(SZIPFileCentralDirEnd64Locator)+sizeof(SZIPFileCentralDirEnd)+0xffffu);
+	const size_t tailStart = fileSize-tailSize;
+	core::vector<uint8_t> tail(tailSize);
+	File->seek(tailStart);
+	if (File->read(tail.data(), tailSize)!=int32_t(tailSize))
+		return false;
+
+	// search backwards, the comment has to fit between the record and the end of the file
+	SZIPFileCentralDirEnd dirEnd;
+	size_t dirEndPos = tailSize-sizeof(SZIPFileCentralDirEnd)+1u;
+	do
+	{
+		if (dirEndPos--==0u)
+			return false;
+
+		memcpy(&dirEnd, tail.data()+dirEndPos, sizeof(dirEnd));
+#ifdef __BIG_ENDIAN__
+		dirEnd.Sig = os::Byteswap::byteswap(dirEnd.Sig);
+		dirEnd.CommentLength = os::Byteswap::byteswap(dirEnd.CommentLength);
+#endif
+	} while (dirEnd.Sig!=0x06054b50 || dirEndPos+sizeof(dirEnd)+dirEnd.CommentLength>tailSize);
+
+#ifdef __BIG_ENDIAN__
+	dirEnd.NumberDisk = os::Byteswap::byteswap(dirEnd.NumberDisk);
+	dirEnd.NumberStart = os::Byteswap::byteswap(dirEnd.NumberStart);
+	dirEnd.TotalDisk = os::Byteswap::byteswap(dirEnd.TotalDisk);
+	dirEnd.TotalEntries = os::Byteswap::byteswap(dirEnd.TotalEntries);
+	dirEnd.Size = os::Byteswap::byteswap(dirEnd.Size);
+	dirEnd.Offset = os::Byteswap::byteswap(dirEnd.Offset);
+#endif
+	// multi-disk archives are not supported
+	if (dirEnd.NumberDisk!=dirEnd.NumberStart || dirEnd.TotalDisk!=dirEnd.TotalEntries)
+		return false;
+
+	uint64_t entryCount = dirEnd.TotalEntries;
+	uint64_t dirSize = dirEnd.Size;
+	uint64_t dirOffset = dirEnd.Offset;
+	// archives with more than 65535 entries or over 4GB keep the real values in the zip64 end record
+	if (dirEndPos>=sizeof(SZIPFileCentralDirEnd64Locator))
+	{
+		SZIPFileCentralDirEnd64Locator locator;
+		memcpy(&locator, tail.data()+dirEndPos-sizeof(locator), sizeof(locator));
+#ifdef __BIG_ENDIAN__
+		locator.Sig = os::Byteswap::byteswap(locator.Sig);
+		locator.Offset = os::Byteswap::byteswap(locator.Offset);
+#endif
+		if (locator.Sig==0x07064b50)
+		{
+			SZIPFileCentralDirEnd64 dirEnd64;
+			if (locator.Offset>fileSize || fileSize-locator.Offset<sizeof(dirEnd64))
+				return false;
+			File->seek(locator.Offset);
+			if (File->read(&dirEnd64, sizeof(dirEnd64))!=int32_t(sizeof(dirEnd64)))
+				return false;
+#ifdef __BIG_ENDIAN__
+			dirEnd64.Sig = os::Byteswap::byteswap(dirEnd64.Sig);
+			dirEnd64.TotalEntries = os::Byteswap::byteswap(dirEnd64.TotalEntries);
+			dirEnd64.Size = os::Byteswap::byteswap(dirEnd64.Size);
+			dirEnd64.Offset = os::Byteswap::byteswap(dirEnd64.Offset);
+#endif
+			if (dirEnd64.Sig!=0x06064b50)
+				return false;
+			entryCount = dirEnd64.TotalEntries;
+			dirSize = dirEnd64.Size;
+			dirOffset = dirEnd64.Offset;
+		}
+	}
+
+	// IReadFile reads at most 2GB at once, and the entries have 32bit offsets anyway
+	if (dirSize>fileSize || dirOffset>fileSize-dirSize || dirSize>0x7fffffffull || entryCount>dirSize/sizeof(SZIPFileCentralDirFileHeader))
+		return false;
+
+	core::vector<uint8_t> directory(dirSize);
+	File->seek(dirOffset);
+	if (File->read(directory.data(), dirSize)!=int32_t(dirSize))
+		return false;
+
+	core::vector<SZipFileEntry> fileInfo(entryCount);
+	core::vector<SFileListEntry> files;
+	files.reserve(entryCount);
+	size_t pos = 0u;
+	for (size_t i=0u; i<entryCount; i++)
+	{
+		SZIPFileCentralDirFileHeader header;
+		if (pos+sizeof(header)>dirSize)
+			return false;
+		memcpy(&header, directory.data()+pos, sizeof(header));
+#ifdef __BIG_ENDIAN__
+		header.Sig = os::Byteswap::byteswap(header.Sig);
+		header.VersionToExtract = os::Byteswap::byteswap(header.VersionToExtract);
+		header.GeneralBitFlag = os::Byteswap::byteswap(header.GeneralBitFlag);
+		header.CompressionMethod = os::Byteswap::byteswap(header.CompressionMethod);
+		header.LastModFileTime = os::Byteswap::byteswap(header.LastModFileTime);
+		header.LastModFileDate = os::Byteswap::byteswap(header.LastModFileDate);
+		header.CRC32 = os::Byteswap::byteswap(header.CRC32);
+		header.CompressedSize = os::Byteswap::byteswap(header.CompressedSize);
+		header.UncompressedSize = os::Byteswap::byteswap(header.UncompressedSize);
+		header.FilenameLength = os::Byteswap::byteswap(header.FilenameLength);
+		header.ExtraFieldLength = os::Byteswap::byteswap(header.ExtraFieldLength);
+		header.FileCommentLength = os::Byteswap::byteswap(header.FileCommentLength);
+		header.RelativeOffsetOfLocalHeader = os::Byteswap::byteswap(header.RelativeOffsetOfLocalHeader);
+#endif
+		const size_t namePos = pos+sizeof(header);
+		const size_t extraPos = namePos+header.FilenameLength;
+		pos = extraPos+header.ExtraFieldLength+header.FileCommentLength;
+		if (header.Sig!=0x02014b50 || pos>dirSize)
+			return false;
+
+		SZipFileEntry& entry = fileInfo[i];
+		memset(&entry.header, 0, sizeof(SZIPFileHeader));
+		entry.Offset = -1;
+		entry.LocalHeaderOffset = header.RelativeOffsetOfLocalHeader;
+		entry.header.Sig = 0x04034b50;
+		entry.header.VersionToExtract = header.VersionToExtract;
+		entry.header.GeneralBitFlag = header.GeneralBitFlag;
+		entry.header.CompressionMethod = header.CompressionMethod;
+		entry.header.LastModFileTime = header.LastModFileTime;
+		entry.header.LastModFileDate = header.LastModFileDate;
+		entry.header.DataDescriptor.CRC32 = header.CRC32;
+		entry.header.DataDescriptor.CompressedSize = header.CompressedSize;
+		entry.header.DataDescriptor.UncompressedSize = header.UncompressedSize;
+		entry.header.FilenameLength = header.FilenameLength;
+
+		bool tooLarge = false;
+		for (size_t extra=extraPos; extra+sizeof(SZipFileExtraHeader)<=extraPos+header.ExtraFieldLength;)
+		{
+			SZipFileExtraHeader extraHeader;
+			memcpy(&extraHeader, directory.data()+extra, sizeof(extraHeader));
+#ifdef __BIG_ENDIAN__
+			extraHeader.ID = os::Byteswap::byteswap(extraHeader.ID);
+			extraHeader.Size = os::Byteswap::byteswap(extraHeader.Size);
+#endif
+			extra += sizeof(extraHeader);
+			const uint16_t extraSize = extraHeader.Size;
+			if (extra+extraSize>extraPos+header.ExtraFieldLength)
+				break;
+
+			// zip64 extended information, only present when a 32bit field overflowed
+			if (extraHeader.ID==0x0001)
+				tooLarge = header.UncompressedSize==0xffffffffu || header.CompressedSize==0xffffffffu || header.RelativeOffsetOfLocalHeader==0xffffffffu;
+#ifdef _IRR_COMPILE_WITH_ZIP_ENCRYPTION_
+			// AES encryption, encoded into Sig the same way as scanZipHeader does
+			else if (extraHeader.ID==(int16_t)0x9901 && extraSize>=sizeof(SZipFileAESExtraData) && (header.GeneralBitFlag & ZIP_FILE_ENCRYPTED) && header.CompressionMethod==99)
+			{
+				SZipFileAESExtraData data;
+				memcpy(&data, directory.data()+extra, sizeof(data));
+#ifdef __BIG_ENDIAN__
+				data.Version = os::Byteswap::byteswap(data.Version);
+				data.CompressionMode = os::Byteswap::byteswap(data.CompressionMode);
+#endif
+				if (data.Vendor[0]=='A' && data.Vendor[1]=='E')
+					entry.header.Sig =
+						((data.Version & 0xff) << 24) |
+						(data.EncryptionStrength << 16) |
+						(data.CompressionMode);
+			}
+#endif
+			extra += extraSize;
+		}
+
+		const io::path zipFileName(reinterpret_cast<const char*>(directory.data()+namePos), header.FilenameLength);
+		if (tooLarge)
+		{
+			os::Printer::log("File in ZIP archive exceeds 4GB, skipping", zipFileName.c_str(), ELL_WARNING);
+			continue;
+		}
+		files.push_back(createEntry(zipFileName, header.RelativeOffsetOfLocalHeader, header.UncompressedSize, zipFileName.lastChar()=='/', i));
+	}
+
+	FileInfo.swap(fileInfo);
+	Files.swap(files);
+	sortFiles();
+	return true;
+}
+
+
+bool CZipReader::resolveDataOffset(SZipFileEntry& entry)
+{
+	SZIPFileHeader header;
+	File->seek(entry.LocalHeaderOffset);
+	if (File->read(&header, sizeof(header))!=int32_t(sizeof(header)))
+		return false;
+#ifdef __BIG_ENDIAN__
+	header.Sig = os::Byteswap::byteswap(header.Sig);
+	header.FilenameLength = os::Byteswap::byteswap(header.FilenameLength);
+	header.ExtraFieldLength = os::Byteswap::byteswap(header.ExtraFieldLength);
+#endif
+	if (header.Sig!=0x04034b50)
+		return false;
+
+	// the extra field of the local header can differ from the one in the central directory
+	entry.Offset = entry.LocalHeaderOffset+sizeof(header)+uint16_t(header.FilenameLength)+uint16_t(header.ExtraFieldLength);
+	return true;
+}
+
+
+void CZipReader::buildFileIndex()
+{
+	FileIndex.clear();
+	FileIndex.reserve(Files.size());
+	for (uint32_t i=0u; i<Files.size(); i++)
+	if (!Files[i].IsDirectory)
+		FileIndex.insert(Files[i].FullName.c_str(), i);
+}
+
+
 //! opens a file by file name
 IReadFile* CZipReader::createAndOpenFile(const io::path& filename)
-{
-    auto found = findFile(Files.begin(),Files.end(),filename,false);
-	if (found==Files.end())
-        return nullptr;
+{
+	io::path fullName = filename;
+	bool isDirectory = false;
+	normalizeFileName(fullName,isDirectory);
+	if (isDirectory)
+		return nullptr;
+
+	const uint32_t* fileIx = FileIndex.find(fullName.c_str());
+	if (!fileIx)
+		return nullptr;
+	const SFileListEntry* found = &Files[*fileIx];
 
 	// Irrlicht supports 0, 8, 12, 14, 99
 	//0 - The file is stored (no compression)
@@ -506,7 +715,12 @@ IReadFile* CZipReader::createAndOpenFile(const io::path& filename)
 	//98 - PPMd - Compression Method, WinZip 10
 	//99 - AES encryption, WinZip 9
 
-	const SZipFileEntry &e = FileInfo[found->ID];
+	SZipFileEntry &e = FileInfo[found->ID];
+	if (e.Offset<0 && !resolveDataOffset(e))
+	{
+		os::Printer::log("Could not read the local file header in ZIP archive", found->FullName.c_str(), ELL_ERROR);
+		return nullptr;
+	}
 	wchar_t buf[64];
 	int16_t actualCompressionMethod=e.header.CompressionMethod;
 	IReadFile* decrypted=0;
@@ -600,232 +814,26 @@ IReadFile* CZipReader::createAndOpenFile(const io::path& filename)
                 return new CLimitReadFile(File, e.Offset, decryptedSize, found->FullName);
 		}
 	case 8:
-		{
-  			#ifdef _IRR_COMPILE_WITH_ZLIB_
-
-			const uint32_t uncompressedSize = e.header.DataDescriptor.UncompressedSize;
-			char* pBuf = new char[ uncompressedSize ];
-			if (!pBuf)
-			{
-				swprintf ( buf, 64, L"Not enough memory for decompressing %s", found->FullName.c_str() );
-				os::Printer::log( buf, ELL_ERROR);
-                delete[] decryptedBuf;
-				if (decrypted)
-					decrypted->drop();
-				return 0;
-			}
-
-			uint8_t *pcData = decryptedBuf;
-			if (!pcData)
-			{
-				pcData = new uint8_t[decryptedSize];
-				if (!pcData)
-				{
-					swprintf ( buf, 64, L"Not enough memory for decompressing %s", found->FullName.c_str() );
-					os::Printer::log( buf, ELL_ERROR);
-                    delete[] decryptedBuf;
-					delete [] pBuf;
-					return 0;
-				}
-
-				//memset(pcData, 0, decryptedSize);
-				File->seek(e.Offset);
-				File->read(pcData, decryptedSize);
-			}
-
-			// Setup the inflate stream.
-			z_stream stream;
-			int32_t err;
-
-			stream.next_in = (Bytef*)pcData;
-			stream.avail_in = (uInt)decryptedSize;
-			stream.next_out = (Bytef*)pBuf;
-			stream.avail_out = uncompressedSize;
-			stream.zalloc = (alloc_func)0;
-			stream.zfree = (free_func)0;
-
-			// Perform inflation. wbits < 0 indicates no zlib header inside the data.
-			err = inflateInit2(&stream, -MAX_WBITS);
-			if (err == Z_OK)
-			{
-				err = inflate(&stream, Z_FINISH);
-				inflateEnd(&stream);
-				if (err == Z_STREAM_END)
-					err = Z_OK;
-				err = Z_OK;
-				inflateEnd(&stream);
-			}
-
-			if (decrypted)
-				decrypted->drop();
-			else
-				delete[] pcData;
-
-            delete[] decryptedBuf;
-			if (err != Z_OK)
-			{
-				swprintf ( buf, 64, L"Error decompressing %s", found->FullName.c_str() );
-				os::Printer::log( buf, ELL_ERROR);
-				delete [] pBuf;
-				return 0;
-			}
-            else
-            {
-                auto ret = new io::CMemoryReadFile(pBuf, uncompressedSize, found->FullName);
-                delete[] pBuf;
-                return ret;
-            }
-
-			#else
-			return 0; // zlib not compiled, we cannot decompress the data.
-			#endif
-		}
 	case 12:
+	case 14:
 		{
-  			#ifdef _IRR_COMPILE_WITH_BZIP2_
-
-			const uint32_t uncompressedSize = e.header.DataDescriptor.UncompressedSize;
-			char* pBuf = new char[ uncompressedSize ];
-			if (!pBuf)
-			{
-				swprintf ( buf, 64, L"Not enough memory for decompressing %s", found->FullName.c_str() );
-				os::Printer::log( buf, ELL_ERROR);
-                delete[] decryptedBuf;
-				if (decrypted)
-					decrypted->drop();
-				return 0;
-			}
-
-			uint8_t *pcData = decryptedBuf;
-			if (!pcData)
-			{
-				pcData = new uint8_t[decryptedSize];
-				if (!pcData)
-				{
-					swprintf ( buf, 64, L"Not enough memory for decompressing %s", found->FullName.c_str() );
-					os::Printer::log( buf, ELL_ERROR);
-					delete [] pBuf;
-                    delete[] decryptedBuf;
-					return 0;
-				}
-
-				//memset(pcData, 0, decryptedSize);
-				File->seek(e.Offset);
-				File->read(pcData, decryptedSize);
-			}
-
-			bz_stream bz_ctx={0};
-			/* use BZIP2's default memory allocation
-			bz_ctx->bzalloc = NULL;
-			bz_ctx->bzfree  = NULL;
-			bz_ctx->opaque  = NULL;
-			*/
-			int err = BZ2_bzDecompressInit(&bz_ctx, 0, 0); /* decompression */
-			if(err != BZ_OK)
-			{
-				os::Printer::log("bzip2 decompression failed. File cannot be read.", ELL_ERROR);
-                delete[] decryptedBuf;
-				return 0;
-			}
-			bz_ctx.next_in = (char*)pcData;
-			bz_ctx.avail_in = decryptedSize;
-			/* pass all input to decompressor */
-			bz_ctx.next_out = pBuf;
-			bz_ctx.avail_out = uncompressedSize;
-			err = BZ2_bzDecompress(&bz_ctx);
-			err = BZ2_bzDecompressEnd(&bz_ctx);
+			// decompressed while being read, an encrypted entry only has its compressed data in memory
+			IReadFile* compressed = decrypted ? decrypted:File;
+			const size_t offset = decrypted ? 0u:size_t(e.Offset);
+			delete[] decryptedBuf;
 
+			CZipEntryReadFile* file = new CZipEntryReadFile(compressed, offset, decryptedSize, e.header.DataDescriptor.UncompressedSize,
+															static_cast<CZipEntryReadFile::E_COMPRESSION_METHOD>(actualCompressionMethod), found->FullName);
 			if (decrypted)
 				decrypted->drop();
-			else
-				delete[] pcData;
-
-			if (err != BZ_OK)
+			if (!file->isOpen())
 			{
 				swprintf ( buf, 64, L"Error decompressing %s", found->FullName.c_str() );
 				os::Printer::log( buf, ELL_ERROR);
-				delete [] pBuf;
-                delete[] decryptedBuf;
-				return 0;
-			}
-            else
-            {
-                auto ret = new io::CMemoryReadFile(pBuf, uncompressedSize, found->FullName);
-                delete[] pBuf;
-                return ret;
-            }
-
-			#else
-            delete[] decryptedBuf;
-			os::Printer::log("bzip2 decompression not supported. File cannot be read.", ELL_ERROR);
-			return 0;
-			#endif
-		}
-	case 14:
-		{
-  			#ifdef _IRR_COMPILE_WITH_LZMA_
-
-			uint32_t uncompressedSize = e.header.DataDescriptor.UncompressedSize;
-			char* pBuf = new char[ uncompressedSize ];
-			if (!pBuf)
-			{
-				swprintf ( buf, 64, L"Not enough memory for decompressing %s", found->FullName.c_str() );
-				os::Printer::log( buf, ELL_ERROR);
-                delete[] decryptedBuf;
-				if (decrypted)
-					decrypted->drop();
-				return 0;
-			}
-
-			uint8_t *pcData = decryptedBuf;
-			if (!pcData)
-			{
-				pcData = new uint8_t[decryptedSize];
-				if (!pcData)
-				{
-					swprintf ( buf, 64, L"Not enough memory for decompressing %s", found->FullName.c_str() );
-					os::Printer::log( buf, ELL_ERROR);
-					delete [] pBuf;
-					return 0;
-				}
-
-				//memset(pcData, 0, decryptedSize);
-				File->seek(e.Offset);
-				File->read(pcData, decryptedSize);
-			}
-
-			ELzmaStatus status;
-			SizeT tmpDstSize = uncompressedSize;
-			SizeT tmpSrcSize = decryptedSize;
-
-			unsigned int propSize = (pcData[3]<<8)+pcData[2];
-			int err = LzmaDecode((Byte*)pBuf, &tmpDstSize,
-					pcData+4+propSize, &tmpSrcSize,
-					pcData+4, propSize,
-					e.header.GeneralBitFlag&0x1?LZMA_FINISH_END:LZMA_FINISH_ANY, &status,
-					&lzmaAlloc);
-			uncompressedSize = tmpDstSize; // may be different to expected value
-
-			if (decrypted)
-				decrypted->drop();
-			else
-				delete[] pcData;
-
-            delete[] decryptedBuf;
-			if (err != SZ_OK)
-			{
-				os::Printer::log( "Error decompressing", found->FullName, ELL_ERROR);
-				delete [] pBuf;
+				file->drop();
 				return 0;
 			}
-			else
-				return io::createMemoryReadFile(pBuf, uncompressedSize, found->FullName, true);
-
-			#else
-            delete[] decryptedBuf;
-			os::Printer::log("lzma decompression not supported. File cannot be read.", ELL_ERROR);
-			return 0;
-			#endif
+			return file;
 		}
 	case 99:
 		// If we come here with an encrypted file, decryption support is missing
@@ -840,16 +848,6 @@ IReadFile* CZipReader::createAndOpenFile(const io::path& filename)
 	};
 }
 
-#ifdef _IRR_COMPILE_WITH_LZMA_
-//! Used for LZMA decompression. The lib has no default memory management
-namespace
-{
-	void *SzAlloc(void *p, size_t size) { p = p; return _IRR_ALIGNED_MALLOC(size,_IRR_SIMD_ALIGNMENT); }
-	void SzFree(void *p, void *address) { p = p; _IRR_ALIGNED_FREE(address); }
-	ISzAlloc lzmaAlloc = { SzAlloc, SzFree };
-}
-#endif
-
 } // end namespace io
 } // end namespace irr
 
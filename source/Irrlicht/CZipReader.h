@@ -13,6 +13,7 @@
 #include "IReadFile.h"
 #include "IFileSystem.h"
 #include "CFileList.h"
+#include "irr/core/flat_hash_map.h"
 
 namespace irr
 {
@@ -88,6 +89,29 @@ namespace io
 		// zipfile comment (variable size)
 	} PACK_STRUCT;
 
+	struct SZIPFileCentralDirEnd64Locator
+	{
+		uint32_t Sig;			// 'PK0607' zip64 end of central dir locator signature (0x07064b50)
+		uint32_t NumberStart;	// number of the disk with the start of the zip64 end of central directory
+		uint64_t Offset;			// offset of the zip64 end of central directory record
+		uint32_t TotalDisks;		// total number of disks
+	} PACK_STRUCT;
+
+	struct SZIPFileCentralDirEnd64
+	{
+		uint32_t Sig;			// 'PK0606' zip64 end of central dir signature (0x06064b50)
+		uint64_t RecordSize;		// size of the rest of this record
+		uint16_t VersionMadeBy;
+		uint16_t VersionToExtract;
+		uint32_t NumberDisk;		// number of this disk
+		uint32_t NumberStart;	// number of the disk with the start of the central directory
+		uint64_t TotalDisk;		// total number of entries in the central dir on this disk
+		uint64_t TotalEntries;	// total number of entries in the central dir
+		uint64_t Size;			// size of the central directory
+		uint64_t Offset;			// offset of start of central directory with respect to the starting disk number
+		// zip64 extensible data sector (variable size)
+	} PACK_STRUCT;
+
 	struct SZipFileExtraHeader
 	{
 		int16_t ID;
@@ -127,9 +151,12 @@ namespace io
 	//! Contains extended info about zip files in the archive
 	struct SZipFileEntry
 	{
-		//! Position of data in the archive file
+		//! Position of data in the archive file, -1 until the local header has been read
 		int32_t Offset;
 
+		//! Position of the local file header in the archive file
+		uint32_t LocalHeaderOffset;
+
 		//! The header for this file containing compression info etc
 		SZIPFileHeader header;
 	};
@@ -206,11 +233,49 @@ namespace io
 
             bool scanCentralDirectoryHeader();
 
+            //! reads the end of central directory record and the whole central directory with one read each and fills the file list from it
+            /** Returns false if the archive has no usable central directory, the local headers have to be scanned then.
+            Data offsets are left at -1 and resolved by resolveDataOffset when a file gets opened. */
+            bool readCentralDirectory();
+
+            //! reads the local header of `entry` to find where its data starts
+            bool resolveDataOffset(SZipFileEntry& entry);
+
+            //! hashes FullName of every file in the list, needs to be called after the list stops changing
+            void buildFileIndex();
+
+            //! Case insensitive like SFileListEntry::operator==
+            struct SFileNameHash
+            {
+                inline size_t operator()(const char* _name) const
+                {
+                    // FNV-1a
+                    uint64_t hash = 0xcbf29ce484222325ull;
+                    for (; *_name; _name++)
+                    {
+                        hash ^= core::locale_lower(static_cast<uint8_t>(*_name));
+                        hash *= 0x100000001b3ull;
+                    }
+                    return static_cast<size_t>(hash);
+                }
+            };
+            struct SFileNameEqual
+            {
+                inline bool operator()(const char* _a, const char* _b) const
+                {
+                    for (; *_a && core::locale_lower(static_cast<uint8_t>(*_a))==core::locale_lower(static_cast<uint8_t>(*_b)); _a++,_b++) {}
+                    return core::locale_lower(static_cast<uint8_t>(*_a))==core::locale_lower(static_cast<uint8_t>(*_b));
+                }
+            };
+
             IReadFile* File;
 
             // holds extended info about files
             core::vector<SZipFileEntry> FileInfo;
 
+            //! FullName of every file (not directory) to its index in Files, the keys point into Files
+            core::flat_hash_map<const char*,uint32_t,SFileNameHash,SFileNameEqual> FileIndex;
+
             bool IsGZip;
 	};
 
@@ -73,6 +73,7 @@ namespace video
 			RenderTarget->drop();
 
 		RenderTarget = (video::CImage* ) surface;
+		Scissor = viewPort;
 
 		if (RenderTarget)
 		{
@@ -112,6 +113,20 @@ namespace video
 		}
 	}
 
+	//! takes over texture state another shader got from setTextureParam
+	void IBurningShader::setTextureParam( uint32_t stage, const sInternalTexture& texture )
+	{
+		sInternalTexture *it = &IT[stage];
+
+		if ( texture.Texture )
+			texture.Texture->grab();
+
+		if ( it->Texture )
+			it->Texture->drop();
+
+		*it = texture;
+	}
+
 
 } // end namespace video
 } // end namespace irr
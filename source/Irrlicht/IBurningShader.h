@@ -13,6 +13,7 @@
 #include "rect.h"
 #include "CDepthBuffer.h"
 #include "S4DVertex.h"
+#include "SoftwareDriver2_simd.h"
 #include "SMaterial.h"
 #include "os.h"
 
@@ -63,6 +64,7 @@ namespace video
 	enum EBurningFFShader
 	{
 		ETR_GOURAUD=0,
+		ETR_GOURAUD_ALPHA_NOZ,
 		ETR_TEXTURE_GOURAUD,
 		ETR_TEXTURE_GOURAUD_NOZ,
 		ETR_TEXTURE_GOURAUD_ADD,
@@ -91,6 +93,15 @@ namespace video
 
 		//! sets the Texture
 		virtual void setTextureParam( uint32_t stage, video::CSoftwareTexture2* texture, int32_t lodLevel);
+
+		//! takes over texture state another shader got from setTextureParam, so tile workers can share it; the texture is grabbed and the previous one dropped
+		virtual void setTextureParam( uint32_t stage, const sInternalTexture& texture );
+		const sInternalTexture& getTextureParam( uint32_t stage ) const { return IT[stage]; }
+
+		//! only pixels inside of the rectangle get rasterized, setRenderTarget resets it to the viewport
+		void setScissor ( const core::rect<int32_t>& scissor ) { Scissor = scissor; }
+		const core::rect<int32_t>& getScissor () const { return Scissor; }
+
 		virtual void drawTriangle ( const s4DVertex *a,const s4DVertex *b,const s4DVertex *c ) = 0;
 		virtual void drawLine ( const s4DVertex *a,const s4DVertex *b) {};
 
@@ -106,6 +117,7 @@ namespace video
 		CBurningVideoDriver *Driver;
 
 		video::CImage* RenderTarget;
+		core::rect<int32_t> Scissor;
 		CDepthBuffer* DepthBuffer;
 		CStencilBuffer * Stencil;
 		tVideoSample ColorMask;
@@ -120,6 +132,7 @@ namespace video
 	IBurningShader* createTriangleRendererTextureVertexAlpha2(CBurningVideoDriver* driver);
 
 	IBurningShader* createTriangleRendererGouraud2(CBurningVideoDriver* driver);
+	IBurningShader* createTRGouraudAlphaNoZ2(CBurningVideoDriver* driver);
 	IBurningShader* createTRTextureGouraudNoZ2(CBurningVideoDriver* driver);
 	IBurningShader* createTRTextureGouraudAdd2(CBurningVideoDriver* driver);
 	IBurningShader* createTRTextureGouraudAddNoZ2(CBurningVideoDriver* driver);
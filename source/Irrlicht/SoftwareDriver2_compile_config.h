@@ -72,6 +72,12 @@
 
 #define SOFTWARE_DRIVER_2_MIPMAPPING_SCALE (8/SOFTWARE_DRIVER_2_MIPMAPPING_MAX)
 
+// span loops doing 4 pixels at once, written for the 32bit w-buffer pixel layout only
+// the fast renderer dithers every texel fetch and stays scalar
+#if defined ( __IRR_COMPILE_WITH_X86_SIMD_ ) && defined ( SOFTWARE_DRIVER_2_32BIT ) && defined ( SOFTWARE_DRIVER_2_USE_WBUFFER ) && !defined ( BURNINGVIDEO_RENDERER_FAST ) && !defined ( __BIG_ENDIAN__ )
+	#define SOFTWARE_DRIVER_2_SIMD_SPANS
+#endif
+
 #ifndef REALINLINE
 	#ifdef _MSC_VER
 		#define REALINLINE __forceinline
@@ -0,0 +1,266 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt / Thomas Alten
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+/*
+	4 pixel wide versions of the helpers in SoftwareDriver2_helper.h and S4DVertex.h,
+	lane i always holds pixel i of the group. Every function does the same integer and
+	float operations in the same order as its scalar counterpart, so a span drawn 4 pixels
+	at a time is bit for bit the one drawn a pixel at a time.
+	This does not hold against the tiled rasterizer, whose spans jump to the scissor edge
+	in one step and so can differ by rounding.
+*/
+
+#ifndef __S_VIDEO_2_SOFTWARE_SIMD_H_INCLUDED__
+#define __S_VIDEO_2_SOFTWARE_SIMD_H_INCLUDED__
+
+#include "SoftwareDriver2_compile_config.h"
+#include "S4DVertex.h"
+
+#ifdef SOFTWARE_DRIVER_2_SIMD_SPANS
+
+namespace irr
+{
+
+/*!
+	hands out `value` and steps it by `slope`, four times
+	the additions are the ones of the pixel loop, so the next span position ends up in `value`
+*/
+REALINLINE __m128 step_x4 ( float &value, const float slope )
+{
+	const float v0 = value;
+	const float v1 = v0 + slope;
+	const float v2 = v1 + slope;
+	const float v3 = v2 + slope;
+	value = v3 + slope;
+	return _mm_setr_ps ( v0, v1, v2, v3 );
+}
+
+/*!
+	same for a whole sVec4, the four values come back transposed
+	so that v0 holds component x of the 4 pixels, v1 component y and so on
+*/
+REALINLINE void step_x4 ( __m128 &v0, __m128 &v1, __m128 &v2, __m128 &v3, video::sVec4 &value, const video::sVec4 &slope )
+{
+	const __m128 step = _mm_loadu_ps ( &slope.x );
+	v0 = _mm_loadu_ps ( &value.x );
+	v1 = _mm_add_ps ( v0, step );
+	v2 = _mm_add_ps ( v1, step );
+	v3 = _mm_add_ps ( v2, step );
+	_mm_storeu_ps ( &value.x, _mm_add_ps ( v3, step ) );
+
+	_MM_TRANSPOSE4_PS ( v0, v1, v2, v3 );
+}
+
+// calculate: 1 / x, like core::reciprocal
+REALINLINE __m128 reciprocal_x4 ( const __m128 x )
+{
+#if defined ( __IRR_FAST_MATH )
+	return _mm_rcp_ps ( x );
+#else
+	return _mm_div_ps ( _mm_set1_ps ( 1.f ), x );
+#endif
+}
+
+// 1/x * FIX_POINT
+REALINLINE __m128 fix_inverse32_x4 ( const __m128 x )
+{
+	return _mm_div_ps ( _mm_set1_ps ( FIX_POINT_F32_MUL ), x );
+}
+
+// convert float to fixpoint, truncating like the cast in tofix
+REALINLINE __m128i tofix_x4 ( const __m128 x, const __m128 mulby )
+{
+	return _mm_cvttps_epi32 ( _mm_mul_ps ( x, mulby ) );
+}
+
+REALINLINE __m128i tofix_x4 ( const __m128 x, const float mulby = FIX_POINT_F32_MUL )
+{
+	return tofix_x4 ( x, _mm_set1_ps ( mulby ) );
+}
+
+// Fix Point Multiply
+REALINLINE __m128i imulFix_x4 ( const __m128i x, const __m128i y )
+{
+	return _mm_srai_epi32 ( _mm_mullo_epi32 ( x, y ), FIX_POINT_PRE );
+}
+
+// clamp FixPoint to maxcolor in FixPoint, min(a,31)
+REALINLINE __m128i clampfix_maxcolor_x4 ( const __m128i a )
+{
+	const __m128i max = _mm_set1_epi32 ( FIXPOINT_COLOR_MAX );
+	const __m128i c = _mm_srai_epi32 ( _mm_sub_epi32 ( a, max ), 31 );
+	return _mm_or_si128 ( _mm_and_si128 ( a, c ), _mm_andnot_si128 ( c, max ) );
+}
+
+// return VideoSample from fixpoint
+REALINLINE __m128i fix_to_color_x4 ( const __m128i r, const __m128i g, const __m128i b )
+{
+	const __m128i max = _mm_set1_epi32 ( FIXPOINT_COLOR_MAX );
+	// alpha is always opaque
+	__m128i color = _mm_set1_epi32 ( (int32_t) MASK_A );
+	color = _mm_or_si128 ( color, _mm_slli_epi32 ( _mm_and_si128 ( r, max ), SHIFT_R - FIX_POINT_PRE ) );
+	color = _mm_or_si128 ( color, _mm_srli_epi32 ( _mm_and_si128 ( g, max ), FIX_POINT_PRE - SHIFT_G ) );
+	color = _mm_or_si128 ( color, _mm_srli_epi32 ( _mm_and_si128 ( b, max ), FIX_POINT_PRE - SHIFT_B ) );
+	return color;
+}
+
+// return VideoSample from fixpoint
+REALINLINE __m128i fix4_to_color_x4 ( const __m128i a, const __m128i r, const __m128i g, const __m128i b )
+{
+	const __m128i max = _mm_set1_epi32 ( FIXPOINT_COLOR_MAX );
+	__m128i color = _mm_slli_epi32 ( _mm_and_si128 ( a, _mm_set1_epi32 ( FIX_POINT_FRACT_MASK - 1 ) ), SHIFT_A - 1 );
+	color = _mm_or_si128 ( color, _mm_slli_epi32 ( _mm_and_si128 ( r, max ), SHIFT_R - FIX_POINT_PRE ) );
+	color = _mm_or_si128 ( color, _mm_srli_epi32 ( _mm_and_si128 ( g, max ), FIX_POINT_PRE - SHIFT_G ) );
+	color = _mm_or_si128 ( color, _mm_srli_epi32 ( _mm_and_si128 ( b, max ), FIX_POINT_PRE - SHIFT_B ) );
+	return color;
+}
+
+// return fixpoint from VideoSample granularity COLOR_MAX
+REALINLINE void color_to_fix_x4 ( __m128i &r, __m128i &g, __m128i &b, const __m128i t00 )
+{
+	r = _mm_srli_epi32 ( _mm_and_si128 ( t00, _mm_set1_epi32 ( MASK_R ) ), SHIFT_R - FIX_POINT_PRE );
+	g = _mm_slli_epi32 ( _mm_and_si128 ( t00, _mm_set1_epi32 ( MASK_G ) ), FIX_POINT_PRE - SHIFT_G );
+	b = _mm_slli_epi32 ( _mm_and_si128 ( t00, _mm_set1_epi32 ( MASK_B ) ), FIX_POINT_PRE - SHIFT_B );
+}
+
+REALINLINE void color_to_fix_x4 ( __m128i &a, __m128i &r, __m128i &g, __m128i &b, const __m128i t00 )
+{
+	a = _mm_srli_epi32 ( _mm_and_si128 ( t00, _mm_set1_epi32 ( (int32_t) MASK_A ) ), SHIFT_A - FIX_POINT_PRE );
+	color_to_fix_x4 ( r, g, b, t00 );
+}
+
+// texel offsets into the texture data, rows and columns wrap like in getTexel_plain
+REALINLINE __m128i texel_row_x4 ( const sInternalTexture * t, const __m128i ty )
+{
+	const __m128i row = _mm_srli_epi32 ( _mm_and_si128 ( ty, _mm_set1_epi32 ( t->textureYMask ) ), FIX_POINT_PRE );
+	return _mm_sll_epi32 ( row, _mm_cvtsi32_si128 ( t->pitchlog2 ) );
+}
+
+REALINLINE __m128i texel_column_x4 ( const sInternalTexture * t, const __m128i tx )
+{
+	return _mm_srli_epi32 ( _mm_and_si128 ( tx, _mm_set1_epi32 ( t->textureXMask ) ), FIX_POINT_PRE - VIDEO_SAMPLE_GRANULARITY );
+}
+
+// there is no gather before AVX2, so the 4 texels get fetched one by one
+REALINLINE __m128i getTexel_x4 ( const sInternalTexture * t, const __m128i ofs )
+{
+	const uint8_t* data = (const uint8_t*) t->data;
+	return _mm_setr_epi32 (
+				*((const tVideoSample*)( data + (uint32_t) _mm_cvtsi128_si32 ( ofs ) )),
+				*((const tVideoSample*)( data + (uint32_t) _mm_extract_epi32 ( ofs, 1 ) )),
+				*((const tVideoSample*)( data + (uint32_t) _mm_extract_epi32 ( ofs, 2 ) )),
+				*((const tVideoSample*)( data + (uint32_t) _mm_extract_epi32 ( ofs, 3 ) ))
+			);
+}
+
+// get video sample plain
+REALINLINE __m128i getTexel_plain_x4 ( const sInternalTexture * t, const __m128i tx, const __m128i ty )
+{
+	return getTexel_x4 ( t, _mm_or_si128 ( texel_row_x4 ( t, ty ), texel_column_x4 ( t, tx ) ) );
+}
+
+#ifndef SOFTWARE_DRIVER_2_BILINEAR
+
+// get Sample linear == getSample_fixpoint
+REALINLINE void getSample_texture_x4 ( __m128i &r, __m128i &g, __m128i &b,
+								const sInternalTexture * t, const __m128i tx, const __m128i ty
+								)
+{
+	color_to_fix_x4 ( r, g, b, getTexel_plain_x4 ( t, tx, ty ) );
+}
+
+REALINLINE void getSample_texture_x4 ( __m128i &a, __m128i &r, __m128i &g, __m128i &b,
+								const sInternalTexture * t, const __m128i tx, const __m128i ty
+								)
+{
+	color_to_fix_x4 ( a, r, g, b, getTexel_plain_x4 ( t, tx, ty ) );
+}
+
+#else
+
+//! the four texels around a bilinear sample and their weights
+struct sBilinearTaps_x4
+{
+	__m128i t00, t10, t01, t11;
+	__m128i w00, w10, w01, w11;
+
+	sBilinearTaps_x4 ( const sInternalTexture * t, const __m128i tx, const __m128i ty )
+	{
+		const __m128i one = _mm_set1_epi32 ( FIX_POINT_ONE );
+		const __m128i o0 = texel_row_x4 ( t, ty );
+		const __m128i o1 = texel_row_x4 ( t, _mm_add_epi32 ( ty, one ) );
+		const __m128i o2 = texel_column_x4 ( t, tx );
+		const __m128i o3 = texel_column_x4 ( t, _mm_add_epi32 ( tx, one ) );
+
+		t00 = getTexel_x4 ( t, _mm_or_si128 ( o0, o2 ) );
+		t10 = getTexel_x4 ( t, _mm_or_si128 ( o0, o3 ) );
+		t01 = getTexel_x4 ( t, _mm_or_si128 ( o1, o2 ) );
+		t11 = getTexel_x4 ( t, _mm_or_si128 ( o1, o3 ) );
+
+		const __m128i fractMask = _mm_set1_epi32 ( FIX_POINT_FRACT_MASK );
+		const __m128i txFract = _mm_and_si128 ( tx, fractMask );
+		const __m128i txFractInv = _mm_sub_epi32 ( one, txFract );
+		const __m128i tyFract = _mm_and_si128 ( ty, fractMask );
+		const __m128i tyFractInv = _mm_sub_epi32 ( one, tyFract );
+
+		// imulFixu
+		w00 = _mm_srli_epi32 ( _mm_mullo_epi32 ( txFractInv, tyFractInv ), FIX_POINT_PRE );
+		w10 = _mm_srli_epi32 ( _mm_mullo_epi32 ( txFract, tyFractInv ), FIX_POINT_PRE );
+		w01 = _mm_srli_epi32 ( _mm_mullo_epi32 ( txFractInv, tyFract ), FIX_POINT_PRE );
+		w11 = _mm_srli_epi32 ( _mm_mullo_epi32 ( txFract, tyFract ), FIX_POINT_PRE );
+	}
+
+	//! weighted sum of the 8 bit channel at `shift`
+	REALINLINE __m128i filter ( const int32_t shift ) const
+	{
+		const __m128i channel = _mm_set1_epi32 ( COLOR_MAX );
+		__m128i sum = _mm_mullo_epi32 ( _mm_and_si128 ( _mm_srli_epi32 ( t00, shift ), channel ), w00 );
+		sum = _mm_add_epi32 ( sum, _mm_mullo_epi32 ( _mm_and_si128 ( _mm_srli_epi32 ( t01, shift ), channel ), w01 ) );
+		sum = _mm_add_epi32 ( sum, _mm_mullo_epi32 ( _mm_and_si128 ( _mm_srli_epi32 ( t10, shift ), channel ), w10 ) );
+		sum = _mm_add_epi32 ( sum, _mm_mullo_epi32 ( _mm_and_si128 ( _mm_srli_epi32 ( t11, shift ), channel ), w11 ) );
+		return sum;
+	}
+};
+
+// get Sample bilinear
+REALINLINE void getSample_texture_x4 ( __m128i &r, __m128i &g, __m128i &b,
+								const sInternalTexture * t, const __m128i tx, const __m128i ty
+								)
+{
+	const sBilinearTaps_x4 taps ( t, tx, ty );
+	r = taps.filter ( SHIFT_R );
+	g = taps.filter ( SHIFT_G );
+	b = taps.filter ( SHIFT_B );
+}
+
+REALINLINE void getSample_texture_x4 ( __m128i &a, __m128i &r, __m128i &g, __m128i &b,
+								const sInternalTexture * t, const __m128i tx, const __m128i ty
+								)
+{
+	const sBilinearTaps_x4 taps ( t, tx, ty );
+	a = taps.filter ( SHIFT_A );
+	r = taps.filter ( SHIFT_R );
+	g = taps.filter ( SHIFT_G );
+	b = taps.filter ( SHIFT_B );
+}
+
+#endif
+
+//! writes the lanes of `value` whose `mask` is set, the others keep what was there
+REALINLINE void store_masked_x4 ( tVideoSample* dst, const __m128i value, const __m128 mask )
+{
+	const __m128i old = _mm_loadu_si128 ( (const __m128i*) dst );
+	_mm_storeu_si128 ( (__m128i*) dst, _mm_blendv_epi8 ( old, value, _mm_castps_si128 ( mask ) ) );
+}
+
+REALINLINE void store_masked_x4 ( fp24* dst, const __m128 value, const __m128 mask )
+{
+	_mm_storeu_ps ( dst, _mm_blendv_ps ( _mm_loadu_ps ( dst ), value, mask ) );
+}
+
+} // end namespace irr
+
+#endif // SOFTWARE_DRIVER_2_SIMD_SPANS
+
+#endif
@@ -6,6 +6,8 @@
 #include "CBAWMeshFileLoader.h"
 
 #include <stack>
+#include <atomic>
+#include <algorithm>
 
 #include "CFinalBoneHierarchy.h"
 #include "irr/video/SGPUMesh.h"
@@ -15,6 +17,9 @@
 #include "IrrlichtDevice.h"
 #include "irr/asset/bawformat/legacy/CBAWLegacy.h"
 #include "CMemoryFile.h"
+#include "CReadFile.h"
+#include "CMappedReadFile.h"
+#include "irr/core/parallel_for.h"
 
 #undef Bool
 #include "lzma/C/LzmaDec.h"
@@ -59,7 +64,17 @@ asset::IAsset* CBAWMeshFileLoader::loadAsset(io::IReadFile* _file, const asset::
 
     ctx.inner.mainFile = tryCreateNewestFormatVersionFile(ctx.inner.mainFile, _override, std::make_integer_sequence<uint64_t, _IRR_BAW_FORMAT_VERSION>{});
 
-    asset::BlobHeaderV1* headers = nullptr;
+    // if the file is on disk, map it so that uncompressed blobs don't have to be copied (raw buffers will alias the mapping)
+    if (ctx.inner.mainFile == _file && !_file->getMappedPointer() && dynamic_cast<io::CReadFile*>(_file))
+    {
+        io::CMappedReadFile* mapped = new io::CMappedReadFile(_file->getFileName());
+        if (mapped->isOpen() && mapped->getSize() == _file->getSize())
+            ctx.inner.mainFile = mapped;
+        else
+            mapped->drop();
+    }
+
+    asset::BlobHeaderV2* headers = nullptr;
 
     auto exitRoutine = [&] {
         if (ctx.inner.mainFile != _file) // if mainFile is temparary memory file created just to update format to the newest version
@@ -103,8 +118,40 @@ asset::IAsset* CBAWMeshFileLoader::loadAsset(io::IReadFile* _file, const asset::
         m_fileSystem,
         ctx.inner.mainFile->getFileName()[ctx.inner.mainFile->getFileName().size()-1] == '/' ? ctx.inner.mainFile->getFileName() : ctx.inner.mainFile->getFileName()+"/",
         ctx.inner.params,
-        _override
+        _override,
+        ctx.inner.mainFile->getMappedPointer() ? ctx.inner.mainFile : nullptr
     };
+	// read, decrypt and decompress everything reachable from the mesh up front, one hierarchy level at a time so each level is decoded in parallel
+	{
+		core::unordered_set<uint64_t> scheduled{meshBlobDataIter->first};
+		core::vector<SBlobData*> level{&meshBlobDataIter->second};
+		meshBlobDataIter->second.hierarchyLvl = 0u;
+		while (!level.empty())
+		{
+			if (!decodeBlobs(level, ctx, _override, rootCacheKey))
+				return nullptr;
+
+			core::vector<SBlobData*> nextLevel;
+			for (SBlobData* data : level)
+			{
+				const core::unordered_set<uint64_t> deps = ctx.loadingMgr.getNeededDeps(data->header->blobType, data->getBlob());
+				for (auto it = deps.begin(); it != deps.end(); ++it)
+				{
+					if (!scheduled.insert(*it).second)
+						continue;
+
+					auto depIt = ctx.blobs.find(*it);
+					if (depIt == ctx.blobs.end())
+						return nullptr;
+					depIt->second.hierarchyLvl = data->hierarchyLvl+1u;
+					nextLevel.push_back(&depIt->second);
+				}
+			}
+			level.swap(nextLevel);
+		}
+	}
+
+	// instantiate in dependency order
 	core::stack<SBlobData*> toLoad, toFinalize;
 	toLoad.push(&meshBlobDataIter->second);
     toLoad.top()->hierarchyLvl = 0u;
@@ -114,25 +161,15 @@ asset::IAsset* CBAWMeshFileLoader::loadAsset(io::IReadFile* _file, const asset::
 		toLoad.pop();
 
 		const uint64_t handle = data->header->handle;
+		if (ctx.createdObjs.find(handle) != ctx.createdObjs.end()) // pushed more than once before getting created
+			continue;
+
         const uint32_t size = data->header->blobSizeDecompr;
         const uint32_t blobType = data->header->blobType;
         const std::string thisCacheKey = genSubAssetCacheKey(rootCacheKey, handle);
         const uint32_t hierLvl = data->hierarchyLvl;
 
-        uint8_t decrKey[16];
-        size_t decrKeyLen = 16u;
-        uint32_t attempt = 0u;
-        const void* blob = nullptr;
-        // todo: supposedFilename arg is missing (empty string) - what is it?
-        while (_override->getDecryptionKey(decrKey, decrKeyLen, attempt, ctx.inner.mainFile, "", thisCacheKey, ctx.inner, hierLvl))
-        {
-            if (!((data->header->compressionType & asset::Blob::EBCT_AES128_GCM) && decrKeyLen != 16u))
-                blob = data->heapBlob = tryReadBlobOnStack(*data, ctx, decrKey);
-            if (blob)
-                break;
-            ++attempt;
-        }
-
+        const void* blob = data->getBlob();
 		if (!blob)
 		{
 			return nullptr;
@@ -165,8 +202,10 @@ asset::IAsset* CBAWMeshFileLoader::loadAsset(io::IReadFile* _file, const asset::
 		{
             void* obj = ctx.createdObjs[handle];
 			ctx.loadingMgr.finalize(blobType, obj, blob, size, ctx.createdObjs, params);
-            _IRR_ALIGNED_FREE(data->heapBlob);
+            if (data->heapBlob)
+                _IRR_ALIGNED_FREE(data->heapBlob);
 			blob = data->heapBlob = NULL;
+            data->mappedBlob = nullptr;
             insertAssetIntoCache(ctx, _override, obj, blobType, hierLvl, thisCacheKey);
 		}
 		else
@@ -179,7 +218,7 @@ asset::IAsset* CBAWMeshFileLoader::loadAsset(io::IReadFile* _file, const asset::
 		SBlobData* data = toFinalize.top();
 		toFinalize.pop();
 
-		const void* blob = data->heapBlob;
+		const void* blob = data->getBlob();
 		const uint64_t handle = data->header->handle;
 		const uint32_t size = data->header->blobSizeDecompr;
 		const uint32_t blobType = data->header->blobType;
@@ -212,6 +251,110 @@ bool CBAWMeshFileLoader::safeRead(io::IReadFile * _file, void * _buf, size_t _si
 	return true;
 }
 
+const void* CBAWMeshFileLoader::getMappedBlob(const SBlobData& _data, SContext& _ctx) const
+{
+    const uint8_t* const mapping = reinterpret_cast<const uint8_t*>(_ctx.inner.mainFile->getMappedPointer());
+    if (!mapping || _data.absOffset + _data.header->effectiveSize() > _ctx.inner.mainFile->getSize())
+        return nullptr;
+
+    return mapping + _data.absOffset;
+}
+
+bool CBAWMeshFileLoader::decodeBlobs(const core::vector<SBlobData*>& _blobs, SContext& _ctx, asset::IAssetLoader::IAssetLoaderOverride* _override, const std::string& _rootCacheKey)
+{
+    struct SPendingBlob
+    {
+        SBlobData* data;
+        const void* encoded; // either points into file mapping or is owned
+        bool ownsEncoded;
+        bool keyUsable;
+        uint8_t decrKey[16];
+    };
+    core::vector<SPendingBlob> pending;
+    pending.reserve(_blobs.size());
+
+    auto freeEncoded = [](SPendingBlob& _p) {
+        if (_p.ownsEncoded && _p.encoded)
+            _IRR_ALIGNED_FREE(const_cast<void*>(_p.encoded));
+        _p.encoded = nullptr;
+    };
+    auto exitRoutine = [&] {
+        for (auto& p : pending)
+            freeEncoded(p);
+    };
+    auto exiter = core::makeRAIIExiter(exitRoutine);
+
+    // reading from the file is serial, it's the decoding that's worth spreading
+    for (SBlobData* data : _blobs)
+    {
+        if (data->getBlob())
+            continue;
+
+        SPendingBlob p{data, getMappedBlob(*data, _ctx), false, false};
+        if (!p.encoded)
+        {
+            const size_t size = data->header->effectiveSize();
+            void* buf = _IRR_ALIGNED_MALLOC(size, _IRR_SIMD_ALIGNMENT);
+            _ctx.inner.mainFile->seek(data->absOffset);
+            if (_ctx.inner.mainFile->read(buf, size) != static_cast<int32_t>(size))
+            {
+                _IRR_ALIGNED_FREE(buf);
+                return false;
+            }
+            p.encoded = buf;
+            p.ownsEncoded = true;
+        }
+        pending.push_back(p);
+    }
+    // biggest blobs first, so that no thread gets left with a huge one at the end
+    std::sort(pending.begin(), pending.end(), [](const SPendingBlob& _a, const SPendingBlob& _b) { return _a.data->header->blobSizeDecompr > _b.data->header->blobSizeDecompr; });
+
+    for (uint32_t attempt = 0u; !pending.empty(); ++attempt)
+    {
+        // override isn't required to be thread-safe
+        for (auto& p : pending)
+        {
+            size_t decrKeyLen = 16u;
+            // todo: supposedFilename arg is missing (empty string) - what is it?
+            if (!_override->getDecryptionKey(p.decrKey, decrKeyLen, attempt, _ctx.inner.mainFile, "", genSubAssetCacheKey(_rootCacheKey, p.data->header->handle), _ctx.inner, p.data->hierarchyLvl))
+                return false;
+            p.keyUsable = !((p.data->header->compressionType & asset::Blob::EBCT_AES128_GCM) && decrKeyLen != 16u);
+        }
+
+        // blob sizes vary wildly, so threads grab blobs one by one instead of getting fixed ranges
+        std::atomic<size_t> nextBlob(0u);
+        const uint32_t threadCount = core::min_<uint32_t>(core::getDefaultThreadCount(), static_cast<uint32_t>(pending.size()));
+        core::parallel_for<uint32_t>(0u, threadCount, [&](uint32_t, uint32_t)
+        {
+            for (size_t i = nextBlob++; i < pending.size(); i = nextBlob++)
+            {
+                SPendingBlob& p = pending[i];
+                if (!p.keyUsable)
+                    continue;
+
+                void* decoded = decodeBlob(p.data->header, p.encoded, p.decrKey, _ctx.iv);
+                if (!decoded)
+                    continue;
+
+                if (decoded != p.encoded)
+                {
+                    p.data->heapBlob = decoded;
+                    freeEncoded(p);
+                }
+                else if (p.ownsEncoded)
+                    p.data->heapBlob = decoded;
+                else
+                    p.data->mappedBlob = decoded;
+                p.encoded = nullptr;
+            }
+        }, threadCount);
+
+        pending.erase(std::remove_if(pending.begin(), pending.end(), [](const SPendingBlob& _p) { return _p.data->getBlob() != nullptr; }), pending.end());
+    }
+
+    return true;
+}
+
 bool CBAWMeshFileLoader::decompressLzma(void* _dst, size_t _dstSize, const void* _src, size_t _srcSize) const
 {
 	SizeT dstSize = _dstSize;
@@ -339,4 +482,41 @@ io::IReadFile* CBAWMeshFileLoader::createConvertIntoVer_spec<1>(SContext& _ctx,
     return ret;
 }
 
+template<>
+io::IReadFile* CBAWMeshFileLoader::createConvertIntoVer_spec<2>(SContext& _ctx, io::IReadFile* _baw1file, asset::IAssetLoader::IAssetLoaderOverride* _override, const CommonDataTuple<1>& _common)
+{
+    uint32_t blobCnt{};
+    asset::BlobHeaderV1* headers = nullptr;
+    uint32_t* offsets = nullptr;
+    uint32_t baseOffsetv1{};
+    uint32_t baseOffsetv2{};
+    std::tie(blobCnt, headers, offsets, baseOffsetv1, baseOffsetv2) = _common;
+
+    // v2 only allows padding between blobs, so tightly packed v1 blobs and offsets stay as they are and just the version changes
+    io::CMemoryWriteFile* const baw2mem = new io::CMemoryWriteFile(0u, _baw1file->getFileName());
+
+    uint64_t fileHeader[4] {0u, 0u, 0u, 2u/*baw v2*/};
+    memcpy(fileHeader, asset::BAWFileV2::HEADER_STRING, strlen(asset::BAWFileV2::HEADER_STRING));
+    baw2mem->write(fileHeader, sizeof(fileHeader));
+    baw2mem->write(&blobCnt, 4);
+    baw2mem->write(_ctx.iv, 16);
+    baw2mem->write(offsets, blobCnt*4);
+    baw2mem->write(headers, blobCnt*sizeof(headers[0])); // blob header in v1 and in v2 is exact same thing
+
+    const uint32_t blobsSize = _baw1file->getSize() - baseOffsetv1;
+    void* blobs = _IRR_ALIGNED_MALLOC(blobsSize, _IRR_SIMD_ALIGNMENT);
+    _baw1file->seek(baseOffsetv1);
+    _baw1file->read(blobs, blobsSize);
+    baw2mem->seek(baseOffsetv2);
+    baw2mem->write(blobs, blobsSize);
+    _IRR_ALIGNED_FREE(blobs);
+
+    _IRR_ALIGNED_FREE(offsets);
+    _IRR_ALIGNED_FREE(headers);
+
+    auto ret = new io::CMemoryReadFile(baw2mem->getPointer(), baw2mem->getSize(), _baw1file->getFileName());
+    baw2mem->drop();
+    return ret;
+}
+
 }} // irr::scene
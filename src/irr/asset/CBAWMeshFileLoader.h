@@ -36,6 +36,7 @@ private:
 		HeaderT* header;
 		size_t absOffset; // absolute
 		void* heapBlob = nullptr;
+		const void* mappedBlob = nullptr; // points into memory mapped file instead of heap, never freed
 		mutable bool validated = false;
         uint32_t hierarchyLvl = 0u;
 
@@ -43,6 +44,7 @@ private:
         SBlobData_t(const SBlobData_t<HeaderT>&) = delete;
         SBlobData_t(SBlobData_t<HeaderT>&& _other) {
             std::swap(heapBlob, _other.heapBlob);
+            mappedBlob = _other.mappedBlob;
             header = _other.header;
             absOffset = _other.absOffset;
             validated = _other.validated;
@@ -56,9 +58,11 @@ private:
 
 		bool validate() const {
 			validated = false;
-			return validated ? true : (validated = (heapBlob && header->validate(heapBlob)));
+			return validated ? true : (validated = (getBlob() && header->validate(getBlob())));
 		}
 
+		const void* getBlob() const { return heapBlob ? heapBlob : mappedBlob; }
+
 	};
     using SBlobData = SBlobData_t<asset::BlobHeaderVn<_IRR_BAW_FORMAT_VERSION>>;
 
@@ -145,6 +149,7 @@ private:
         {
         case 0ull: return verifyFile<asset::legacyv0::BAWFileV0>(_ctx);
         case 1ull: return verifyFile<asset::BAWFileV1>(_ctx);
+        case 2ull: return verifyFile<asset::BAWFileV2>(_ctx);
         default: return false;
         }
     }
@@ -157,6 +162,22 @@ private:
 	//! Reads `_size` bytes to `_buf` from `_file`, but previously checks whether file is big enough and returns true/false appropriately.
 	bool safeRead(io::IReadFile* _file, void* _buf, size_t _size) const;
 
+	//! Returns pointer to blob's data (as stored in file) within memory mapped main file.
+	/** @returns nullptr if main file is not memory mapped or blob doesn't fit in it. */
+	const void* getMappedBlob(const SBlobData& _data, SContext& _ctx) const;
+
+	//! Reads, decrypts and decompresses all `_blobs`, filling their `heapBlob` or `mappedBlob`.
+	/** File reads are done serially, everything else is spread over worker threads.
+	Decryption keys are queried from `_override` on the calling thread.
+	@returns false if any of the blobs could not be loaded. */
+	bool decodeBlobs(const core::vector<SBlobData*>& _blobs, SContext& _ctx, asset::IAssetLoader::IAssetLoaderOverride* _override, const std::string& _rootCacheKey);
+
+	//! Validates, decrypts and decompresses blob data `_src` as stored in file (i.e. `_header->effectiveSize()` bytes).
+	/** Touches neither the file nor any loader state, so it can be called for different blobs from multiple threads at once.
+	@returns `_src` if blob is stored raw, otherwise pointer to _IRR_ALIGNED_MALLOC'd memory, or nullptr on failure. */
+    template<typename HeaderT>
+	void* decodeBlob(HeaderT* _header, const void* _src, const unsigned char _pwd[16], const unsigned char _iv[16]) const;
+
 	//! Reads blob to memory on stack or allocates sufficient amount on heap if provided stack storage was not big enough.
 	/** @returns `_stackPtr` if blob was read to it or pointer to malloc'd memory otherwise.*/
     template<typename HeaderT>
@@ -374,8 +395,8 @@ bool CBAWMeshFileLoader::validateHeaders(uint32_t* _blobCnt, uint32_t** _offsets
     if (offsetRelByte + offsets[*_blobCnt-1] >= _ctx.inner.mainFile->getSize()) // check the last offset
         nope = true;
 
-    for (uint32_t i = 0; i < *_blobCnt-1; ++i) // whether blobs are tightly packed (do not overlays each other and there's no space bewteen any pair)
-        if (offsets[i] + headers[i].effectiveSize() != offsets[i+1])
+    for (uint32_t i = 0; i < *_blobCnt-1; ++i) // whether blobs are packed (do not overlay each other and there's less than alignment padding between any pair, i.e. none before version 2)
+        if (offsets[i] + headers[i].effectiveSize() > offsets[i+1] || offsets[i+1] - (offsets[i] + headers[i].effectiveSize()) >= BAWFileT::BLOB_ALIGNMENT)
             nope = true;
 
     if (offsets[*_blobCnt-1] + headers[*_blobCnt-1].effectiveSize() >= _ctx.inner.mainFile->getSize()) // whether last blob doesn't "go out of file"
@@ -393,92 +414,78 @@ bool CBAWMeshFileLoader::validateHeaders(uint32_t* _blobCnt, uint32_t** _offsets
 template<typename HeaderT>
 void* CBAWMeshFileLoader::tryReadBlobOnStack(const SBlobData_t<HeaderT> & _data, SContext & _ctx, const unsigned char _pwd[16], void * _stackPtr, size_t _stackSize) const
 {
-    void* dst;
-    if (_stackPtr && _data.header->blobSizeDecompr <= _stackSize && _data.header->effectiveSize() <= _stackSize)
-        dst = _stackPtr;
+    const size_t effectiveSize = _data.header->effectiveSize();
+
+    void* src;
+    if (_stackPtr && effectiveSize <= _stackSize)
+        src = _stackPtr;
     else
-        dst = _IRR_ALIGNED_MALLOC(asset::BlobHeaderVn<_IRR_BAW_FORMAT_VERSION>::calcEncSize(_data.header->blobSizeDecompr), _IRR_SIMD_ALIGNMENT);
+        src = _IRR_ALIGNED_MALLOC(effectiveSize, _IRR_SIMD_ALIGNMENT);
 
-    const bool encrypted = (_data.header->compressionType & asset::Blob::EBCT_AES128_GCM);
-    const bool compressed = (_data.header->compressionType & asset::Blob::EBCT_LZ4) || (_data.header->compressionType & asset::Blob::EBCT_LZMA);
+    _ctx.inner.mainFile->seek(_data.absOffset);
+    _ctx.inner.mainFile->read(src, effectiveSize);
 
-    void* dstCompressed = dst; // ptr to mem to load possibly compressed data
-    if (compressed)
-        dstCompressed = _IRR_ALIGNED_MALLOC(_data.header->effectiveSize(), _IRR_SIMD_ALIGNMENT);
+    void* dst = decodeBlob(_data.header, src, _pwd, _ctx.iv);
+    if (dst != src && src != _stackPtr)
+        _IRR_ALIGNED_FREE(src);
 
-    _ctx.inner.mainFile->seek(_data.absOffset);
-    _ctx.inner.mainFile->read(dstCompressed, _data.header->effectiveSize());
+    return dst;
+}
 
-    if (!_data.header->validate(dstCompressed))
+template<typename HeaderT>
+void* CBAWMeshFileLoader::decodeBlob(HeaderT* _header, const void* _src, const unsigned char _pwd[16], const unsigned char _iv[16]) const
+{
+    if (!_header->validate(_src))
     {
 #ifdef _IRR_DEBUG
         os::Printer::log("Blob validation failed!", ELL_ERROR);
 #endif
-        if (compressed)
-        {
-            _IRR_ALIGNED_FREE(dstCompressed);
-            if (dst != _stackPtr)
-                _IRR_ALIGNED_FREE(dst);
-        }
-        else if (dst != _stackPtr)
-            _IRR_ALIGNED_FREE(dstCompressed);
-        return NULL;
+        return nullptr;
     }
 
+    const bool encrypted = (_header->compressionType & asset::Blob::EBCT_AES128_GCM);
+    const bool compressed = (_header->compressionType & asset::Blob::EBCT_LZ4) || (_header->compressionType & asset::Blob::EBCT_LZMA);
+
+    const void* data = _src;
+    void* decrypted = nullptr;
     if (encrypted)
     {
 #ifdef _IRR_COMPILE_WITH_OPENSSL_
-        const size_t size = _data.header->effectiveSize();
-        void* out = _IRR_ALIGNED_MALLOC(size, _IRR_SIMD_ALIGNMENT);
-        const bool ok = asset::decAes128gcm(dstCompressed, size, out, size, _pwd, _ctx.iv, _data.header->gcmTag);
-        if (dstCompressed != _stackPtr)
-            _IRR_ALIGNED_FREE(dstCompressed);
-        if (!ok)
+        const size_t size = _header->effectiveSize();
+        decrypted = _IRR_ALIGNED_MALLOC(size, _IRR_SIMD_ALIGNMENT);
+        if (!asset::decAes128gcm(_src, size, decrypted, size, _pwd, _iv, _header->gcmTag))
         {
-            if (dst != _stackPtr && dstCompressed != dst)
-                _IRR_ALIGNED_FREE(dst);
-            _IRR_ALIGNED_FREE(out);
+            _IRR_ALIGNED_FREE(decrypted);
 #ifdef _IRR_DEBUG
             os::Printer::log("Blob decryption failed!", ELL_ERROR);
-#       endif
+#endif
             return nullptr;
         }
-        dstCompressed = out;
-        if (!compressed)
-            dst = dstCompressed;
+        data = decrypted;
 #else
-        if (compressed)
-        {
-            _IRR_ALIGNED_FREE(dstCompressed);
-            if (dst != _stackPtr)
-                _IRR_ALIGNED_FREE(dst);
-        }
-        else if (dst != _stackPtr)
-            _IRR_ALIGNED_FREE(dstCompressed);
-        return NULL;
+        return nullptr;
 #endif
     }
 
-    if (compressed)
-    {
-        const uint8_t comprType = _data.header->compressionType;
-        bool res = false;
+    if (!compressed)
+        return decrypted ? decrypted : const_cast<void*>(_src);
 
-        if (comprType & asset::Blob::EBCT_LZ4)
-            res = decompressLz4(dst, _data.header->blobSizeDecompr, dstCompressed, _data.header->blobSize);
-        else if (comprType & asset::Blob::EBCT_LZMA)
-            res = decompressLzma(dst, _data.header->blobSizeDecompr, dstCompressed, _data.header->blobSize);
+    void* dst = _IRR_ALIGNED_MALLOC(_header->blobSizeDecompr, _IRR_SIMD_ALIGNMENT);
+    bool res = false;
+    if (_header->compressionType & asset::Blob::EBCT_LZ4)
+        res = decompressLz4(dst, _header->blobSizeDecompr, data, _header->blobSize);
+    else if (_header->compressionType & asset::Blob::EBCT_LZMA)
+        res = decompressLzma(dst, _header->blobSizeDecompr, data, _header->blobSize);
 
-        _IRR_ALIGNED_FREE(dstCompressed);
-        if (!res)
-        {
-            if (dst != _stackPtr && dst != dstCompressed)
-                _IRR_ALIGNED_FREE(dst);
+    if (decrypted)
+        _IRR_ALIGNED_FREE(decrypted);
+    if (!res)
+    {
+        _IRR_ALIGNED_FREE(dst);
 #ifdef _IRR_DEBUG
-            os::Printer::log("Blob decompression failed!", ELL_ERROR);
+        os::Printer::log("Blob decompression failed!", ELL_ERROR);
 #endif
-            return nullptr;
-        }
+        return nullptr;
     }
 
     return dst;
@@ -152,7 +152,7 @@ struct LzmaMemMngmnt
         const asset::ICPUMesh* mesh = static_cast<const asset::ICPUMesh*>(_params.rootAsset);
 
 		constexpr uint32_t FILE_HEADER_SIZE = 32;
-        static_assert(FILE_HEADER_SIZE == sizeof(asset::BAWFileV1::fileHeader), "BAW header is not 32 bytes long!");
+        static_assert(FILE_HEADER_SIZE == sizeof(asset::BAWFileV2::fileHeader), "BAW header is not 32 bytes long!");
 
 		uint64_t header[4];
 		memcpy(header, BAW_FILE_HEADER, FILE_HEADER_SIZE);
@@ -163,7 +163,7 @@ struct LzmaMemMngmnt
         SContext ctx{ asset::IAssetWriter::SAssetWriteContext{_params, _file}, _override }; // context of this call of `writeMesh`
 
 		const uint32_t numOfInternalBlobs = genHeaders(mesh, ctx);
-		const uint32_t OFFSETS_FILE_OFFSET = FILE_HEADER_SIZE + sizeof(uint32_t) + sizeof(asset::BAWFileV1::iv);
+		const uint32_t OFFSETS_FILE_OFFSET = FILE_HEADER_SIZE + sizeof(uint32_t) + sizeof(asset::BAWFileV2::iv);
 		const uint32_t HEADERS_FILE_OFFSET = OFFSETS_FILE_OFFSET + numOfInternalBlobs * sizeof(ctx.offsets[0]);
 
 		ctx.offsets.resize(numOfInternalBlobs);
@@ -176,7 +176,8 @@ struct LzmaMemMngmnt
 		_file->write(ctx.offsets.data(), ctx.offsets.size() * sizeof(ctx.offsets[0]));
 
 		// will be overwritten after calculating not known yet data (hash and size for texture paths)
-		_file->write(ctx.headers.data(), ctx.headers.size() * sizeof(asset::BlobHeaderV1));
+		_file->write(ctx.headers.data(), ctx.headers.size() * sizeof(asset::BlobHeaderV2));
+		ctx.blobsOffset = HEADERS_FILE_OFFSET + numOfInternalBlobs * sizeof(asset::BlobHeaderV2);
 
 		ctx.offsets.resize(0); // set `used` to 0, to allow push starting from 0 index
 		for (int i = 0; i < ctx.headers.size(); ++i)
@@ -217,7 +218,7 @@ struct LzmaMemMngmnt
 		_file->write(ctx.offsets.data(), ctx.offsets.size() * sizeof(ctx.offsets[0]));
 		// overwrite headers
 		_file->seek(HEADERS_FILE_OFFSET);
-		_file->write(ctx.headers.data(), ctx.headers.size() * sizeof(asset::BlobHeaderV1));
+		_file->write(ctx.headers.data(), ctx.headers.size() * sizeof(asset::BlobHeaderV2));
 
 		_file->seek(prevPos);
 
@@ -237,7 +238,7 @@ struct LzmaMemMngmnt
 			if (!skinnedMesh || (skinnedMesh && skinnedMesh->isStatic()))
 				isMeshAnimated = false;
 
-            asset::BlobHeaderV1 bh;
+            asset::BlobHeaderV2 bh;
 			bh.handle = reinterpret_cast<uint64_t>(_mesh);
 			bh.compressionType = asset::Blob::EBCT_RAW;
 			bh.blobType = isMeshAnimated ? asset::Blob::EBT_SKINNED_MESH : asset::Blob::EBT_MESH;
@@ -248,7 +249,7 @@ struct LzmaMemMngmnt
 
 		if (isMeshAnimated)
 		{
-            asset::BlobHeaderV1 bh;
+            asset::BlobHeaderV2 bh;
 			bh.handle = reinterpret_cast<uint64_t>(skinnedMesh->getBoneReferenceHierarchy());
 			bh.compressionType = asset::Blob::EBCT_RAW;
 			bh.blobType = asset::Blob::EBT_FINAL_BONE_HIERARCHY;
@@ -267,7 +268,7 @@ struct LzmaMemMngmnt
 
 			if (countedObjects.find(meshBuffer) == countedObjects.end())
 			{
-                asset::BlobHeaderV1 bh;
+                asset::BlobHeaderV2 bh;
 				bh.handle = reinterpret_cast<uint64_t>(meshBuffer);
 				bh.compressionType = asset::Blob::EBCT_RAW;
 				bh.blobType = isMeshAnimated ? asset::Blob::EBT_SKINNED_MESH_BUFFER : asset::Blob::EBT_MESH_BUFFER;
@@ -292,7 +293,7 @@ struct LzmaMemMngmnt
 
 			if (countedObjects.find(desc) == countedObjects.end())
 			{
-                asset::BlobHeaderV1 bh;
+                asset::BlobHeaderV2 bh;
 				bh.handle = reinterpret_cast<uint64_t>(desc);
 				bh.compressionType = asset::Blob::EBCT_RAW;
 				bh.blobType = asset::Blob::EBT_DATA_FORMAT_DESC;
@@ -303,7 +304,7 @@ struct LzmaMemMngmnt
 			const asset::ICPUBuffer* idxBuffer = desc->getIndexBuffer();
 			if (idxBuffer && countedObjects.find(idxBuffer) == countedObjects.end())
 			{
-                asset::BlobHeaderV1 bh;
+                asset::BlobHeaderV2 bh;
 				bh.handle = reinterpret_cast<uint64_t>(idxBuffer);
 				bh.compressionType = asset::Blob::EBCT_RAW;
 				bh.blobType = asset::Blob::EBT_RAW_DATA_BUFFER;
@@ -316,7 +317,7 @@ struct LzmaMemMngmnt
 				const asset::ICPUBuffer* attBuffer = desc->getMappedBuffer((asset::E_VERTEX_ATTRIBUTE_ID)attId);
 				if (attBuffer && countedObjects.find(attBuffer) == countedObjects.end())
 				{
-                    asset::BlobHeaderV1 bh;
+                    asset::BlobHeaderV2 bh;
 					bh.handle = reinterpret_cast<uint64_t>(attBuffer);
 					bh.compressionType = asset::Blob::EBCT_RAW;
 					bh.blobType = asset::Blob::EBT_RAW_DATA_BUFFER;
@@ -329,9 +330,15 @@ struct LzmaMemMngmnt
 		return _ctx.headers.size();
 	}
 
-	void CBAWMeshWriter::calcAndPushNextOffset(uint32_t _blobSize, SContext& _ctx) const
+	void CBAWMeshWriter::padAndPushNextOffset(io::IWriteFile* _file, SContext& _ctx) const
 	{
-		_ctx.offsets.push_back(!_ctx.offsets.size() ? 0 : _ctx.offsets.back() + _blobSize);
+		constexpr uint32_t alignment = asset::BAWFileV2::BLOB_ALIGNMENT;
+		const uint8_t zeroes[alignment]{};
+
+		const size_t pos = _file->getPos();
+		const size_t padding = (alignment - pos%alignment) % alignment;
+		_file->write(zeroes, padding);
+		_ctx.offsets.push_back(pos + padding - _ctx.blobsOffset);
 	}
 
 	void CBAWMeshWriter::tryWrite(void* _data, io::IWriteFile * _file, SContext & _ctx, size_t _size, uint32_t _headerIdx, asset::E_WRITER_FLAGS _flags, const uint8_t* _encrPwd, float _comprLvl) const
@@ -367,7 +374,7 @@ struct LzmaMemMngmnt
 
 		if (_flags & asset::EWF_ENCRYPTED)
 		{
-			const size_t encrSize = asset::BlobHeaderV1::calcEncSize(compressedSize);
+			const size_t encrSize = asset::BlobHeaderV2::calcEncSize(compressedSize);
 			void* in = _IRR_ALIGNED_MALLOC(encrSize,_IRR_SIMD_ALIGNMENT);
 			memset(((uint8_t*)in) + (compressedSize-16), 0, 16);
 			memcpy(in, data, compressedSize);
@@ -394,9 +401,9 @@ struct LzmaMemMngmnt
 		}
 
 		_ctx.headers[_headerIdx].finalize(data, _size, compressedSize, comprType);
-		const size_t writeSize = (comprType & asset::Blob::EBCT_AES128_GCM) ? asset::BlobHeaderV1::calcEncSize(compressedSize) : compressedSize;
+		const size_t writeSize = (comprType & asset::Blob::EBCT_AES128_GCM) ? asset::BlobHeaderV2::calcEncSize(compressedSize) : compressedSize;
+		padAndPushNextOffset(_file, _ctx);
 		_file->write(data, writeSize);
-		calcAndPushNextOffset(!_headerIdx ? 0 : _ctx.headers[_headerIdx - 1].effectiveSize(), _ctx);
 
 		if (data != stack && data != _data)
 			_IRR_ALIGNED_FREE(const_cast<void*>(data)); // safe const_cast since the only case when this executes is when `data` points to _IRR_ALIGNED_MALLOC'd memory
@@ -413,7 +420,7 @@ struct LzmaMemMngmnt
 		{
 			if (lz4CompressBound > _stackSize)
 			{
-				dstSize = asset::BlobHeaderV1::calcEncSize(lz4CompressBound);
+				dstSize = asset::BlobHeaderV2::calcEncSize(lz4CompressBound);
 				data = _IRR_ALIGNED_MALLOC(dstSize,_IRR_SIMD_ALIGNMENT);
 			}
 			compressedSize = LZ4_compress_default((const char*)_input, (char*)data, _inputSize, dstSize);
@@ -51,8 +51,10 @@ namespace asset
 		{
 			asset::IAssetWriter::SAssetWriteContext inner;
             asset::IAssetWriter::IAssetWriterOverride* writerOverride;
-			core::vector<asset::BlobHeaderV1> headers;
+			core::vector<asset::BlobHeaderV2> headers;
 			core::vector<uint32_t> offsets;
+			//! Absolute file offset which blob offsets are relative to
+			uint32_t blobsOffset;
 		};
 
         class CBAWOverride : public IAssetWriterOverride
@@ -109,10 +111,8 @@ namespace asset
 		@return Amount of generated headers.*/
 		uint32_t genHeaders(const asset::ICPUMesh* _mesh, SContext& _ctx);
 
-		//! Pushes new offset value to `SContext::offsets` array.
-		/** @param _blobSize Byte-distance from previous blob's first byte (i.e. size of previous blob).
-		*/
-		void calcAndPushNextOffset(uint32_t _blobSize, SContext& _ctx) const;
+		//! Pads `_file` with zeroes up to the next multiple of BAWFileV2::BLOB_ALIGNMENT and pushes resulting position (as offset of the blob about to be written) to `SContext::offsets` array.
+		void padAndPushNextOffset(io::IWriteFile* _file, SContext& _ctx) const;
 
 		//! Pushes corrupted offset so that, while loading resulting .baw file, it will be easy to find out something went wrong.
 		void pushCorruptedOffset(SContext& _ctx) const { _ctx.offsets.push_back(0xffffffff); }
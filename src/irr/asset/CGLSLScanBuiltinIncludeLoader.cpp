@@ -20,7 +20,7 @@ static core::vector<std::string> parseArgumentsFromPath(const std::string& _path
     return args;
 }
 
-auto CGLSLScanBuiltinIncludeLoader::getBuiltinNamesToFunctionMapping() const -> core::vector<std::pair<std::regex, HandleFunc_t>>
+auto CGLSLScanBuiltinIncludeLoader::getBuiltinNamesToFunctionMapping() const -> core::vector<std::pair<std::string, HandleFunc_t>>
 {
     auto handle_incl_scan_common = [](const std::string& _op_s, const std::string& _type_s) {
         E_GLSL_COMMUTATIVE_OP op = EGCO_COUNT;
@@ -77,10 +77,10 @@ auto CGLSLScanBuiltinIncludeLoader::getBuiltinNamesToFunctionMapping() const ->
     };
 
     return {
-        {std::regex{"reduce_and_scan_enables\\.glsl"}, [this](const std::string&) { return getReduceAndScanExtensionEnables(); }},
-        {std::regex{"warp_padding\\.glsl"}, [](const std::string&) { return getWarpPaddingFunctions(); }},
-        {std::regex{"warp_inclusive_scan\\.glsl/(add|and|max|min|or|xor)/(float|vec2|vec3|vec4)/[a-zA-Z][a-zA-Z0-9]*/[a-zA-Z][a-zA-Z0-9]*/[a-zA-Z][a-zA-Z0-9]*"}, handle_warp_incl_scan },
-        {std::regex{"block_inclusive_scan\\.glsl/(add|and|max|min|or|xor)/(float|vec2|vec3|vec4)/[0-9]+/[0-9]+/[a-zA-Z][a-zA-Z0-9]*/[a-zA-Z][a-zA-Z0-9]*/[a-zA-Z][a-zA-Z0-9]*"}, handle_block_incl_scan }
+        {"reduce_and_scan_enables\\.glsl", [this](const std::string&) { return getReduceAndScanExtensionEnables(); }},
+        {"warp_padding\\.glsl", [](const std::string&) { return getWarpPaddingFunctions(); }},
+        {"warp_inclusive_scan\\.glsl/(add|and|max|min|or|xor)/(float|vec2|vec3|vec4)/[a-zA-Z][a-zA-Z0-9]*/[a-zA-Z][a-zA-Z0-9]*/[a-zA-Z][a-zA-Z0-9]*", handle_warp_incl_scan },
+        {"block_inclusive_scan\\.glsl/(add|and|max|min|or|xor)/(float|vec2|vec3|vec4)/[0-9]+/[0-9]+/[a-zA-Z][a-zA-Z0-9]*/[a-zA-Z][a-zA-Z0-9]*/[a-zA-Z][a-zA-Z0-9]*", handle_block_incl_scan }
     };
 }
 
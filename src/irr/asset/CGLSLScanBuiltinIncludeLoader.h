@@ -18,7 +18,7 @@ public:
     const char* getVirtualDirectoryName() const override { return "glsl/scan/"; }
 
 protected:
-    core::vector<std::pair<std::regex, HandleFunc_t>> getBuiltinNamesToFunctionMapping() const override;
+    core::vector<std::pair<std::string, HandleFunc_t>> getBuiltinNamesToFunctionMapping() const override;
 
 private:
     std::string getReduceAndScanExtensionEnables() const;
@@ -8,7 +8,7 @@
 using namespace irr;
 using namespace asset;
 
-auto CGLSLSkinningBuiltinIncludeLoader::getBuiltinNamesToFunctionMapping() const -> core::vector<std::pair<std::regex, HandleFunc_t>>
+auto CGLSLSkinningBuiltinIncludeLoader::getBuiltinNamesToFunctionMapping() const -> core::vector<std::pair<std::string, HandleFunc_t>>
 {
     auto handle_linear_skinning_N_bones = [](const std::string& _path) {
         constexpr size_t bonesNumberCharIndex = 16u;
@@ -16,7 +16,7 @@ auto CGLSLSkinningBuiltinIncludeLoader::getBuiltinNamesToFunctionMapping() const
     };
 
     return {
-        {std::regex{"linear_skinning_[0-4]_bones\\.glsl"}, handle_linear_skinning_N_bones}
+        {"linear_skinning_[0-4]_bones\\.glsl", handle_linear_skinning_N_bones}
     };
 }
 
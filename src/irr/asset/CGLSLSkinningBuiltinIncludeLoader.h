@@ -18,7 +18,7 @@ public:
     const char* getVirtualDirectoryName() const override { return "glsl/skinning/"; }
 
 protected:
-    core::vector<std::pair<std::regex, HandleFunc_t>> getBuiltinNamesToFunctionMapping() const override;
+    core::vector<std::pair<std::string, HandleFunc_t>> getBuiltinNamesToFunctionMapping() const override;
 
 private:
     static std::string getLinearSkinningFunction(uint32_t maxBoneInfluences);
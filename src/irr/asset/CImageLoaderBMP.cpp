@@ -13,6 +13,7 @@
 #include "os.h"
 #include "irr/asset/CImageData.h"
 #include "irr/asset/ICPUTexture.h"
+#include "irr/video/compressBlocks.h"
 
 namespace irr
 {
@@ -314,6 +315,9 @@ asset::IAsset* CImageLoaderBMP::loadAsset(io::IReadFile* _file, const asset::IAs
 	delete [] paletteData;
 	delete [] bmpData;
 
+	if (_params.loaderFlags&asset::IAssetLoader::ELPF_COMPRESS_TEXTURES)
+		video::blockCompressImages(images, _params.loaderFlags&asset::IAssetLoader::ELPF_HIGH_QUALITY_TEXTURE_COMPRESSION);
+
 	asset::ICPUTexture* tex = asset::ICPUTexture::create(images);
     for (auto img : images)
         img->drop();
@@ -11,6 +11,7 @@
 #include "os.h"
 #include "irr/asset/ICPUBuffer.h"
 #include "irr/asset/ICPUTexture.h"
+#include "irr/video/compressBlocks.h"
 #include <string>
 
 #include <stdio.h> // required for jpeglib.h
@@ -324,8 +325,12 @@ asset::IAsset* CImageLoaderJPG::loadAsset(io::IReadFile* _file, const asset::IAs
 			break;
 	}
 
-	asset::ICPUTexture* tex = asset::ICPUTexture::create({image});
-	image->drop();
+	core::vector<asset::CImageData*> images = {image};
+	if (_params.loaderFlags&asset::IAssetLoader::ELPF_COMPRESS_TEXTURES)
+		video::blockCompressImages(images, _params.loaderFlags&asset::IAssetLoader::ELPF_HIGH_QUALITY_TEXTURE_COMPRESSION);
+
+	asset::ICPUTexture* tex = asset::ICPUTexture::create(images);
+	images[0]->drop();
 	return tex;
 #endif
 }
@@ -11,6 +11,7 @@
 #endif // _IRR_COMPILE_WITH_LIBPNG_
 
 #include "irr/asset/ICPUTexture.h"
+#include "irr/video/compressBlocks.h"
 #include "irr/asset/CImageData.h"
 #include "CReadFile.h"
 #include "os.h"
@@ -268,6 +269,9 @@ asset::IAsset* CImageLoaderPng::loadAsset(io::IReadFile* _file, const asset::IAs
 	images.push_back(image);
 #endif // _IRR_COMPILE_WITH_LIBPNG_
 
+    if (_params.loaderFlags&asset::IAssetLoader::ELPF_COMPRESS_TEXTURES)
+        video::blockCompressImages(images, _params.loaderFlags&asset::IAssetLoader::ELPF_HIGH_QUALITY_TEXTURE_COMPRESSION);
+
     asset::ICPUTexture* tex = asset::ICPUTexture::create(images);
     for (auto& img : images)
         img->drop();
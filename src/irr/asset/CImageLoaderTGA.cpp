@@ -11,6 +11,7 @@
 #include "irr/video/convertColor.h"
 #include "irr/asset/CImageData.h"
 #include "irr/asset/ICPUTexture.h"
+#include "irr/video/compressBlocks.h"
 
 
 namespace irr
@@ -290,6 +291,9 @@ asset::IAsset* CImageLoaderTGA::loadAsset(io::IReadFile* _file, const asset::IAs
 	delete [] data;
 	delete [] palette;
 
+    if (_params.loaderFlags&asset::IAssetLoader::ELPF_COMPRESS_TEXTURES)
+        video::blockCompressImages(images, _params.loaderFlags&asset::IAssetLoader::ELPF_HIGH_QUALITY_TEXTURE_COMPRESSION);
+
     asset::ICPUTexture* tex = asset::ICPUTexture::create(images);
     for (auto& img : images)
         img->drop();
@@ -18,6 +18,8 @@
 #include "irr/asset/COverdrawMeshOptimizer.h"
 #include "irr/asset/ICPUSkinnedMeshBuffer.h"
 #include "irr/asset/CSmoothNormalGenerator.h"
+#include "irr/asset/CVertexWelder.h"
+#include "irr/core/parallel_for.h"
 
 namespace irr
 {
@@ -336,7 +338,7 @@ asset::ICPUMeshBuffer* CMeshManipulator::createMeshBufferUniquePrimitives(asset:
 
 //
 asset::ICPUMeshBuffer* CMeshManipulator::calculateSmoothNormals(asset::ICPUMeshBuffer* inbuffer, bool makeNewMesh, float epsilon,
-	asset::E_VERTEX_ATTRIBUTE_ID normalAttrID, VxCmpFunction vxcmp) const
+	asset::E_VERTEX_ATTRIBUTE_ID normalAttrID, VxCmpFunction vxcmp, uint32_t threadCount) const
 {
 	if (inbuffer == nullptr)
 	{
@@ -352,53 +354,11 @@ asset::ICPUMeshBuffer* CMeshManipulator::calculateSmoothNormals(asset::ICPUMeshB
 	}
 
 	asset::ICPUMeshBuffer* outbuffer = (makeNewMesh == true) ? createMeshBufferDuplicate(inbuffer) : inbuffer;
-	CSmoothNormalGenerator::calculateNormals(outbuffer, epsilon, normalAttrID, vxcmp);
+	CSmoothNormalGenerator::calculateNormals(outbuffer, epsilon, normalAttrID, vxcmp, threadCount);
 
 	return outbuffer;
 }
 
-// Used by createMeshBufferWelded only
-static bool cmpVertices(asset::ICPUMeshBuffer* _inbuf, const void* _va, const void* _vb, size_t _vsize, const IMeshManipulator::SErrorMetric* _errMetrics, const IMeshManipulator* _meshManip)
-{
-    auto cmpInteger = [](uint32_t* _a, uint32_t* _b, size_t _n) -> bool {
-        return !memcmp(_a, _b, _n*4);
-    };
-
-    const uint8_t* va = (uint8_t*)_va, *vb = (uint8_t*)_vb;
-    auto desc = _inbuf->getMeshDataAndFormat();
-    for (size_t i = 0u; i < asset::EVAI_COUNT; ++i)
-    {
-        if (!desc->getMappedBuffer((asset::E_VERTEX_ATTRIBUTE_ID)i))
-            continue;
-
-        const auto atype = desc->getAttribFormat((asset::E_VERTEX_ATTRIBUTE_ID)i);
-        const auto cpa = asset::getFormatChannelCount(atype);
-
-        if (asset::isIntegerFormat(atype) || asset::isScaledFormat(atype))
-        {
-            uint32_t attr[8];
-            asset::ICPUMeshBuffer::getAttribute(attr, va, atype);
-            asset::ICPUMeshBuffer::getAttribute(attr+4, vb, atype);
-            if (!cmpInteger(attr, attr+4, cpa))
-                return false;
-        }
-        else
-        {
-            core::vectorSIMDf attr[2];
-            asset::ICPUMeshBuffer::getAttribute(attr[0], va, atype);
-            asset::ICPUMeshBuffer::getAttribute(attr[1], vb, atype);
-            if (!_meshManip->compareFloatingPointAttribute(attr[0], attr[1], cpa, _errMetrics[i]))
-                return false;
-        }
-
-        const uint32_t sz = asset::getTexelOrBlockSize(atype);
-        va += sz;
-        vb += sz;
-    }
-
-    return true;
-}
-
 //! Creates a copy of a mesh, which will have identical vertices welded together
 asset::ICPUMeshBuffer* CMeshManipulator::createMeshBufferWelded(asset::ICPUMeshBuffer *inbuffer, const SErrorMetric* _errMetrics, const bool& optimIndexType, const bool& makeNewMesh) const
 {
@@ -424,10 +384,6 @@ asset::ICPUMeshBuffer* CMeshManipulator::createMeshBufferWelded(asset::ICPUMeshB
         }
     }
 
-    auto cmpfunc = [&, inbuffer, this, vertexSize, _errMetrics](const void* _va, const void* _vb) {
-        return cmpVertices(inbuffer, _va, _vb, vertexSize, _errMetrics, this);
-    };
-
     size_t vertexCount = inbuffer->calcVertexCount();
     asset::E_INDEX_TYPE oldIndexType = inbuffer->getIndexType();
 
@@ -439,43 +395,27 @@ asset::ICPUMeshBuffer* CMeshManipulator::createMeshBufferWelded(asset::ICPUMeshB
     // reset redirect list
     uint32_t* redirects = new uint32_t[vertexCount];
 
-    uint32_t maxRedirect = 0;
-
     uint8_t* epicData = (uint8_t*)_IRR_ALIGNED_MALLOC(vertexSize*vertexCount,_IRR_SIMD_ALIGNMENT);
-    for (size_t i=0; i < vertexCount; i++)
+    core::parallel_for<size_t>(0u, vertexCount, [&](size_t _begin, size_t _end)
     {
-        uint8_t* currentVertexPtr = epicData+i*vertexSize;
-        for (size_t k=0; k<asset::EVAI_COUNT; k++)
+        for (size_t i=_begin; i < _end; i++)
         {
-            if (!bufferPresent[k])
-                continue;
-
-            size_t stride = oldDesc->getMappedBufferStride((asset::E_VERTEX_ATTRIBUTE_ID)k);
-            void* sourcePtr = inbuffer->getAttribPointer((asset::E_VERTEX_ATTRIBUTE_ID)k)+i*stride;
-            memcpy(currentVertexPtr,sourcePtr,vertexAttrSize[k]);
-            currentVertexPtr += vertexAttrSize[k];
-        }
-    }
-
-    for (size_t i=0; i<vertexCount; i++)
-    {
-        uint32_t redir = i;
-
-        for (size_t j = 0u; j < vertexCount; ++j)
-        {
-            if (i == j)
-                continue;
-            if (cmpfunc(epicData+vertexSize*i, epicData+vertexSize*j))
+            uint8_t* currentVertexPtr = epicData+i*vertexSize;
+            for (size_t k=0; k<asset::EVAI_COUNT; k++)
             {
-                redir = j;
-                break;
+                if (!bufferPresent[k])
+                    continue;
+
+                size_t stride = oldDesc->getMappedBufferStride((asset::E_VERTEX_ATTRIBUTE_ID)k);
+                void* sourcePtr = inbuffer->getAttribPointer((asset::E_VERTEX_ATTRIBUTE_ID)k)+i*stride;
+                memcpy(currentVertexPtr,sourcePtr,vertexAttrSize[k]);
+                currentVertexPtr += vertexAttrSize[k];
             }
         }
+    }, 0u, 0x4000u);
 
-        redirects[i] = redir;
-        if (redir>maxRedirect)
-            maxRedirect = redir;
-    }
+    // bucket vertices spatially and only compare against nearby ones
+    const uint32_t maxRedirect = CVertexWelder::computeRedirects(redirects, inbuffer, epicData, vertexSize, vertexCount, _errMetrics, this);
     _IRR_ALIGNED_FREE(epicData);
 
     void* oldIndices = inbuffer->getIndices();
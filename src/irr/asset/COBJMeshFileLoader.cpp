@@ -20,6 +20,10 @@
 
 #include "irr/core/Types.h"
 #include "irr/core/math/plane3dSIMD.h"
+#include "irr/core/parallel_for.h"
+
+#include <array>
+#include <cmath>
 
 /*
 namespace std
@@ -55,6 +59,8 @@ namespace asset
 //#endif
 
 static const uint32_t WORD_BUFFER_LENGTH = 512;
+//! files are only split into chunks of at least this size for parallel parsing
+static const size_t PARALLEL_CHUNK_MIN_SIZE = 1u<<20u;
 
 
 //! Constructor
@@ -88,10 +94,6 @@ asset::IAsset* COBJMeshFileLoader::loadAsset(io::IReadFile* _file, const asset::
 
 	const uint32_t WORD_BUFFER_LENGTH = 512;
 
-	core::vector<core::vector3df> vertexBuffer;
-	core::vector<core::vector3df> normalsBuffer;
-	core::vector<core::vector2df> textureCoordBuffer;
-
 	SObjMtl * currMtl = new SObjMtl();
 	ctx.Materials.push_back(currMtl);
 	uint32_t smoothingGroup=0;
@@ -104,13 +106,63 @@ asset::IAsset* COBJMeshFileLoader::loadAsset(io::IReadFile* _file, const asset::
 	_file->read((void*)buf, filesize);
 	const char* const bufEnd = buf+filesize;
 
-	// Process obj information
-	const char* bufPtr = buf;
+	// Tokenize and parse all numbers in parallel, chunks are split at line boundaries
+	core::vector<SObjChunk> chunks(core::max_<size_t>(core::min_<size_t>(core::getDefaultThreadCount(), filesize/PARALLEL_CHUNK_MIN_SIZE), 1u));
+	core::vector<const char*> chunkBounds(chunks.size()+1u);
+	chunkBounds.front() = buf;
+	chunkBounds.back() = bufEnd;
+	for (size_t i=1u; i<chunks.size(); i++)
+	{
+		const char* bound = core::max_<const char*>(buf+(filesize*i)/chunks.size(), chunkBounds[i-1u]);
+		while (bound != bufEnd && *bound != '\n' && *bound != '\r')
+			++bound;
+		chunkBounds[i] = bound;
+	}
+	core::parallel_for<size_t>(0u, chunks.size(), [&](size_t _begin, size_t _end)
+	{
+		for (size_t i=_begin; i<_end; i++)
+			parseChunk(chunks[i], chunkBounds[i], chunkBounds[i+1u]);
+	}, static_cast<uint32_t>(chunks.size()));
+
+	// Concatenate the attributes and remember where each chunk's ones start
+	core::vector<core::vector3df> vertexBuffer;
+	core::vector<core::vector3df> normalsBuffer;
+	core::vector<core::vector2df> textureCoordBuffer;
+	core::vector<std::array<uint32_t,3u> > chunkOffsets(chunks.size());
+	{
+		std::array<uint32_t,3u> total = {0u,0u,0u};
+		for (size_t i=0u; i<chunks.size(); i++)
+		{
+			chunkOffsets[i] = total;
+			total[0] += chunks[i].positions.size();
+			total[1] += chunks[i].uvs.size();
+			total[2] += chunks[i].normals.size();
+		}
+		vertexBuffer.reserve(total[0]);
+		textureCoordBuffer.reserve(total[1]);
+		normalsBuffer.reserve(total[2]);
+		for (auto& chunk : chunks)
+		{
+			vertexBuffer.insert(vertexBuffer.end(), chunk.positions.begin(), chunk.positions.end());
+			textureCoordBuffer.insert(textureCoordBuffer.end(), chunk.uvs.begin(), chunk.uvs.end());
+			normalsBuffer.insert(normalsBuffer.end(), chunk.normals.begin(), chunk.normals.end());
+			chunk.positions = core::vector<core::vector3df>();
+			chunk.uvs = core::vector<core::vector2df>();
+			chunk.normals = core::vector<core::vector3df>();
+		}
+	}
+
+	// Process statements and faces in file order
 	std::string grpName, mtlName;
 	bool mtlChanged=false;
     bool submeshLoadedFromCache = false;
-	while(bufPtr != bufEnd)
+	core::vector<uint32_t> faceCorners;
+	faceCorners.reserve(32); // should be large enough
+	for (size_t c=0u; c<chunks.size(); c++)
+	for (const SObjLineRecord& record : chunks[c].records)
 	{
+		const char* bufPtr = record.statement;
+		if (bufPtr)
 		switch(bufPtr[0])
 		{
 		case 'm':	// mtllib (material)
@@ -127,37 +179,6 @@ asset::IAsset* COBJMeshFileLoader::loadAsset(io::IReadFile* _file, const asset::
 		}
 			break;
 
-		case 'v':               // v, vn, vt
-            if (submeshLoadedFromCache)
-                break;
-			switch(bufPtr[1])
-			{
-			case ' ':          // vertex
-				{
-					core::vector3df vec;
-					bufPtr = readVec3(bufPtr, vec, bufEnd);
-					vertexBuffer.push_back(vec);
-				}
-				break;
-
-			case 'n':       // normal
-				{
-					core::vector3df vec;
-					bufPtr = readVec3(bufPtr, vec, bufEnd);
-					normalsBuffer.push_back(vec);
-				}
-				break;
-
-			case 't':       // texcoord
-				{
-					core::vector2df vec;
-					bufPtr = readUV(bufPtr, vec, bufEnd);
-					textureCoordBuffer.push_back(vec);
-				}
-				break;
-			}
-			break;
-
 		case 'g': // group name
 			{
 				char grp[WORD_BUFFER_LENGTH];
@@ -228,11 +249,13 @@ asset::IAsset* COBJMeshFileLoader::loadAsset(io::IReadFile* _file, const asset::
 			}
 			break;
 
-		case 'f':               // face
+		default:
+			break;
+		}	// end switch(bufPtr[0])
+		else // face
 		{
             if (submeshLoadedFromCache)
-                break;
-			char vertexWord[WORD_BUFFER_LENGTH]; // for retrieving vertex data
+                continue;
 			SObjVertex v;
 			// Assign vertex color from currently active material's diffuse color
 			if (mtlChanged)
@@ -245,36 +268,43 @@ asset::IAsset* COBJMeshFileLoader::loadAsset(io::IReadFile* _file, const asset::
 				mtlChanged=false;
 			}
 
-			// get all vertices data in this face (current line of obj _file)
-			const core::stringc wordBuffer = copyLine(bufPtr, bufEnd);
-			const char* linePtr = wordBuffer.c_str();
-			const char* const endPtr = linePtr+wordBuffer.size();
-
-			core::vector<uint32_t> faceCorners;
-			faceCorners.reserve(32); // should be large enough
-
-			// read in all vertices
-			linePtr = goNextWord(linePtr, endPtr);
-			while (0 != linePtr[0])
+			// obj indices are 1-based, negative ones are relative to the end of the attribute list at the time of the face
+			const std::array<uint32_t,3u> relativeBase = {
+				chunkOffsets[c][0]+record.positionCount,
+				chunkOffsets[c][1]+record.uvCount,
+				chunkOffsets[c][2]+record.normalCount
+			};
+			auto resolveIndex = [&relativeBase](int32_t _idx, uint32_t _type) -> int64_t
+			{
+				if (_idx>0)
+					return int64_t(_idx)-1;
+				else if (_idx<0)
+					return int64_t(relativeBase[_type])+_idx;
+				return -1;
+			};
+
+			faceCorners.clear();
+			bool validFace = true;
+			for (uint32_t k=0u; k<record.cornerCount; k++)
 			{
-				// Array to communicate with retrieveVertexIndices()
-				// sends the buffer sizes and gets the actual indices
-				// if index not set returns -1
-				int32_t Idx[3];
-				Idx[1] = Idx[2] = -1;
-
-				// read in next vertex's data
-				uint32_t wlength = copyWord(vertexWord, linePtr, WORD_BUFFER_LENGTH, endPtr);
-				// this function will also convert obj's 1-based index to c++'s 0-based index
-				retrieveVertexIndices(vertexWord, Idx, vertexWord+wlength+1, vertexBuffer.size(), textureCoordBuffer.size(), normalsBuffer.size());
-				v.pos[0] = vertexBuffer[Idx[0]].X;
-				v.pos[1] = vertexBuffer[Idx[0]].Y;
-				v.pos[2] = vertexBuffer[Idx[0]].Z;
+				const SObjFaceCorner& corner = chunks[c].corners[record.cornerBegin+k];
+				const int64_t posIx = resolveIndex(corner.idx[0], 0u);
+				const int64_t uvIx = resolveIndex(corner.idx[1], 1u);
+				const int64_t normalIx = resolveIndex(corner.idx[2], 2u);
+				if (posIx<0 || posIx>=int64_t(vertexBuffer.size()) || uvIx>=int64_t(textureCoordBuffer.size()) || normalIx>=int64_t(normalsBuffer.size()))
+				{
+					validFace = false;
+					break;
+				}
+
+				v.pos[0] = vertexBuffer[posIx].X;
+				v.pos[1] = vertexBuffer[posIx].Y;
+				v.pos[2] = vertexBuffer[posIx].Z;
 				//set texcoord
-				if ( -1 != Idx[1] )
+				if ( uvIx>=0 )
                 {
-					v.uv[0] = textureCoordBuffer[Idx[1]].X;
-					v.uv[1] = textureCoordBuffer[Idx[1]].Y;
+					v.uv[0] = textureCoordBuffer[uvIx].X;
+					v.uv[1] = textureCoordBuffer[uvIx].Y;
                 }
 				else
                 {
@@ -282,10 +312,10 @@ asset::IAsset* COBJMeshFileLoader::loadAsset(io::IReadFile* _file, const asset::
 					v.uv[1] = 0.f;
                 }
                 //set normal
-				if ( -1 != Idx[2] )
+				if ( normalIx>=0 )
                 {
 					core::vectorSIMDf simdNormal;
-					simdNormal.set(normalsBuffer[Idx[2]]);
+					simdNormal.set(normalsBuffer[normalIx]);
 					v.normal32bit = asset::quantizeNormal2_10_10_10(simdNormal);
                 }
 				else
@@ -294,45 +324,29 @@ asset::IAsset* COBJMeshFileLoader::loadAsset(io::IReadFile* _file, const asset::
 					currMtl->RecalculateNormals=true;
 				}
 
-				int vertLocation;
-				core::map<SObjVertex, int>::iterator n = currMtl->VertMap.find(v);
-				if (n!=currMtl->VertMap.end())
-				{
-					vertLocation = n->second;
-				}
-				else
-				{
+				auto inserted = currMtl->VertMap.insert(v, uint32_t(currMtl->Vertices.size()));
+				if (inserted.second)
 					currMtl->Vertices.push_back(v);
-					vertLocation = currMtl->Vertices.size() -1;
-					currMtl->VertMap.insert(std::pair<SObjVertex, int>(v, vertLocation));
-				}
-
-				faceCorners.push_back(vertLocation);
 
-				// go to next vertex
-				linePtr = goNextWord(linePtr, endPtr);
+				faceCorners.push_back(*inserted.first);
+			}
+			if (!validFace)
+			{
+				os::Printer::log("OBJ face references a vertex attribute which does not exist, skipping face", fullName.c_str(), ELL_WARNING);
+				continue;
 			}
 
 			// triangulate the face
-			for ( uint32_t i = 1; i < faceCorners.size() - 1; ++i )
+			for ( uint32_t i = 1; i+1 < faceCorners.size(); ++i )
 			{
 				// Add a triangle
 				currMtl->Indices.push_back( faceCorners[i+1] );
 				currMtl->Indices.push_back( faceCorners[i] );
 				currMtl->Indices.push_back( faceCorners[0] );
 			}
-			faceCorners.resize(0); // fast clear
-			faceCorners.reserve(32);
 		}
-		break;
-
-		case '#': // comment
-		default:
-			break;
-		}	// end switch(bufPtr[0])
-		// eat up rest of line
-		bufPtr = goNextLine(bufPtr, bufEnd);
-	}	// end while(bufPtr && (bufPtr-buf<filesize))
+	}
+	chunks.clear();
 	// Clean up the allocate obj _file contents
 	delete [] buf;
 
@@ -825,40 +839,6 @@ const char* COBJMeshFileLoader::readColor(const char* bufPtr, video::SColor& col
 }
 
 
-//! Read 3d vector of floats
-const char* COBJMeshFileLoader::readVec3(const char* bufPtr, core::vector3df& vec, const char* const bufEnd)
-{
-	const uint32_t WORD_BUFFER_LENGTH = 256;
-	char wordBuffer[WORD_BUFFER_LENGTH];
-
-	bufPtr = goAndCopyNextWord(wordBuffer, bufPtr, WORD_BUFFER_LENGTH, bufEnd);
-	sscanf(wordBuffer,"%f",&vec.X);
-	bufPtr = goAndCopyNextWord(wordBuffer, bufPtr, WORD_BUFFER_LENGTH, bufEnd);
-	sscanf(wordBuffer,"%f",&vec.Y);
-	bufPtr = goAndCopyNextWord(wordBuffer, bufPtr, WORD_BUFFER_LENGTH, bufEnd);
-	sscanf(wordBuffer,"%f",&vec.Z);
-
-	vec.X = -vec.X; // change handedness
-	return bufPtr;
-}
-
-
-//! Read 2d vector of floats
-const char* COBJMeshFileLoader::readUV(const char* bufPtr, core::vector2df& vec, const char* const bufEnd)
-{
-	const uint32_t WORD_BUFFER_LENGTH = 256;
-	char wordBuffer[WORD_BUFFER_LENGTH];
-
-	bufPtr = goAndCopyNextWord(wordBuffer, bufPtr, WORD_BUFFER_LENGTH, bufEnd);
-	sscanf(wordBuffer,"%f",&vec.X);
-	bufPtr = goAndCopyNextWord(wordBuffer, bufPtr, WORD_BUFFER_LENGTH, bufEnd);
-	sscanf(wordBuffer,"%f",&vec.Y);
-
-	vec.Y = 1-vec.Y; // change handedness
-	return bufPtr;
-}
-
-
 //! Read boolean value represented as 'on' or 'off'
 const char* COBJMeshFileLoader::readBool(const char* bufPtr, bool& tf, const char* const bufEnd)
 {
@@ -905,14 +885,14 @@ COBJMeshFileLoader::SObjMtl* COBJMeshFileLoader::findMtl(SContext& _ctx, const s
 
 
 //! skip space characters and stop on first non-space
-const char* COBJMeshFileLoader::goFirstWord(const char* buf, const char* const bufEnd, bool acrossNewlines)
+const char* COBJMeshFileLoader::goFirstWord(const char* buf, const char* const bufEnd, bool acrossNewlines) const
 {
 	// skip space characters
 	if (acrossNewlines)
 		while((buf != bufEnd) && core::isspace(*buf))
 			++buf;
 	else
-		while((buf != bufEnd) && core::isspace(*buf) && (*buf != '\n'))
+		while((buf != bufEnd) && core::isspace(*buf) && (*buf != '\n') && (*buf != '\r')) // lone '\r' ends a line too, same as in goNextLine
 			++buf;
 
 	return buf;
@@ -920,7 +900,7 @@ const char* COBJMeshFileLoader::goFirstWord(const char* buf, const char* const b
 
 
 //! skip current word and stop at beginning of next one
-const char* COBJMeshFileLoader::goNextWord(const char* buf, const char* const bufEnd, bool acrossNewlines)
+const char* COBJMeshFileLoader::goNextWord(const char* buf, const char* const bufEnd, bool acrossNewlines) const
 {
 	// skip current word
 	while(( buf != bufEnd ) && !core::isspace(*buf))
@@ -931,7 +911,7 @@ const char* COBJMeshFileLoader::goNextWord(const char* buf, const char* const bu
 
 
 //! Read until line break is reached and stop at the next non-space character
-const char* COBJMeshFileLoader::goNextLine(const char* buf, const char* const bufEnd)
+const char* COBJMeshFileLoader::goNextLine(const char* buf, const char* const bufEnd) const
 {
 	// look for newline characters
 	while(buf != bufEnd)
@@ -972,97 +952,267 @@ uint32_t COBJMeshFileLoader::copyWord(char* outBuf, const char* const inBuf, uin
 }
 
 
-core::stringc COBJMeshFileLoader::copyLine(const char* inBuf, const char* bufEnd)
+const char* COBJMeshFileLoader::goAndCopyNextWord(char* outBuf, const char* inBuf, uint32_t outBufLength, const char* bufEnd)
 {
-	if (!inBuf)
-		return core::stringc();
+	inBuf = goNextWord(inBuf, bufEnd, false);
+	copyWord(outBuf, inBuf, outBufLength, bufEnd);
+	return inBuf;
+}
+
+
+//! true if all 8 bytes are ASCII digits
+static inline bool isEightDigits(uint64_t _val)
+{
+	return !(((_val+0x4646464646464646ull)|(_val-0x3030303030303030ull))&0x8080808080808080ull);
+}
+
+//! converts 8 ASCII digits loaded as a little endian word with 3 multiplications instead of 8
+static inline uint32_t parseEightDigits(uint64_t _val)
+{
+	const uint64_t mask = 0x000000FF000000FFull;
+	const uint64_t mul1 = 0x000F424000000064ull; // 100 + (1000000ULL << 32)
+	const uint64_t mul2 = 0x0000271000000001ull; // 1 + (10000ULL << 32)
+	_val -= 0x3030303030303030ull;
+	_val = (_val*10ull)+(_val>>8ull);
+	_val = (((_val&mask)*mul1)+(((_val>>16ull)&mask)*mul2))>>32ull;
+	return static_cast<uint32_t>(_val);
+}
 
-	const char* ptr = inBuf;
-	while (ptr<bufEnd)
+//! accumulates a run of decimal digits into `_mantissa`, digits beyond 19 are only counted in `_droppedDigits`
+static inline const char* parseDigits(const char* _ptr, const char* const _end, uint64_t& _mantissa, uint32_t& _digitCount, int32_t& _droppedDigits)
+{
+	while (_end-_ptr>=8 && _digitCount+8u<=19u)
 	{
-		if (*ptr=='\n' || *ptr=='\r')
+		uint64_t word;
+		memcpy(&word,_ptr,8u);
+		if (!isEightDigits(word))
 			break;
-		++ptr;
+		_mantissa = _mantissa*100000000ull+parseEightDigits(word);
+		// leading zeros are not significant
+		if (_mantissa)
+			_digitCount += 8u;
+		_ptr += 8;
 	}
-	// we must avoid the +1 in case the array is used up
-	return core::stringc(inBuf, (uint32_t)(ptr-inBuf+((ptr < bufEnd) ? 1 : 0)));
+	for (; _ptr!=_end && core::isdigit(*_ptr); ++_ptr)
+	{
+		if (_digitCount<19u)
+		{
+			_mantissa = _mantissa*10ull+uint64_t(*_ptr-'0');
+			if (_mantissa)
+				_digitCount++;
+		}
+		else
+			_droppedDigits++;
+	}
+	return _ptr;
 }
 
-
-const char* COBJMeshFileLoader::goAndCopyNextWord(char* outBuf, const char* inBuf, uint32_t outBufLength, const char* bufEnd)
+//! parses a decimal float at `_ptr` without any locale lookups or copies, returns the pointer past it or nullptr if there was no number
+static const char* parseFloat(const char* _ptr, const char* const _end, float& _out)
 {
-	inBuf = goNextWord(inBuf, bufEnd, false);
-	copyWord(outBuf, inBuf, outBufLength, bufEnd);
-	return inBuf;
+	static const double powersOfTen[] = {
+		1e0,1e1,1e2,1e3,1e4,1e5,1e6,1e7,1e8,1e9,1e10,1e11,
+		1e12,1e13,1e14,1e15,1e16,1e17,1e18,1e19,1e20,1e21,1e22
+	};
+
+	const char* const start = _ptr;
+	bool negative = false;
+	if (_ptr!=_end && (*_ptr=='-' || *_ptr=='+'))
+		negative = *(_ptr++)=='-';
+
+	uint64_t mantissa = 0ull;
+	uint32_t digitCount = 0u;
+	int32_t exponent = 0;
+	const char* digitsStart = _ptr;
+	_ptr = parseDigits(_ptr,_end,mantissa,digitCount,exponent);
+	bool anyDigits = _ptr!=digitsStart;
+	if (_ptr!=_end && *_ptr=='.')
+	{
+		++_ptr;
+		int32_t dropped = 0;
+		const char* fractionStart = _ptr;
+		_ptr = parseDigits(_ptr,_end,mantissa,digitCount,dropped);
+		anyDigits = anyDigits || _ptr!=fractionStart;
+		// leading fractional zeros do not count as digits but still shift the value
+		exponent -= int32_t(_ptr-fractionStart)-dropped;
+	}
+	if (!anyDigits)
+	{
+		// nan, inf and friends
+		char word[64];
+		size_t len = 0u;
+		for (const char* p=start; p!=_end && !core::isspace(*p) && len<sizeof(word)-1u; ++p)
+			word[len++] = *p;
+		word[len] = 0;
+		char* parsedEnd = nullptr;
+		_out = strtof(word,&parsedEnd);
+		return parsedEnd!=word ? start+(parsedEnd-word):nullptr;
+	}
+
+	if (_ptr!=_end && (*_ptr=='e' || *_ptr=='E'))
+	{
+		const char* expPtr = _ptr+1;
+		bool negativeExp = false;
+		if (expPtr!=_end && (*expPtr=='-' || *expPtr=='+'))
+			negativeExp = *(expPtr++)=='-';
+		if (expPtr!=_end && core::isdigit(*expPtr))
+		{
+			int32_t explicitExp = 0;
+			for (; expPtr!=_end && core::isdigit(*expPtr); ++expPtr)
+			if (explicitExp<100000)
+				explicitExp = explicitExp*10+(*expPtr-'0');
+			exponent += negativeExp ? -explicitExp:explicitExp;
+			_ptr = expPtr;
+		}
+	}
+
+	double value = double(mantissa);
+	if (exponent<0)
+	{
+		while (exponent<-22 && value!=0.0)
+		{
+			value /= powersOfTen[22];
+			exponent += 22;
+		}
+		value /= powersOfTen[core::min_(-exponent,22)];
+	}
+	else
+	{
+		while (exponent>22 && !std::isinf(value))
+		{
+			value *= powersOfTen[22];
+			exponent -= 22;
+		}
+		value *= powersOfTen[core::min_(exponent,22)];
+	}
+	_out = static_cast<float>(negative ? -value:value);
+	return _ptr;
 }
 
+//! parses `count` whitespace separated floats following the current word, missing ones are left untouched
+static const char* parseFloats(const char* _ptr, const char* const _end, float* _out, uint32_t _count)
+{
+	// skip the statement keyword
+	while (_ptr!=_end && !core::isspace(*_ptr))
+		++_ptr;
+	for (uint32_t i=0u; i<_count; i++)
+	{
+		while (_ptr!=_end && (*_ptr==' ' || *_ptr=='\t'))
+			++_ptr;
+		const char* next = parseFloat(_ptr,_end,_out[i]);
+		if (!next)
+			break;
+		_ptr = next;
+	}
+	return _ptr;
+}
 
-bool COBJMeshFileLoader::retrieveVertexIndices(char* vertexData, int32_t* idx, const char* bufEnd, uint32_t vbsize, uint32_t vtsize, uint32_t vnsize)
+//! parses an optionally signed integer, returns 0 if there was none (0 is never a valid obj index)
+static inline const char* parseIndex(const char* _ptr, const char* const _end, int32_t& _out)
 {
-	char word[16] = "";
-	const char* p = goFirstWord(vertexData, bufEnd);
-	uint32_t idxType = 0;	// 0 = posIdx, 1 = texcoordIdx, 2 = normalIdx
+	bool negative = false;
+	if (_ptr!=_end && *_ptr=='-')
+	{
+		negative = true;
+		++_ptr;
+	}
+	int64_t value = 0;
+	for (; _ptr!=_end && core::isdigit(*_ptr); ++_ptr)
+	if (value<=INT32_MAX)
+		value = value*10+(*_ptr-'0');
+	value = core::min_<int64_t>(value,INT32_MAX);
+	_out = static_cast<int32_t>(negative ? -value:value);
+	return _ptr;
+}
 
-	uint32_t i = 0;
-	while ( p != bufEnd )
+void COBJMeshFileLoader::parseChunk(SObjChunk& chunk, const char* bufPtr, const char* const bufEnd) const
+{
+	bufPtr = goFirstWord(bufPtr, bufEnd);
+	while (bufPtr != bufEnd)
 	{
-		if ( ( core::isdigit(*p)) || (*p == '-') )
+		switch (bufPtr[0])
 		{
-			// build up the number
-			word[i++] = *p;
-		}
-		else if ( *p == '/' || *p == ' ' || *p == '\0' )
-		{
-			// number is completed. Convert and store it
-			word[i] = '\0';
-			// if no number was found index will become 0 and later on -1 by decrement
-			sscanf(word,"%u",idx+idxType);
-			if (idx[idxType]<0)
+		case 'v':               // v, vn, vt
+			switch (bufPtr[1])
 			{
-				switch (idxType)
+			case ' ':          // vertex
+			case '\t':
 				{
-					case 0:
-						idx[idxType] += vbsize;
-						break;
-					case 1:
-						idx[idxType] += vtsize;
-						break;
-					case 2:
-						idx[idxType] += vnsize;
-						break;
+					core::vector3df vec;
+					bufPtr = parseFloats(bufPtr, bufEnd, &vec.X, 3u);
+					vec.X = -vec.X; // change handedness
+					chunk.positions.push_back(vec);
 				}
-			}
-			else
-				idx[idxType]-=1;
+				break;
 
-			// reset the word
-			word[0] = '\0';
-			i = 0;
+			case 'n':       // normal
+				{
+					core::vector3df vec;
+					bufPtr = parseFloats(bufPtr, bufEnd, &vec.X, 3u);
+					vec.X = -vec.X; // change handedness
+					chunk.normals.push_back(vec);
+				}
+				break;
 
-			// go to the next kind of index type
-			if (*p == '/')
-			{
-				if ( ++idxType > 2 )
+			case 't':       // texcoord
 				{
-					// error checking, shouldn't reach here unless file is wrong
-					idxType = 0;
+					core::vector2df vec;
+					bufPtr = parseFloats(bufPtr, bufEnd, &vec.X, 2u);
+					vec.Y = 1-vec.Y; // change handedness
+					chunk.uvs.push_back(vec);
 				}
+				break;
 			}
-			else
+			break;
+
+		case 'f':               // face
 			{
-				// set all missing values to disable (=-1)
-				while (++idxType < 3)
-					idx[idxType]=-1;
-				++p;
-				break; // while
+				SObjLineRecord record;
+				record.statement = nullptr;
+				record.cornerBegin = chunk.corners.size();
+				record.positionCount = chunk.positions.size();
+				record.uvCount = chunk.uvs.size();
+				record.normalCount = chunk.normals.size();
+
+				// read in all vertices of the form pos[/uv][/normal]
+				const char* linePtr = goNextWord(bufPtr, bufEnd, false);
+				while (linePtr != bufEnd && *linePtr != '\n' && *linePtr != '\r')
+				{
+					SObjFaceCorner corner = {{0,0,0}};
+					for (uint32_t idxType=0u; idxType<3u; idxType++)
+					{
+						linePtr = parseIndex(linePtr, bufEnd, corner.idx[idxType]);
+						if (linePtr == bufEnd || *linePtr != '/')
+							break;
+						++linePtr;
+					}
+					if (corner.idx[0] != 0)
+						chunk.corners.push_back(corner);
+
+					// go to next vertex
+					linePtr = goNextWord(linePtr, bufEnd, false);
+				}
+
+				record.cornerCount = chunk.corners.size()-record.cornerBegin;
+				chunk.records.push_back(record);
+				bufPtr = linePtr;
 			}
-		}
+			break;
 
-		// go to the next char
-		++p;
-	}
+		case 'm':	// mtllib (material)
+		case 'g':	// group name
+		case 's':	// smoothing group
+		case 'u':	// usemtl
+			chunk.records.push_back({bufPtr, 0u, 0u, uint32_t(chunk.positions.size()), uint32_t(chunk.uvs.size()), uint32_t(chunk.normals.size())});
+			break;
 
-	return true;
+		case '#': // comment
+		default:
+			break;
+		}	// end switch(bufPtr[0])
+		// eat up rest of line
+		bufPtr = goNextLine(bufPtr, bufEnd);
+	}
 }
 
 std::string COBJMeshFileLoader::genKeyForMeshBuf(const SContext & _ctx, const std::string & _baseKey, const std::string & _mtlName, const std::string & _grpName) const
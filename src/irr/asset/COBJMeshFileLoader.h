@@ -8,6 +8,7 @@
 #include "irr/asset/IAssetLoader.h"
 #include "irr/core/Types.h"
 #include "irr/core/irrString.h"
+#include "irr/core/flat_hash_map.h"
 
 namespace irr
 {
@@ -59,6 +60,20 @@ public:
     uint32_t normal32bit;
 } PACK_STRUCT;
 
+struct SObjVertexHash
+{
+    inline size_t operator()(const SObjVertex& k) const
+    {
+        // bitwise hash is fine since operator== compares exactly
+        uint32_t words[6];
+        memcpy(words, &k, sizeof(words));
+        uint64_t h = 0xcbf29ce484222325ull;
+        for (uint32_t w : words)
+            h = (h^w)*0x100000001b3ull;
+        return h;
+    }
+};
+
 class SObjVertex16
 {
 public:
@@ -134,6 +149,33 @@ class COBJMeshFileLoader : public asset::IAssetLoader
         }
     };
 
+    //! One `f` line worth of corners, indices are kept as written in the file (1-based, negative if relative, 0 if absent)
+    struct SObjFaceCorner
+    {
+        int32_t idx[3];
+    };
+    //! A line which cannot be handled within its chunk, i.e. a face or a state-changing statement
+    struct SObjLineRecord
+    {
+        //! beginning of the line for statements (mtllib, usemtl, g, s), nullptr for faces
+        const char* statement;
+        uint32_t cornerBegin;
+        uint32_t cornerCount;
+        //! v, vt and vn lines seen in this chunk before this one, needed to resolve relative indices
+        uint32_t positionCount;
+        uint32_t uvCount;
+        uint32_t normalCount;
+    };
+    //! Results of tokenizing a range of whole lines, independent of any other range
+    struct SObjChunk
+    {
+        core::vector<core::vector3df> positions;
+        core::vector<core::vector3df> normals;
+        core::vector<core::vector2df> uvs;
+        core::vector<SObjFaceCorner> corners;
+        core::vector<SObjLineRecord> records;
+    };
+
 protected:
 	//! destructor
 	virtual ~COBJMeshFileLoader();
@@ -185,7 +227,7 @@ private:
                 Material = o.Material;
             }
 
-            core::map<SObjVertex, int> VertMap;
+            core::flat_hash_map<SObjVertex, uint32_t, SObjVertexHash> VertMap;
             core::vector<SObjVertex> Vertices;
             core::vector<uint32_t> Indices;
             video::SCPUMaterial Material;
@@ -200,16 +242,13 @@ private:
 	const char* readTextures(const SContext& _ctx, const char* bufPtr, const char* const bufEnd, SObjMtl* currMaterial, const io::path& relPath);
 
 	// returns a pointer to the first printable character available in the buffer
-	const char* goFirstWord(const char* buf, const char* const bufEnd, bool acrossNewlines=true);
+	const char* goFirstWord(const char* buf, const char* const bufEnd, bool acrossNewlines=true) const;
 	// returns a pointer to the first printable character after the first non-printable
-	const char* goNextWord(const char* buf, const char* const bufEnd, bool acrossNewlines=true);
+	const char* goNextWord(const char* buf, const char* const bufEnd, bool acrossNewlines=true) const;
 	// returns a pointer to the next printable character after the first line break
-	const char* goNextLine(const char* buf, const char* const bufEnd);
+	const char* goNextLine(const char* buf, const char* const bufEnd) const;
 	// copies the current word from the inBuf to the outBuf
 	uint32_t copyWord(char* outBuf, const char* inBuf, uint32_t outBufLength, const char* const pBufEnd);
-	// copies the current line from the inBuf to the outBuf
-	core::stringc copyLine(const char* inBuf, const char* const bufEnd);
-
 	// combination of goNextWord followed by copyWord
 	const char* goAndCopyNextWord(char* outBuf, const char* inBuf, uint32_t outBufLength, const char* const pBufEnd);
 
@@ -221,17 +260,11 @@ private:
 
 	//! Read RGB color
 	const char* readColor(const char* bufPtr, video::SColor& color, const char* const pBufEnd);
-	//! Read 3d vector of floats
-	const char* readVec3(const char* bufPtr, core::vector3df& vec, const char* const pBufEnd);
-	//! Read 2d vector of floats
-	const char* readUV(const char* bufPtr, core::vector2df& vec, const char* const pBufEnd);
 	//! Read boolean value represented as 'on' or 'off'
 	const char* readBool(const char* bufPtr, bool& tf, const char* const bufEnd);
 
-	// reads and convert to integer the vertex indices in a line of obj file's face statement
-	// -1 for the index if it doesn't exist
-	// indices are changed to 0-based index instead of 1-based from the obj file
-	bool retrieveVertexIndices(char* vertexData, int32_t* idx, const char* bufEnd, uint32_t vbsize, uint32_t vtsize, uint32_t vnsize);
+	//! Tokenizes [begin,end) which must start and end at line boundaries, safe to call concurrently for disjoint ranges
+	void parseChunk(SObjChunk& chunk, const char* begin, const char* const end) const;
 
     std::string genKeyForMeshBuf(const SContext& _ctx, const std::string& _baseKey, const std::string& _mtlName, const std::string& _grpName) const;
 
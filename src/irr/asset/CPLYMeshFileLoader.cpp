@@ -243,6 +243,12 @@ asset::IAsset* CPLYMeshFileLoader::loadAsset(io::IReadFile* _file, const asset::
             core::vector<core::vectorSIMDf> attribs[4];
             core::vector<uint32_t> indices;
 
+			// vertices of binary little endian files can skip the intermediate attribute arrays and go straight into the vertex buffer
+			uint32_t vertexElementCount = 0u;
+			for (const auto* el : ctx.ElementList)
+				vertexElementCount += el->Name == "vertex";
+			bool readDirectly = false;
+
 			bool hasNormals=true;
 			// loop through each of the elements
 			for (uint32_t i=0; i<ctx.ElementList.size(); ++i)
@@ -250,6 +256,20 @@ asset::IAsset* CPLYMeshFileLoader::loadAsset(io::IReadFile* _file, const asset::
 				// do we want this element type?
 				if (ctx.ElementList[i]->Name == "vertex")
 				{
+					SVertexDecodePlan plan;
+					if (vertexElementCount == 1u && buildVertexDecodePlan(ctx, *ctx.ElementList[i], plan))
+					{
+						uint8_t* vertices = createVertexBuffer(mb, plan.Present, ctx.ElementList[i]->Count);
+						if (!vertices || !readVerticesDirectly(ctx, *ctx.ElementList[i], plan, vertices))
+						{
+							mb->drop();
+							return nullptr;
+						}
+						readDirectly = true;
+						hasNormals = plan.Present[E_NORM];
+						continue;
+					}
+
 					// loop through vertex properties
 					for (uint32_t j=0; j < ctx.ElementList[i]->Count; ++j)
 						hasNormals &= readVertex(ctx, *ctx.ElementList[i], attribs);
@@ -268,7 +288,7 @@ asset::IAsset* CPLYMeshFileLoader::loadAsset(io::IReadFile* _file, const asset::
 				}
 			}
 
-            if (!genVertBuffersForMBuffer(mb, attribs))
+            if (!readDirectly && !genVertBuffersForMBuffer(mb, attribs))
             {
                 mb->drop();
                 return nullptr;
@@ -286,7 +306,7 @@ asset::IAsset* CPLYMeshFileLoader::loadAsset(io::IReadFile* _file, const asset::
             else
             {
                 mb->setPrimitiveType(asset::EPT_POINTS);
-                mb->setIndexCount(attribs[E_POS].size());
+                mb->setIndexCount(readDirectly ? vertCount : attribs[E_POS].size());
                 //mb->getMaterial().setFlag(video::EMF_POINTCLOUD, true);
             }
 
@@ -396,6 +416,196 @@ bool CPLYMeshFileLoader::readVertex(SContext& _ctx, const SPLYElement& Element,
 }
 
 
+bool CPLYMeshFileLoader::buildVertexDecodePlan(const SContext& _ctx, const SPLYElement& _element, SVertexDecodePlan& _outPlan) const
+{
+	if (!_ctx.IsBinaryFile || _ctx.IsWrongEndian || !_element.IsFixedWidth || _element.KnownSize == 0u || _element.KnownSize > PLY_INPUT_BUFFER_SIZE/2u)
+		return false;
+
+	// same property names as readVertex
+	struct SComponent
+	{
+		const char* name;
+		uint32_t attrib;
+		uint32_t component;
+	};
+	const SComponent components[] = {
+		{"x",E_POS,0u},{"y",E_POS,1u},{"z",E_POS,2u},
+		{"nx",E_NORM,0u},{"ny",E_NORM,1u},{"nz",E_NORM,2u},
+		{"u",E_UV,0u},{"s",E_UV,0u},{"v",E_UV,1u},{"t",E_UV,1u},
+		{"red",E_COL,0u},{"green",E_COL,1u},{"blue",E_COL,2u},{"alpha",E_COL,3u}
+	};
+	const uint32_t componentCounts[4] = { 3u, 4u, 2u, 3u };
+
+	struct SMapping
+	{
+		uint32_t srcOffset;
+		uint32_t attrib;
+		uint32_t component;
+		E_PLY_PROPERTY_TYPE type;
+		uint32_t typeSize;
+	};
+	core::vector<SMapping> mappings;
+	bool covered[4][4] = {};
+	std::fill(_outPlan.Present, _outPlan.Present+4, false);
+
+	uint32_t srcOffset = 0u;
+	for (const auto& prop : _element.Properties)
+	{
+		if (prop.Type == EPLYPT_LIST || prop.Type == EPLYPT_UNKNOWN)
+			return false;
+
+		for (const auto& comp : components)
+		if (prop.Name == comp.name)
+		{
+			mappings.push_back({srcOffset,comp.attrib,comp.component,prop.Type,prop.size()});
+			_outPlan.Present[comp.attrib] = true;
+			covered[comp.attrib][comp.component] = true;
+			break;
+		}
+		srcOffset += prop.size();
+	}
+	// without positions genVertBuffersForMBuffer would produce an empty buffer, let the generic path deal with such files
+	if (!_outPlan.Present[E_POS])
+		return false;
+
+	_outPlan.Stride = calcVertexLayout(_outPlan.Present, _outPlan.Offsets);
+
+	// defaults match the ones readVertex starts every vertex with
+	std::fill(_outPlan.DefaultVertex, _outPlan.DefaultVertex+12, 0.f);
+	if (_outPlan.Present[E_COL])
+		_outPlan.DefaultVertex[_outPlan.Offsets[E_COL]/sizeof(float)+3u] = 1.f;
+	if (_outPlan.Present[E_NORM])
+		_outPlan.DefaultVertex[_outPlan.Offsets[E_NORM]/sizeof(float)+1u] = 1.f;
+	_outPlan.NeedsDefaults = false;
+	for (uint32_t a = 0u; a < 4u; ++a)
+	for (uint32_t c = 0u; c < componentCounts[a]; ++c)
+		_outPlan.NeedsDefaults |= _outPlan.Present[a] && !covered[a][c];
+
+	// merge neighbouring properties of the same type which also end up next to each other, typically "x y z" or "red green blue"
+	_outPlan.Runs.clear();
+	for (const auto& m : mappings)
+	{
+		const uint32_t dstOffset = static_cast<uint32_t>(_outPlan.Offsets[m.attrib]+m.component*sizeof(float));
+		const bool isColor = m.attrib == E_COL;
+		if (_outPlan.Runs.size())
+		{
+			SVertexDecodeRun& last = _outPlan.Runs.back();
+			if (last.Type == m.type && last.IsColor == isColor && last.Count < 4u &&
+				last.SrcOffset+last.Count*m.typeSize == m.srcOffset && last.DstOffset+last.Count*sizeof(float) == dstOffset)
+			{
+				last.Count++;
+				continue;
+			}
+		}
+		_outPlan.Runs.push_back({m.srcOffset,dstOffset,1u,m.type,isColor});
+	}
+
+	return true;
+}
+
+
+namespace
+{
+	template<typename T>
+	inline T readUnaligned(const uint8_t* _src)
+	{
+		T retval;
+		memcpy(&retval, _src, sizeof(T));
+		return retval;
+	}
+}
+
+bool CPLYMeshFileLoader::readVerticesDirectly(SContext& _ctx, const SPLYElement& _element, const SVertexDecodePlan& _plan, uint8_t* _dst)
+{
+	const uint32_t vertexSize = _element.KnownSize;
+
+	auto decodeVertex = [&_plan](const uint8_t* _src, uint8_t* _out)
+	{
+		if (_plan.NeedsDefaults)
+			memcpy(_out, _plan.DefaultVertex, _plan.Stride);
+
+		for (const auto& run : _plan.Runs)
+		{
+			const uint8_t* src = _src+run.SrcOffset;
+			float* out = reinterpret_cast<float*>(_out+run.DstOffset);
+			switch (run.Type)
+			{
+				case EPLYPT_FLOAT32:
+					memcpy(out, src, run.Count*sizeof(float));
+					break;
+				case EPLYPT_INT8:
+					if (run.IsColor)
+					{
+#ifdef __IRR_COMPILE_WITH_X86_SIMD_
+						// up to 4 unsigned bytes to normalized floats at once
+						uint32_t packed = 0u;
+						memcpy(&packed, src, run.Count);
+						const __m128 rgba = _mm_div_ps(_mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(packed))), _mm_set1_ps(255.f));
+						if (run.Count == 4u)
+							_mm_storeu_ps(out, rgba);
+						else
+						{
+							float tmp[4];
+							_mm_storeu_ps(tmp, rgba);
+							memcpy(out, tmp, run.Count*sizeof(float));
+						}
+#else
+						for (uint32_t i = 0u; i < run.Count; ++i)
+							out[i] = float(src[i])/255.f;
+#endif
+					}
+					else
+					{
+						for (uint32_t i = 0u; i < run.Count; ++i)
+							out[i] = float(reinterpret_cast<const int8_t*>(src)[i]);
+					}
+					break;
+				case EPLYPT_INT16:
+					for (uint32_t i = 0u; i < run.Count; ++i)
+						out[i] = run.IsColor ? float(readUnaligned<uint16_t>(src+i*2u))/255.f : float(readUnaligned<int16_t>(src+i*2u));
+					break;
+				case EPLYPT_INT32:
+					for (uint32_t i = 0u; i < run.Count; ++i)
+						out[i] = run.IsColor ? float(readUnaligned<uint32_t>(src+i*4u))/255.f : float(readUnaligned<int32_t>(src+i*4u));
+					break;
+				case EPLYPT_FLOAT64:
+					for (uint32_t i = 0u; i < run.Count; ++i)
+						out[i] = float(readUnaligned<double>(src+i*8u));
+					break;
+				default:
+					break;
+			}
+		}
+	};
+
+	uint32_t remaining = _element.Count;
+	while (remaining)
+	{
+		if (static_cast<uint32_t>(_ctx.EndPointer-_ctx.StartPointer) < vertexSize)
+		{
+			fillBuffer(_ctx);
+			if (static_cast<uint32_t>(_ctx.EndPointer-_ctx.StartPointer) < vertexSize)
+			{
+				os::Printer::log("PLY file ends before all vertices were read", _ctx.File->getFileName().c_str(), ELL_ERROR);
+				return false;
+			}
+		}
+
+		// decode every whole vertex currently in the buffer in one go
+		const uint32_t available = core::min_(remaining, static_cast<uint32_t>(_ctx.EndPointer-_ctx.StartPointer)/vertexSize);
+		const uint8_t* src = reinterpret_cast<const uint8_t*>(_ctx.StartPointer);
+		for (uint32_t i = 0u; i < available; ++i)
+			decodeVertex(src+size_t(i)*vertexSize, _dst+size_t(i)*_plan.Stride);
+
+		_ctx.StartPointer += size_t(available)*vertexSize;
+		_dst += size_t(available)*_plan.Stride;
+		remaining -= available;
+	}
+
+	return true;
+}
+
+
 bool CPLYMeshFileLoader::readFace(SContext& _ctx, const SPLYElement &Element, core::vector<uint32_t>& _outIndices)
 {
 	if (!_ctx.IsBinaryFile)
@@ -573,30 +783,12 @@ bool CPLYMeshFileLoader::genVertBuffersForMBuffer(asset::ICPUMeshBuffer* _mbuf,
             _buf->setAttribute(v, _vaid, i++);
     };
 
-    size_t sizes[4];
-    sizes[E_POS] = !_attribs[E_POS].empty() * 3 * sizeof(float);
-    sizes[E_COL] = !_attribs[E_COL].empty() * 4 * sizeof(float);
-    sizes[E_UV] = !_attribs[E_UV].empty() * 2 * sizeof(float);
-    sizes[E_NORM] = !_attribs[E_NORM].empty() * 3 * sizeof(float);
-
-    size_t offsets[4]{ 0u };
-    for (size_t i = 1u; i < 4u; ++i)
-        offsets[i] = offsets[i-1] + sizes[i-1];
-
-    const size_t stride = std::accumulate(sizes, sizes+4, static_cast<size_t>(0));
-
-    asset::ICPUBuffer* buf = new asset::ICPUBuffer(_attribs[E_POS].size() * stride);
+    bool present[4];
+    for (size_t i = 0u; i < 4u; ++i)
+        present[i] = !_attribs[i].empty();
 
-    auto desc = _mbuf->getMeshDataAndFormat();
-    if (sizes[E_POS])
-        desc->setVertexAttrBuffer(buf, asset::EVAI_ATTR0, asset::EF_R32G32B32_SFLOAT, stride, offsets[E_POS]);
-    if (sizes[E_COL])
-        desc->setVertexAttrBuffer(buf, asset::EVAI_ATTR1, asset::EF_R32G32B32A32_SFLOAT, stride, offsets[E_COL]);
-    if (sizes[E_UV])
-        desc->setVertexAttrBuffer(buf, asset::EVAI_ATTR2, asset::EF_R32G32_SFLOAT, stride, offsets[E_UV]);
-    if (sizes[E_NORM])
-        desc->setVertexAttrBuffer(buf, asset::EVAI_ATTR3, asset::EF_R32G32B32_SFLOAT, stride, offsets[E_NORM]);
-    buf->drop();
+    if (!createVertexBuffer(_mbuf, present, _attribs[E_POS].size()) && _attribs[E_POS].size())
+        return false;
 
     asset::E_VERTEX_ATTRIBUTE_ID vaids[4];
     vaids[E_POS] = asset::EVAI_ATTR0;
@@ -606,13 +798,51 @@ bool CPLYMeshFileLoader::genVertBuffersForMBuffer(asset::ICPUMeshBuffer* _mbuf,
 
     for (size_t i = 0u; i < 4u; ++i)
     {
-        if (sizes[i])
+        if (present[i])
             putAttr(_mbuf, i, vaids[i]);
     }
 
     return true;
 }
 
+size_t CPLYMeshFileLoader::calcVertexLayout(const bool _present[4], size_t _outOffsets[4])
+{
+    size_t sizes[4];
+    sizes[E_POS] = _present[E_POS] * 3 * sizeof(float);
+    sizes[E_COL] = _present[E_COL] * 4 * sizeof(float);
+    sizes[E_UV] = _present[E_UV] * 2 * sizeof(float);
+    sizes[E_NORM] = _present[E_NORM] * 3 * sizeof(float);
+
+    _outOffsets[0] = 0u;
+    for (size_t i = 1u; i < 4u; ++i)
+        _outOffsets[i] = _outOffsets[i-1] + sizes[i-1];
+
+    return std::accumulate(sizes, sizes+4, static_cast<size_t>(0));
+}
+
+uint8_t* CPLYMeshFileLoader::createVertexBuffer(asset::ICPUMeshBuffer* _mbuf, const bool _present[4], size_t _vertexCount) const
+{
+    size_t offsets[4];
+    const size_t stride = calcVertexLayout(_present, offsets);
+
+    asset::ICPUBuffer* buf = new asset::ICPUBuffer(_vertexCount * stride);
+    uint8_t* data = reinterpret_cast<uint8_t*>(buf->getPointer());
+
+    auto desc = _mbuf->getMeshDataAndFormat();
+    if (_present[E_POS])
+        desc->setVertexAttrBuffer(buf, asset::EVAI_ATTR0, asset::EF_R32G32B32_SFLOAT, stride, offsets[E_POS]);
+    if (_present[E_COL])
+        desc->setVertexAttrBuffer(buf, asset::EVAI_ATTR1, asset::EF_R32G32B32A32_SFLOAT, stride, offsets[E_COL]);
+    if (_present[E_UV])
+        desc->setVertexAttrBuffer(buf, asset::EVAI_ATTR2, asset::EF_R32G32_SFLOAT, stride, offsets[E_UV]);
+    if (_present[E_NORM])
+        desc->setVertexAttrBuffer(buf, asset::EVAI_ATTR3, asset::EF_R32G32B32_SFLOAT, stride, offsets[E_NORM]);
+    buf->drop();
+
+    // the descriptor holds on to the buffer now (if any attribute is present at all)
+    return stride ? data : nullptr;
+}
+
 
 E_PLY_PROPERTY_TYPE CPLYMeshFileLoader::getPropertyType(const char* typeString) const
 {
@@ -851,7 +1081,7 @@ uint32_t CPLYMeshFileLoader::getInt(SContext& _ctx, E_PLY_PROPERTY_TYPE t)
 			switch (t)
 			{
 			case EPLYPT_INT8:
-				retVal = *_ctx.StartPointer;
+				retVal = *reinterpret_cast<uint8_t*>(_ctx.StartPointer);
                 _ctx.StartPointer++;
 				break;
 			case EPLYPT_INT16:
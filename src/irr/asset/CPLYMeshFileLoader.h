@@ -152,6 +152,28 @@ private:
 
     enum { E_POS = 0, E_UV = 2, E_NORM = 3, E_COL = 1 };
 
+	//! Run of consecutive properties of one type which land in consecutive float components of the output vertex
+	struct SVertexDecodeRun
+	{
+		uint32_t SrcOffset;
+		uint32_t DstOffset;
+		uint32_t Count;
+		E_PLY_PROPERTY_TYPE Type;
+		// integer colors are normalized, like readVertex does
+		bool IsColor;
+	};
+	//! Precomputed from the header, decodes fixed width binary little endian vertices straight into the interleaved vertex buffer
+	struct SVertexDecodePlan
+	{
+		core::vector<SVertexDecodeRun> Runs;
+		bool Present[4];
+		size_t Offsets[4];
+		size_t Stride;
+		// whole output vertex with the defaults readVertex would use, only needed if some present attribute has components missing in the file
+		float DefaultVertex[12];
+		bool NeedsDefaults;
+	};
+
 	bool allocateBuffer(SContext& _ctx);
 	char* getNextLine(SContext& _ctx);
 	char* getNextWord(SContext& _ctx);
@@ -159,6 +181,8 @@ private:
 	E_PLY_PROPERTY_TYPE getPropertyType(const char* typeString) const;
 
 	bool readVertex(SContext& _ctx, const SPLYElement &Element, core::vector<core::vectorSIMDf> _attribs[4]);
+	bool buildVertexDecodePlan(const SContext& _ctx, const SPLYElement& _element, SVertexDecodePlan& _outPlan) const;
+	bool readVerticesDirectly(SContext& _ctx, const SPLYElement& _element, const SVertexDecodePlan& _plan, uint8_t* _dst);
 	bool readFace(SContext& _ctx, const SPLYElement &Element, core::vector<uint32_t>& _outIndices);
 	void skipElement(SContext& _ctx, const SPLYElement &Element);
 	void skipProperty(SContext& _ctx, const SPLYProperty &Property);
@@ -167,6 +191,9 @@ private:
 	void moveForward(SContext& _ctx, uint32_t bytes);
 
     bool genVertBuffersForMBuffer(asset::ICPUMeshBuffer* _mbuf, const core::vector<core::vectorSIMDf> _attribs[4]) const;
+    static size_t calcVertexLayout(const bool _present[4], size_t _outOffsets[4]);
+    //! Creates the interleaved vertex buffer for the present attributes and binds it to `_mbuf`, returns pointer to its data
+    uint8_t* createVertexBuffer(asset::ICPUMeshBuffer* _mbuf, const bool _present[4], size_t _vertexCount) const;
 
     scene::ISceneManager* SceneManager;
 };
@@ -0,0 +1,122 @@
+#include "irr/asset/CSPIR_VCache.h"
+
+#include <cstdio>
+#include <random>
+
+#include "IReadFile.h"
+#include "IWriteFile.h"
+
+using namespace irr;
+using namespace asset;
+
+
+CSPIR_VCache::CSPIR_VCache(io::IFileSystem* _fs, const io::path& _directory) :
+    m_fileSystem(_fs), m_directory(_fs->getAbsolutePath(_directory)), m_tmpFileCounter(0u),
+    m_loaded([](ICPUBuffer* _blob) { _blob->grab(); }, [](ICPUBuffer* _blob) { _blob->drop(); })
+{
+    m_fileSystem->grab();
+    if (m_directory.size() && m_directory.lastChar() != '/')
+        m_directory += "/";
+
+    std::random_device rd;
+    m_tmpFilePrefix = (uint64_t(rd())<<32ull)|rd();
+}
+
+CSPIR_VCache::~CSPIR_VCache()
+{
+    m_fileSystem->drop();
+}
+
+core::smart_refctd_ptr<ICPUBuffer> CSPIR_VCache::find(const SKey& _key) const
+{
+    ICPUBuffer* cached = nullptr;
+    size_t count = 1u;
+    // cached buffers only go away together with the cache, so it is fine to grab after the lookup
+    if (m_loaded.findAndStoreRange(_key, count, &cached) && count)
+        return core::smart_refctd_ptr<ICPUBuffer>(cached);
+
+    auto blob = loadBlob(_key);
+    if (!blob)
+        return nullptr;
+    return cacheInMemory(_key, std::move(blob));
+}
+
+bool CSPIR_VCache::insert(const SKey& _key, const void* _spirv, size_t _size) const
+{
+    auto blob = core::make_smart_refctd_ptr<ICPUBuffer>(_size);
+    if (blob->getSize() != _size)
+        return false;
+    memcpy(blob->getPointer(), _spirv, _size);
+    cacheInMemory(_key, std::move(blob));
+
+    SBlobHeader header;
+    header.magic = SBlobHeader::Magic;
+    header.version = SBlobHeader::Version;
+    header.key = _key;
+    header.byteSize = _size;
+
+    const io::path finalPath = getBlobPath(_key);
+    char tmpSuffix[64];
+    sprintf(tmpSuffix, ".%016llx_%u.tmp", static_cast<unsigned long long>(m_tmpFilePrefix), m_tmpFileCounter++);
+    const io::path tmpPath = finalPath + tmpSuffix;
+
+    io::IWriteFile* file = m_fileSystem->createAndWriteFile(tmpPath);
+    if (!file)
+        return false;
+    const bool written = file->write(&header, sizeof(header)) == int32_t(sizeof(header)) && file->write(_spirv, static_cast<uint32_t>(_size)) == int32_t(_size);
+    file->drop();
+
+    // on Windows rename fails if someone else already put the same blob in place, which is just as good
+    if (!written || std::rename(tmpPath.c_str(), finalPath.c_str()) != 0)
+    {
+        std::remove(tmpPath.c_str());
+        return written && m_fileSystem->existFile(finalPath);
+    }
+    return true;
+}
+
+io::path CSPIR_VCache::getBlobPath(const SKey& _key) const
+{
+    char name[sizeof(_key.hash)*2u+sizeof(".spv")];
+    sprintf(name, "%016llx%016llx%016llx%016llx.spv",
+        static_cast<unsigned long long>(_key.hash[0]), static_cast<unsigned long long>(_key.hash[1]),
+        static_cast<unsigned long long>(_key.hash[2]), static_cast<unsigned long long>(_key.hash[3]));
+    return m_directory + name;
+}
+
+core::smart_refctd_ptr<ICPUBuffer> CSPIR_VCache::loadBlob(const SKey& _key) const
+{
+    const io::path blobPath = getBlobPath(_key);
+    if (!m_fileSystem->existFile(blobPath))
+        return nullptr;
+    io::IReadFile* file = m_fileSystem->createAndOpenFile(blobPath);
+    if (!file)
+        return nullptr;
+
+    core::smart_refctd_ptr<ICPUBuffer> blob;
+    SBlobHeader header;
+    if (file->read(&header, sizeof(header)) == int32_t(sizeof(header)) &&
+        header.magic == SBlobHeader::Magic && header.version == SBlobHeader::Version && header.key == _key &&
+        header.byteSize && header.byteSize%sizeof(uint32_t) == 0ull && file->getSize() == sizeof(header)+header.byteSize)
+    {
+        blob = core::make_smart_refctd_ptr<ICPUBuffer>(header.byteSize);
+        if (blob->getSize() != header.byteSize || file->read(blob->getPointer(), static_cast<uint32_t>(header.byteSize)) != int32_t(header.byteSize))
+            blob = nullptr;
+    }
+    file->drop();
+
+    return blob;
+}
+
+core::smart_refctd_ptr<ICPUBuffer> CSPIR_VCache::cacheInMemory(const SKey& _key, core::smart_refctd_ptr<ICPUBuffer>&& _blob) const
+{
+    if (m_loaded.insert(_key, _blob.get()))
+        return std::move(_blob);
+
+    // someone else loaded or compiled the same blob in the meantime
+    ICPUBuffer* cached = nullptr;
+    size_t count = 1u;
+    if (m_loaded.findAndStoreRange(_key, count, &cached) && count)
+        return core::smart_refctd_ptr<ICPUBuffer>(cached);
+    return std::move(_blob);
+}
@@ -10,6 +10,7 @@
 #include "irr/asset/SCPUMesh.h"
 #include "irr/asset/ICPUMeshBuffer.h"
 #include "irr/core/math/plane3dSIMD.h"
+#include "irr/core/flat_hash_map.h"
 
 #include "IReadFile.h"
 #include "coreutil.h"
@@ -23,6 +24,15 @@ namespace irr
 namespace asset
 {
 
+namespace
+{
+    //! Binary STL layout: 80 byte header, triangle count, then 50 byte records of normal, 3 vertices and an attribute word
+    constexpr size_t STL_HEADER_SZ = 84u;
+    constexpr size_t STL_TRI_SZ = 50u;
+    //! Triangle records fetched with a single IReadFile::read
+    constexpr size_t STL_TRIS_PER_BLOCK = 1024u;
+}
+
 asset::IAsset* CSTLMeshFileLoader::loadAsset(io::IReadFile* _file, const asset::IAssetLoader::SAssetLoadParams& _params, asset::IAssetLoader::IAssetLoaderOverride* _override, uint32_t _hierarchyLevel)
 {
 	const long filesize = _file->getSize();
@@ -42,117 +52,81 @@ asset::IAsset* CSTLMeshFileLoader::loadAsset(io::IReadFile* _file, const asset::
 	meshbuffer->drop();
     }
 
-	bool binary = false;
 	core::stringc token;
 	if (getNextToken(_file, token) != "solid")
-		binary = hasColor = true;
-
-    core::vector<core::vectorSIMDf> positions, normals;
-    core::vector<uint32_t> colors;
-	if (binary)
 	{
-        if (_file->getSize() < 80)
+        if (!loadBinary(_file, mesh->getMeshBuffer(0), _params.loaderFlags&asset::IAssetLoader::ELPF_DEDUPLICATE_VERTICES))
         {
             mesh->drop();
             return nullptr;
         }
-		_file->seek(80); // skip header
-        uint32_t vtxCnt = 0u;
-		_file->read(&vtxCnt, 4);
-        positions.reserve(3*vtxCnt);
-        normals.reserve(vtxCnt);
-        colors.reserve(vtxCnt);
+        mesh->recalculateBoundingBox(true);
+        return mesh;
 	}
-	else
-		goNextLine(_file); // skip header
+	goNextLine(_file); // skip header
 
+    core::vector<core::vectorSIMDf> positions, normals;
+    core::vector<uint32_t> colors;
 
-	uint16_t attrib=0u;
 	token.reserve(32);
 	while (_file->getPos() < filesize)
 	{
-		if (!binary)
+		if (getNextToken(_file, token) != "facet")
 		{
-			if (getNextToken(_file, token) != "facet")
-			{
-				if (token=="endsolid")
-					break;
-				mesh->drop();
-				return nullptr;
-			}
-			if (getNextToken(_file, token) != "normal")
-			{
-				mesh->drop();
-				return nullptr;
-			}
+			if (token=="endsolid")
+				break;
+			mesh->drop();
+			return nullptr;
+		}
+		if (getNextToken(_file, token) != "normal")
+		{
+			mesh->drop();
+			return nullptr;
 		}
 
         {
         core::vectorSIMDf n;
-		getNextVector(_file, n, binary);
+		getNextVector(_file, n);
         normals.push_back(n);
         }
 
-		if (!binary)
+		if (getNextToken(_file, token) != "outer")
 		{
-			if (getNextToken(_file, token) != "outer")
-			{
-				mesh->drop();
-				return nullptr;
-			}
-			if (getNextToken(_file, token) != "loop")
-			{
-				mesh->drop();
-				return nullptr;
-			}
+			mesh->drop();
+			return nullptr;
+		}
+		if (getNextToken(_file, token) != "loop")
+		{
+			mesh->drop();
+			return nullptr;
 		}
 
         {
         core::vectorSIMDf p[3];
 		for (uint32_t i = 0u; i < 3u; ++i)
 		{
-			if (!binary)
+			if (getNextToken(_file, token) != "vertex")
 			{
-				if (getNextToken(_file, token) != "vertex")
-				{
-					mesh->drop();
-					return nullptr;
-				}
+				mesh->drop();
+				return nullptr;
 			}
-			getNextVector(_file, p[i], binary);
+			getNextVector(_file, p[i]);
 		}
         for (uint32_t i = 0u; i < 3u; ++i) // seems like in STL format vertices are ordered in clockwise manner...
             positions.push_back(p[2u-i]);
         }
 
-		if (!binary)
+		if (getNextToken(_file, token) != "endloop")
 		{
-			if (getNextToken(_file, token) != "endloop")
-			{
-				mesh->drop();
-				return nullptr;
-			}
-			if (getNextToken(_file, token) != "endfacet")
-			{
-				mesh->drop();
-				return nullptr;
-			}
+			mesh->drop();
+			return nullptr;
 		}
-		else
+		if (getNextToken(_file, token) != "endfacet")
 		{
-			_file->read(&attrib, 2);
+			mesh->drop();
+			return nullptr;
 		}
 
-        if (hasColor && (attrib & 0x8000)) // assuming VisCam/SolidView non-standard trick to store color in 2 bytes of extra attribute
-        {
-            colors.push_back(video::A1R5G5B5toA8R8G8B8(attrib));
-        }
-        else
-        {
-            hasColor = false;
-            colors.clear();
-        }
-
 		if ((normals.back() == core::vectorSIMDf()).all())
         {
 			normals.back().set(
@@ -207,7 +181,7 @@ bool CSTLMeshFileLoader::isALoadableFileFormat(io::IReadFile* _file) const
         return true;
     else
     {
-        if (_file->getSize() < 84u)
+        if (_file->getSize() < STL_HEADER_SZ)
         {
             _file->seek(prevPos);
             return false;
@@ -216,32 +190,191 @@ bool CSTLMeshFileLoader::isALoadableFileFormat(io::IReadFile* _file) const
         uint32_t triCnt;
         _file->read(&triCnt, 4u);
         _file->seek(prevPos);
-        const size_t STL_TRI_SZ = 50u;
-        return _file->getSize() == (STL_TRI_SZ*triCnt + 84u);
+        return _file->getSize() == (STL_TRI_SZ*triCnt + STL_HEADER_SZ);
+    }
+}
+
+bool CSTLMeshFileLoader::loadBinary(io::IReadFile* _file, asset::ICPUMeshBuffer* _meshbuffer, bool _deduplicate) const
+{
+    if (_file->getSize() < STL_HEADER_SZ)
+        return false;
+    // trust the file size over the triangle count in the header, isALoadableFileFormat already checked they agree
+    const size_t triCnt = (_file->getSize()-STL_HEADER_SZ)/STL_TRI_SZ;
+    if (!triCnt)
+        return false;
+    _file->seek(STL_HEADER_SZ);
+
+    // X of every vector gets mirrored, the records are 4 byte aligned at best so all loads are unaligned
+    const __m128 flipX0 = _mm_castsi128_ps(_mm_setr_epi32(0x80000000, 0, 0, 0x80000000)); // nx ny nz p0x
+    const __m128 flipX1 = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0x80000000, 0)); // p0y p0z p1x p1y
+    const __m128 flipX2 = _mm_castsi128_ps(_mm_setr_epi32(0, 0x80000000, 0, 0)); // p1z p2x p2y p2z
+    const __m128 zero = _mm_setzero_ps();
+
+    core::vector<uint8_t> block(STL_TRIS_PER_BLOCK*STL_TRI_SZ);
+    bool hasColor = true;
+    size_t vtxSize = 0u;
+
+    // without deduplication vertices go straight into the final buffer
+    asset::ICPUBuffer* vertexBuf = nullptr;
+    uint8_t* out = nullptr;
+    core::vector<SBinaryVertex> uniqueVertices;
+    core::vector<uint32_t> indices;
+    core::flat_hash_map<SBinaryVertex, uint32_t, SBinaryVertexHash> vertexMap;
+    if (_deduplicate)
+    {
+        indices.reserve(3u*triCnt);
+        uniqueVertices.reserve(triCnt);
+        vertexMap.reserve(triCnt);
+    }
+
+    for (size_t tri = 0u; tri < triCnt; )
+    {
+        const size_t blockTris = core::min_(STL_TRIS_PER_BLOCK, triCnt-tri);
+        if (_file->read(block.data(), blockTris*STL_TRI_SZ) != int32_t(blockTris*STL_TRI_SZ))
+        {
+            if (vertexBuf)
+                vertexBuf->drop();
+            return false;
+        }
+
+        if (tri == 0u)
+        {
+            // whether the mesh has color can only be known after reading every record, guess from the first one and fix up later if wrong
+            uint16_t attrib;
+            memcpy(&attrib, block.data()+48, 2);
+            hasColor = attrib & 0x8000;
+            vtxSize = hasColor ? sizeof(SBinaryVertex) : offsetof(SBinaryVertex, color);
+            if (!_deduplicate)
+            {
+                vertexBuf = new asset::ICPUBuffer(3u*triCnt*vtxSize);
+                out = reinterpret_cast<uint8_t*>(vertexBuf->getPointer());
+            }
+        }
+
+        const uint8_t* record = block.data();
+        for (const uint8_t* const blockEnd = record+blockTris*STL_TRI_SZ; record != blockEnd; record += STL_TRI_SZ)
+        {
+            const __m128 r0 = _mm_xor_ps(_mm_loadu_ps(reinterpret_cast<const float*>(record)), flipX0);
+            const __m128 r1 = _mm_xor_ps(_mm_loadu_ps(reinterpret_cast<const float*>(record+16)), flipX1);
+            const __m128 r2 = _mm_xor_ps(_mm_loadu_ps(reinterpret_cast<const float*>(record+32)), flipX2);
+
+            // seems like in STL format vertices are ordered in clockwise manner, so they get reversed
+            __m128 p[3];
+            p[2] = _mm_castsi128_ps(_mm_alignr_epi8(_mm_castps_si128(r1), _mm_castps_si128(r0), 12));
+            p[1] = _mm_castsi128_ps(_mm_alignr_epi8(_mm_castps_si128(r2), _mm_castps_si128(r1), 8));
+            p[0] = _mm_castsi128_ps(_mm_srli_si128(_mm_castps_si128(r2), 4));
+
+            uint32_t normal;
+            {
+                __m128 n = _mm_blend_ps(r0, zero, 0x8);
+                if ((_mm_movemask_ps(_mm_cmpeq_ps(n, zero))&0x7) == 0x7)
+                {
+                    for (uint32_t i = 0u; i < 3u; ++i)
+                        p[i] = _mm_blend_ps(p[i], zero, 0x8);
+                    n = core::plane3dSIMDf(p[0], p[1], p[2]).getNormal().getAsRegister();
+                }
+                normal = asset::quantizeNormal2_10_10_10(n);
+            }
+
+            uint16_t attrib;
+            memcpy(&attrib, record+48, 2);
+            if (hasColor && !(attrib & 0x8000))
+                hasColor = false;
+            // assuming VisCam/SolidView non-standard trick to store color in 2 bytes of extra attribute
+            const uint32_t color = hasColor ? video::A1R5G5B5toA8R8G8B8(attrib) : 0u;
+
+            SBinaryVertex v[3];
+            for (uint32_t i = 0u; i < 3u; ++i)
+            {
+                // the 4th lane spills into the normal, which is written right after
+                _mm_storeu_ps(v[i].pos, p[i]);
+                v[i].normal = normal;
+                v[i].color = color;
+            }
+
+            if (_deduplicate)
+            {
+                for (uint32_t i = 0u; i < 3u; ++i)
+                {
+                    auto inserted = vertexMap.insert(v[i], uint32_t(uniqueVertices.size()));
+                    if (inserted.second)
+                        uniqueVertices.push_back(v[i]);
+                    indices.push_back(*inserted.first);
+                }
+            }
+            else
+            {
+                for (uint32_t i = 0u; i < 3u; ++i, out += vtxSize)
+                    memcpy(out, v+i, vtxSize);
+            }
+        }
+        tri += blockTris;
+    }
+
+    // some triangle had no color after all, repack without the color attribute
+    const size_t outVtxSize = hasColor ? sizeof(SBinaryVertex) : offsetof(SBinaryVertex, color);
+    if (_deduplicate)
+    {
+        vertexBuf = new asset::ICPUBuffer(uniqueVertices.size()*outVtxSize);
+        out = reinterpret_cast<uint8_t*>(vertexBuf->getPointer());
+        for (const auto& v : uniqueVertices)
+        {
+            memcpy(out, &v, outVtxSize);
+            out += outVtxSize;
+        }
+    }
+    else if (outVtxSize != vtxSize)
+    {
+        asset::ICPUBuffer* repacked = new asset::ICPUBuffer(3u*triCnt*outVtxSize);
+        const uint8_t* src = reinterpret_cast<const uint8_t*>(vertexBuf->getPointer());
+        uint8_t* dst = reinterpret_cast<uint8_t*>(repacked->getPointer());
+        for (size_t i = 0u; i < 3u*triCnt; ++i)
+            memcpy(dst+i*outVtxSize, src+i*vtxSize, outVtxSize);
+        vertexBuf->drop();
+        vertexBuf = repacked;
     }
+
+    asset::ICPUMeshDataFormatDesc* desc = static_cast<asset::ICPUMeshDataFormatDesc*>(_meshbuffer->getMeshDataAndFormat());
+	desc->setVertexAttrBuffer(vertexBuf, asset::EVAI_ATTR0, asset::EF_R32G32B32_SFLOAT, outVtxSize, offsetof(SBinaryVertex, pos));
+	desc->setVertexAttrBuffer(vertexBuf, asset::EVAI_ATTR3, asset::EF_A2B10G10R10_SNORM_PACK32, outVtxSize, offsetof(SBinaryVertex, normal));
+    if (hasColor)
+	    desc->setVertexAttrBuffer(vertexBuf, asset::EVAI_ATTR1, asset::EF_B8G8R8A8_UNORM, outVtxSize, offsetof(SBinaryVertex, color));
+	vertexBuf->drop();
+
+    if (_deduplicate)
+    {
+        // most meshes end up small enough for 16bit indices
+        const bool use16bit = uniqueVertices.size() <= 0x10000u;
+        asset::ICPUBuffer* indexBuf = new asset::ICPUBuffer(indices.size()*(use16bit ? 2u:4u));
+        if (use16bit)
+        {
+            uint16_t* dst = reinterpret_cast<uint16_t*>(indexBuf->getPointer());
+            for (size_t i = 0u; i < indices.size(); ++i)
+                dst[i] = indices[i];
+        }
+        else
+            memcpy(indexBuf->getPointer(), indices.data(), indexBuf->getSize());
+        desc->setIndexBuffer(indexBuf);
+        indexBuf->drop();
+        _meshbuffer->setIndexType(use16bit ? asset::EIT_16BIT:asset::EIT_32BIT);
+    }
+    _meshbuffer->setIndexCount(3u*triCnt);
+
+    return true;
 }
 
 //! Read 3d vector of floats
-void CSTLMeshFileLoader::getNextVector(io::IReadFile* file, core::vectorSIMDf& vec, bool binary) const
+void CSTLMeshFileLoader::getNextVector(io::IReadFile* file, core::vectorSIMDf& vec) const
 {
-	if (binary)
-	{
-		file->read(&vec.X, 4);
-		file->read(&vec.Y, 4);
-		file->read(&vec.Z, 4);
-	}
-	else
-	{
-		goNextWord(file);
-		core::stringc tmp;
-
-		getNextToken(file, tmp);
-		sscanf(tmp.c_str(),"%f",&vec.X);
-		getNextToken(file, tmp);
-		sscanf(tmp.c_str(),"%f",&vec.Y);
-		getNextToken(file, tmp);
-		sscanf(tmp.c_str(),"%f",&vec.Z);
-	}
+	goNextWord(file);
+	core::stringc tmp;
+
+	getNextToken(file, tmp);
+	sscanf(tmp.c_str(),"%f",&vec.X);
+	getNextToken(file, tmp);
+	sscanf(tmp.c_str(),"%f",&vec.Y);
+	getNextToken(file, tmp);
+	sscanf(tmp.c_str(),"%f",&vec.Z);
 	vec.X=-vec.X;
 }
 
@@ -6,6 +6,7 @@
 #define __C_STL_MESH_FILE_LOADER_H_INCLUDED__
 
 #include "irr/asset/IAssetLoader.h"
+#include "irr/asset/ICPUMeshBuffer.h"
 
 #include "vectorSIMD.h"
 
@@ -31,6 +32,31 @@ public:
     virtual uint64_t getSupportedAssetTypesBitfield() const override { return asset::IAsset::ET_MESH; }
 
 private:
+    //! Vertex as laid out in the output buffer, the color is only copied over when the mesh has color
+    struct SBinaryVertex
+    {
+        inline bool operator==(const SBinaryVertex& other) const { return memcmp(this,&other,sizeof(SBinaryVertex))==0; }
+
+        float pos[3];
+        uint32_t normal;
+        uint32_t color;
+    };
+    struct SBinaryVertexHash
+    {
+        inline size_t operator()(const SBinaryVertex& k) const
+        {
+            // bitwise hash is fine since operator== compares exactly
+            uint32_t words[5];
+            memcpy(words, &k, sizeof(words));
+            uint64_t h = 0xcbf29ce484222325ull;
+            for (uint32_t w : words)
+                h = (h^w)*0x100000001b3ull;
+            return h;
+        }
+    };
+
+    //! Decodes the binary triangle records block by block straight into the vertex buffer (and index buffer when deduplicating), returns false if the file is truncated
+    bool loadBinary(io::IReadFile* _file, asset::ICPUMeshBuffer* _meshbuffer, bool _deduplicate) const;
 
 	// skips to the first non-space character available
 	void goNextWord(io::IReadFile* file) const;
@@ -40,7 +66,7 @@ private:
 	void goNextLine(io::IReadFile* file) const;
 
 	//! Read 3d vector of floats
-	void getNextVector(io::IReadFile* file, core::vectorSIMDf& vec, bool binary) const;
+	void getNextVector(io::IReadFile* file, core::vectorSIMDf& vec) const;
 };
 
 } // end namespace scene
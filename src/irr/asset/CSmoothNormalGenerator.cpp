@@ -1,4 +1,5 @@
 #include "CSmoothNormalGenerator.h"
+#include "irr/core/parallel_for.h"
 
 #include <iostream>
 #include <algorithm>
@@ -8,16 +9,6 @@ namespace irr
 {
 	namespace asset
 	{
-		static inline bool operator<(uint32_t lhs, const IMeshManipulator::SSNGVertexData& rhs)
-		{
-			return lhs < rhs.hash;
-		}
-
-		static inline bool operator<(const IMeshManipulator::SSNGVertexData& lhs, uint32_t rhs)
-		{
-			return lhs.hash < rhs;
-		}
-
 		static inline bool compareVertexPosition(const core::vectorSIMDf& a, const core::vectorSIMDf& b, float epsilon)
 		{
 			const core::vectorSIMDf difference = core::abs(b - a);
@@ -44,10 +35,13 @@ namespace irr
 				acosf((b - c + a) / (2.f * bsqrt * asqrt)));
 		}
 
-		asset::ICPUMeshBuffer * irr::asset::CSmoothNormalGenerator::calculateNormals(asset::ICPUMeshBuffer * buffer, float epsilon, asset::E_VERTEX_ATTRIBUTE_ID normalAttrID, IMeshManipulator::VxCmpFunction vxcmp)
+		asset::ICPUMeshBuffer * irr::asset::CSmoothNormalGenerator::calculateNormals(asset::ICPUMeshBuffer * buffer, float epsilon, asset::E_VERTEX_ATTRIBUTE_ID normalAttrID, IMeshManipulator::VxCmpFunction vxcmp, uint32_t threadCount)
 		{
-			VertexHashMap vertexArray = setupData(buffer, epsilon);
-			processConnectedVertices(buffer, vertexArray, epsilon, normalAttrID, vxcmp);
+			if (threadCount == 0u)
+				threadCount = core::getDefaultThreadCount();
+
+			VertexHashMap vertexArray = setupData(buffer, epsilon, threadCount);
+			processConnectedVertices(buffer, vertexArray, epsilon, normalAttrID, vxcmp, threadCount);
 
 			return buffer;
 		}
@@ -58,8 +52,8 @@ namespace irr
 		{
 			assert((core::isPoT(hashTableMaxSize)));
 
-			vertices.reserve(_vertexCount);
-			buckets.reserve(_hashTableMaxSize + 1);
+			vertices.resize(_vertexCount);
+			bucketOffsets.resize(_hashTableMaxSize + 1);
 		}
 
 		uint32_t CSmoothNormalGenerator::VertexHashMap::hash(const IMeshManipulator::SSNGVertexData & vertex) const
@@ -86,10 +80,10 @@ namespace irr
 				(position.z * primeNumber3))& (hashTableMaxSize - 1);
 		}
 
-		void CSmoothNormalGenerator::VertexHashMap::add(IMeshManipulator::SSNGVertexData && vertex)
+		void CSmoothNormalGenerator::VertexHashMap::set(size_t ix, IMeshManipulator::SSNGVertexData && vertex)
 		{
 			vertex.hash = hash(vertex);
-			vertices.push_back(vertex);
+			vertices[ix] = vertex;
 		}
 
 		CSmoothNormalGenerator::VertexHashMap::BucketBounds CSmoothNormalGenerator::VertexHashMap::getBucketBoundsByHash(uint32_t hash)
@@ -97,80 +91,98 @@ namespace irr
 			if (hash == invalidHash)
 				return { vertices.end(), vertices.end() };
 
-			core::vector<IMeshManipulator::SSNGVertexData>::iterator begin = std::lower_bound(vertices.begin(), vertices.end(), hash);
-			core::vector<IMeshManipulator::SSNGVertexData>::iterator end = std::upper_bound(vertices.begin(), vertices.end(), hash);
-
-			//bucket missing
-			if (begin == vertices.end())
-				return { vertices.end(), vertices.end() };
-
-			//bucket missing
-			if (begin->hash != hash)
-				return { vertices.end(), vertices.end() };
-
-			return { begin, end };
+			//missing buckets are empty
+			return { vertices.begin() + bucketOffsets[hash], vertices.begin() + bucketOffsets[hash + 1] };
 		}
 
-		void CSmoothNormalGenerator::VertexHashMap::validate()
+		void CSmoothNormalGenerator::VertexHashMap::validate(uint32_t threadCount)
 		{
-			std::sort(vertices.begin(), vertices.end(), [](IMeshManipulator::SSNGVertexData & a, IMeshManipulator::SSNGVertexData & b) { return a.hash < b.hash; });
-
-			uint16_t prevHash = vertices[0].hash;
-			core::vector<IMeshManipulator::SSNGVertexData>::iterator prevBegin = vertices.begin();
-			buckets.push_back(prevBegin);
-
-			while (true)
+			//hashes are below hashTableMaxSize (at most 2^14), so a single counting pass is all the radix sort needs
+			//chunks of vertices are histogrammed and scattered independently, every chunk writes to its own range of every bucket so the sort stays stable
+			static constexpr uint32_t minVerticesPerChunk = 0x4000u;
+			const uint32_t vertexCount = vertices.size();
+			const uint32_t chunkCount = core::max_(core::min_(threadCount, vertexCount / minVerticesPerChunk), 1u);
+			auto chunkBegin = [&](uint32_t chunk) { return static_cast<uint32_t>(uint64_t(vertexCount) * chunk / chunkCount); };
+
+			core::vector<uint32_t> chunkOffsets(size_t(chunkCount) * hashTableMaxSize, 0u);
+			core::parallel_for<uint32_t>(0u, chunkCount, [&](uint32_t begin, uint32_t end)
 			{
-				core::vector<IMeshManipulator::SSNGVertexData>::iterator next = std::upper_bound(prevBegin, vertices.end(), prevHash);
-				buckets.push_back(next);
-
-				if (next == vertices.end())
-					break;
+				for (uint32_t chunk = begin; chunk < end; chunk++)
+				{
+					uint32_t* counts = chunkOffsets.data() + size_t(chunk) * hashTableMaxSize;
+					for (uint32_t i = chunkBegin(chunk); i < chunkBegin(chunk + 1); i++)
+						counts[vertices[i].hash]++;
+				}
+			}, chunkCount);
 
-				prevBegin = next;
-				prevHash = next->hash;
+			uint32_t offset = 0u;
+			for (uint32_t hash = 0u; hash < hashTableMaxSize; hash++)
+			{
+				bucketOffsets[hash] = offset;
+				for (uint32_t chunk = 0u; chunk < chunkCount; chunk++)
+				{
+					uint32_t& count = chunkOffsets[size_t(chunk) * hashTableMaxSize + hash];
+					const uint32_t chunkBucketBegin = offset;
+					offset += count;
+					count = chunkBucketBegin;
+				}
 			}
+			bucketOffsets[hashTableMaxSize] = offset;
+
+			core::vector<IMeshManipulator::SSNGVertexData> sorted(vertexCount);
+			core::parallel_for<uint32_t>(0u, chunkCount, [&](uint32_t begin, uint32_t end)
+			{
+				for (uint32_t chunk = begin; chunk < end; chunk++)
+				{
+					uint32_t* offsets = chunkOffsets.data() + size_t(chunk) * hashTableMaxSize;
+					for (uint32_t i = chunkBegin(chunk); i < chunkBegin(chunk + 1); i++)
+						sorted[offsets[vertices[i].hash]++] = vertices[i];
+				}
+			}, chunkCount);
+			vertices.swap(sorted);
 		}
 
-		CSmoothNormalGenerator::VertexHashMap CSmoothNormalGenerator::setupData(asset::ICPUMeshBuffer * buffer, float epsilon)
+		CSmoothNormalGenerator::VertexHashMap CSmoothNormalGenerator::setupData(asset::ICPUMeshBuffer * buffer, float epsilon, uint32_t threadCount)
 		{
 			const size_t idxCount = buffer->getIndexCount();
 			_IRR_DEBUG_BREAK_IF((idxCount % 3));
 
-			VertexHashMap vertices(idxCount, std::min(16u * 1024u, core::roundUpToPoT<unsigned int>(idxCount * 1.0f / 32.0f)), epsilon == 0.0f ? 0.00001f : epsilon * 1.00001f);
-
-			core::vector3df_SIMD faceNormal;
+			VertexHashMap vertices(idxCount, std::min(16u * 1024u, core::roundUpToPoT<unsigned int>(core::max_<unsigned int>(idxCount / 32u, 1u))), epsilon == 0.0f ? 0.00001f : epsilon * 1.00001f);
 
-			for (uint32_t i = 0; i < idxCount; i += 3)
+			core::parallel_for<uint32_t>(0u, idxCount / 3u, [&](uint32_t begin, uint32_t end)
 			{
-				//calculate face normal of parent triangle
-				core::vectorSIMDf v1 = buffer->getPosition(i);
-				core::vectorSIMDf v2 = buffer->getPosition(i + 1);
-				core::vectorSIMDf v3 = buffer->getPosition(i + 2);
+				core::vector3df_SIMD faceNormal;
 
-				faceNormal = core::cross(v2 - v1, v3 - v1);
-				faceNormal = core::normalize(faceNormal);
+				for (uint32_t i = begin * 3u; i < end * 3u; i += 3)
+				{
+					//calculate face normal of parent triangle
+					core::vectorSIMDf v1 = buffer->getPosition(i);
+					core::vectorSIMDf v2 = buffer->getPosition(i + 1);
+					core::vectorSIMDf v3 = buffer->getPosition(i + 2);
 
-				//set data for vertices
-				core::vector3df_SIMD angleWages = getAngleWeight(v1, v2, v3);
+					faceNormal = core::cross(v2 - v1, v3 - v1);
+					faceNormal = core::normalize(faceNormal);
 
-				vertices.add({ i,		0,	angleWages.x,	v1,		faceNormal });
-				vertices.add({ i + 1,	0,	angleWages.y,	v2,		faceNormal });
-				vertices.add({ i + 2,	0,	angleWages.z,	v3,		faceNormal });
-			}
+					//set data for vertices
+					core::vector3df_SIMD angleWages = getAngleWeight(v1, v2, v3);
+
+					vertices.set(i,		{ i,		0,	angleWages.x,	v1,		faceNormal });
+					vertices.set(i + 1,	{ i + 1,	0,	angleWages.y,	v2,		faceNormal });
+					vertices.set(i + 2,	{ i + 2,	0,	angleWages.z,	v3,		faceNormal });
+				}
+			}, threadCount, 0x1000u);
 
-			vertices.validate();
+			vertices.validate(threadCount);
 
 			return vertices;
 		}
 
-		void CSmoothNormalGenerator::processConnectedVertices(asset::ICPUMeshBuffer * buffer, VertexHashMap & vertexHashMap, float epsilon, asset::E_VERTEX_ATTRIBUTE_ID normalAttrID, IMeshManipulator::VxCmpFunction vxcmp)
+		void CSmoothNormalGenerator::processConnectedVertices(asset::ICPUMeshBuffer * buffer, VertexHashMap & vertexHashMap, float epsilon, asset::E_VERTEX_ATTRIBUTE_ID normalAttrID, IMeshManipulator::VxCmpFunction vxcmp, uint32_t threadCount)
 		{
-			for (uint32_t cell = 0; cell < vertexHashMap.getBucketCount() - 1; cell++)
+			//every vertex only reads the others and writes its own normal, so the result does not depend on how the vertices are split between threads
+			core::parallel_for<size_t>(0u, vertexHashMap.getVertexCount(), [&](size_t begin, size_t end)
 			{
-				VertexHashMap::BucketBounds processedBucket = vertexHashMap.getBucketBoundsById(cell);
-
-				for (core::vector<IMeshManipulator::SSNGVertexData>::iterator processedVertex = processedBucket.begin; processedVertex != processedBucket.end; processedVertex++)
+				for (core::vector<IMeshManipulator::SSNGVertexData>::iterator processedVertex = vertexHashMap.getVertex(begin); processedVertex != vertexHashMap.getVertex(end); processedVertex++)
 				{
 					std::array<uint32_t, 8> neighboringCells = vertexHashMap.getNeighboringCellHashes(*processedVertex);
 					core::vector3df_SIMD normal = processedVertex->parentTriangleFaceNormal * processedVertex->wage;
@@ -195,12 +207,10 @@ namespace irr
 					normal = core::normalize(core::vectorSIMDf(normal));
 					buffer->setAttribute(normal, normalAttrID, processedVertex->indexOffset);
 				}
-			}
-
-
+			}, threadCount, size_t(0x1000u));
 		}
 
-		std::array<uint32_t, 8> CSmoothNormalGenerator::VertexHashMap::getNeighboringCellHashes(const IMeshManipulator::SSNGVertexData & vertex)
+		std::array<uint32_t, 8> CSmoothNormalGenerator::VertexHashMap::getNeighboringCellHashes(const IMeshManipulator::SSNGVertexData & vertex) const
 		{
 			std::array<uint32_t, 8> neighbourhood;
 
@@ -15,7 +15,8 @@ namespace asset
 class CSmoothNormalGenerator
 {
 public:
-	static asset::ICPUMeshBuffer* calculateNormals(asset::ICPUMeshBuffer* buffer, float epsilon, asset::E_VERTEX_ATTRIBUTE_ID normalAttrID, IMeshManipulator::VxCmpFunction function);
+	//! @param threadCount Amount of threads to use, 0 means core::getDefaultThreadCount(). The result does not depend on it, but `function` gets called concurrently unless it is 1.
+	static asset::ICPUMeshBuffer* calculateNormals(asset::ICPUMeshBuffer* buffer, float epsilon, asset::E_VERTEX_ATTRIBUTE_ID normalAttrID, IMeshManipulator::VxCmpFunction function, uint32_t threadCount = 0u);
 
 	CSmoothNormalGenerator() = delete;
 	~CSmoothNormalGenerator() = delete;
@@ -33,25 +34,25 @@ private:
 	public:
 		VertexHashMap(size_t _vertexCount, uint32_t _hashTableMaxSize, float _cellSize);
 
-		//inserts vertex into hash table
-		void add(IMeshManipulator::SSNGVertexData&& vertex);
+		//puts vertex into slot `ix` of the hash table, every slot below `_vertexCount` has to be set exactly once (from any thread) before validate()
+		void set(size_t ix, IMeshManipulator::SSNGVertexData&& vertex);
 
-		//sorts hashtable and sets iterators at beginnings of bucktes
-		void validate();
+		//stable sorts hashtable by cell hash and sets offsets at beginnings of buckets
+		void validate(uint32_t threadCount);
 
 		//
-		std::array<uint32_t, 8> getNeighboringCellHashes(const IMeshManipulator::SSNGVertexData& vertex);
+		std::array<uint32_t, 8> getNeighboringCellHashes(const IMeshManipulator::SSNGVertexData& vertex) const;
 
-		inline uint32_t getBucketCount() const { return buckets.size(); }
-		inline BucketBounds getBucketBoundsById(uint32_t index) { return { buckets[index], buckets[index + 1] }; }
+		inline size_t getVertexCount() const { return vertices.size(); }
+		inline core::vector<IMeshManipulator::SSNGVertexData>::iterator getVertex(size_t index) { return vertices.begin() + index; }
 		BucketBounds getBucketBoundsByHash(uint32_t hash);
 
 	private:
 		static constexpr uint32_t invalidHash = 0xFFFFFFFF;
 
 	private:
-		//holds iterators pointing to beginning of each bucket, last iterator points to vertices.end()
-		core::vector<core::vector<IMeshManipulator::SSNGVertexData>::iterator> buckets;
+		//holds offset of the beginning of the bucket of every hash, last offset is vertices.size()
+		core::vector<uint32_t> bucketOffsets;
 		core::vector<IMeshManipulator::SSNGVertexData> vertices;
 		const uint32_t hashTableMaxSize;
 		const float cellSize;
@@ -63,8 +64,8 @@ private:
 	};
 
 private:
-	static VertexHashMap setupData(asset::ICPUMeshBuffer* buffer, float epsilon);
-	static void processConnectedVertices(asset::ICPUMeshBuffer* buffer, VertexHashMap& vertices, float epsilon, asset::E_VERTEX_ATTRIBUTE_ID normalAttrID, IMeshManipulator::VxCmpFunction vxcmp);
+	static VertexHashMap setupData(asset::ICPUMeshBuffer* buffer, float epsilon, uint32_t threadCount);
+	static void processConnectedVertices(asset::ICPUMeshBuffer* buffer, VertexHashMap& vertices, float epsilon, asset::E_VERTEX_ATTRIBUTE_ID normalAttrID, IMeshManipulator::VxCmpFunction vxcmp, uint32_t threadCount);
 
 };
 
@@ -0,0 +1,272 @@
+#include "CVertexWelder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cfloat>
+
+#include "irr/core/parallel_for.h"
+
+namespace irr
+{
+namespace asset
+{
+
+// cells further than this from the origin all alias, which only costs extra comparisons and never a missed weld
+static constexpr double maxCellCoord = double(1ll<<40);
+
+uint64_t CVertexWelder::hashCell(int64_t _x, int64_t _y, int64_t _z)
+{
+	// splitmix64 finalizer over the three coordinates
+	auto mix = [](uint64_t h) -> uint64_t
+	{
+		h ^= h>>30;
+		h *= 0xbf58476d1ce4e5b9ull;
+		h ^= h>>27;
+		h *= 0x94d049bb133111ebull;
+		h ^= h>>31;
+		return h;
+	};
+	uint64_t h = mix(static_cast<uint64_t>(_x));
+	h = mix(h^static_cast<uint64_t>(_y));
+	return mix(h^static_cast<uint64_t>(_z));
+}
+
+bool CVertexWelder::compareVertices(const ICPUMeshBuffer* _meshbuffer, const uint8_t* _va, const uint8_t* _vb, const IMeshManipulator::SErrorMetric* _errMetrics, const IMeshManipulator* _meshManip)
+{
+	auto cmpInteger = [](uint32_t* _a, uint32_t* _b, size_t _n) -> bool {
+		return !memcmp(_a, _b, _n*4);
+	};
+
+	const uint8_t* va = _va, *vb = _vb;
+	auto desc = _meshbuffer->getMeshDataAndFormat();
+	for (size_t i = 0u; i < asset::EVAI_COUNT; ++i)
+	{
+		if (!desc->getMappedBuffer((asset::E_VERTEX_ATTRIBUTE_ID)i))
+			continue;
+
+		const auto atype = desc->getAttribFormat((asset::E_VERTEX_ATTRIBUTE_ID)i);
+		const auto cpa = asset::getFormatChannelCount(atype);
+
+		if (asset::isIntegerFormat(atype) || asset::isScaledFormat(atype))
+		{
+			uint32_t attr[8];
+			asset::ICPUMeshBuffer::getAttribute(attr, va, atype);
+			asset::ICPUMeshBuffer::getAttribute(attr+4, vb, atype);
+			if (!cmpInteger(attr, attr+4, cpa))
+				return false;
+		}
+		else
+		{
+			core::vectorSIMDf attr[2];
+			asset::ICPUMeshBuffer::getAttribute(attr[0], va, atype);
+			asset::ICPUMeshBuffer::getAttribute(attr[1], vb, atype);
+			if (!_meshManip->compareFloatingPointAttribute(attr[0], attr[1], cpa, _errMetrics[i]))
+				return false;
+		}
+
+		const uint32_t sz = asset::getTexelOrBlockSize(atype);
+		va += sz;
+		vb += sz;
+	}
+
+	return true;
+}
+
+CVertexWelder::CCellTable::CCellTable(const core::vector<SCellEntry>& _sortedEntries)
+{
+	uint32_t cellCount = 0u;
+	for (size_t i=0u; i<_sortedEntries.size(); i++)
+	if (i==0u || _sortedEntries[i].cellHash!=_sortedEntries[i-1u].cellHash)
+		cellCount++;
+
+	// keep load factor at or below 0.5
+	const uint64_t slotCount = core::roundUpToPoT<uint64_t>(std::max<uint64_t>(cellCount,1u)*2ull);
+	mask = slotCount-1ull;
+	slots.resize(slotCount,SSlot{0ull,0u,0u});
+
+	for (uint32_t begin=0u; begin<_sortedEntries.size(); )
+	{
+		const uint64_t cellHash = _sortedEntries[begin].cellHash;
+		uint32_t end = begin+1u;
+		while (end<_sortedEntries.size() && _sortedEntries[end].cellHash==cellHash)
+			end++;
+
+		uint64_t slot = cellHash&mask;
+		while (slots[slot].begin!=slots[slot].end)
+			slot = (slot+1ull)&mask;
+		slots[slot] = {cellHash,begin,end};
+
+		begin = end;
+	}
+}
+
+std::pair<uint32_t,uint32_t> CVertexWelder::CCellTable::find(uint64_t _cellHash) const
+{
+	for (uint64_t slot=_cellHash&mask; slots[slot].begin!=slots[slot].end; slot=(slot+1ull)&mask)
+	if (slots[slot].cellHash==_cellHash)
+		return {slots[slot].begin,slots[slot].end};
+
+	return {0u,0u};
+}
+
+uint32_t CVertexWelder::computeRedirects(uint32_t* _outRedirects, const ICPUMeshBuffer* _meshbuffer, const uint8_t* _packedVertices, size_t _vertexSize, size_t _vertexCount,
+										const IMeshManipulator::SErrorMetric* _errMetrics, const IMeshManipulator* _meshManip, uint32_t _threadCount)
+{
+	if (_vertexCount==0u)
+		return 0u;
+
+	auto desc = _meshbuffer->getMeshDataAndFormat();
+	const E_VERTEX_ATTRIBUTE_ID posAttrId = _meshbuffer->getPositionAttributeIx();
+
+	// find where the position lives within a packed vertex
+	size_t posOffset = 0u;
+	for (size_t i=0u; i<posAttrId; i++)
+	if (desc->getMappedBuffer((E_VERTEX_ATTRIBUTE_ID)i))
+		posOffset += getTexelOrBlockSize(desc->getAttribFormat((E_VERTEX_ATTRIBUTE_ID)i));
+
+	const E_FORMAT posFormat = desc->getMappedBuffer(posAttrId) ? desc->getAttribFormat(posAttrId):EF_UNKNOWN;
+	const bool exactPositions = isIntegerFormat(posFormat)||isScaledFormat(posFormat);
+	// positions we cannot decode or which are not compared by distance all go to a single cell
+	const bool useGrid = posFormat!=EF_UNKNOWN && !isIntegerFormat(posFormat) && (exactPositions || _errMetrics[posAttrId].method==IMeshManipulator::EEM_POSITIONS);
+
+	// with zero epsilon (or positions compared as integers) only identical positions weld, so every distinct position gets a cell of its own
+	bool exactCells = exactPositions;
+	// two positions within epsilon of each other are at most half a cell apart, which means both are within the 2x2x2 block of cells around either one of them
+	double cellSize = 1.0;
+	if (useGrid && !exactPositions)
+	{
+		const uint32_t cpa = getFormatChannelCount(posFormat);
+		double maxEpsilon = 0.0;
+		for (uint32_t c=0u; c<std::min(cpa,3u); c++)
+			maxEpsilon = std::max<double>(maxEpsilon,_errMetrics[posAttrId].epsilon.pointer[c]);
+		exactCells = maxEpsilon==0.0;
+		cellSize = std::max(maxEpsilon*2.0*1.0001,double(FLT_MIN));
+	}
+	const double invCellSize = 1.0/cellSize;
+
+	auto getPosition = [&](size_t _vertexIx) -> core::vectorSIMDf
+	{
+		core::vectorSIMDf pos(0.f);
+		ICPUMeshBuffer::getAttribute(pos,_packedVertices+_vertexIx*_vertexSize+posOffset,posFormat);
+		return pos;
+	};
+	auto getExactCellHash = [&](size_t _vertexIx) -> uint64_t
+	{
+		const core::vectorSIMDf pos = getPosition(_vertexIx);
+		uint32_t bits[3];
+		for (uint32_t c=0u; c<3u; c++)
+		{
+			const float coord = pos.pointer[c]+0.f; // turns -0 into +0, they compare equal
+			memcpy(bits+c,&coord,sizeof(float));
+		}
+		return hashCell(bits[0],bits[1],bits[2]);
+	};
+	auto getCellCoords = [&](size_t _vertexIx, double _offset, int64_t* _outCoords) -> void
+	{
+		const core::vectorSIMDf pos = getPosition(_vertexIx);
+		for (uint32_t c=0u; c<3u; c++)
+		{
+			double coord = std::floor(double(pos.pointer[c])*invCellSize-_offset);
+			if (!(coord>-maxCellCoord)) // also catches NaN
+				coord = -maxCellCoord;
+			else if (coord>maxCellCoord)
+				coord = maxCellCoord;
+			_outCoords[c] = static_cast<int64_t>(coord);
+		}
+	};
+
+	core::vector<SCellEntry> entries(_vertexCount);
+	core::parallel_for<size_t>(0u,_vertexCount,[&](size_t _begin, size_t _end)
+	{
+		for (size_t i=_begin; i<_end; i++)
+		{
+			entries[i].vertexIx = static_cast<uint32_t>(i);
+			if (useGrid && exactCells)
+				entries[i].cellHash = getExactCellHash(i);
+			else if (useGrid)
+			{
+				int64_t cell[3];
+				getCellCoords(i,0.0,cell);
+				entries[i].cellHash = hashCell(cell[0],cell[1],cell[2]);
+			}
+			else
+				entries[i].cellHash = 0ull;
+		}
+		std::sort(entries.begin()+_begin,entries.begin()+_end);
+	},_threadCount,0x4000u);
+	// entries are sorted per chunk, merge them (chunk boundaries are irrelevant, sorted runs are found again)
+	{
+		core::vector<size_t> runStarts;
+		runStarts.push_back(0u);
+		for (size_t i=1u; i<_vertexCount; i++)
+		if (entries[i]<entries[i-1u])
+			runStarts.push_back(i);
+		runStarts.push_back(_vertexCount);
+		while (runStarts.size()>2u)
+		{
+			core::vector<size_t> merged;
+			merged.push_back(0u);
+			for (size_t r=2u; r<runStarts.size(); r+=2u)
+			{
+				std::inplace_merge(entries.begin()+runStarts[r-2u],entries.begin()+runStarts[r-1u],entries.begin()+runStarts[r]);
+				merged.push_back(runStarts[r]);
+			}
+			if ((runStarts.size()&1u)==0u)
+				merged.push_back(_vertexCount);
+			runStarts.swap(merged);
+		}
+	}
+	const CCellTable cells(entries);
+
+	core::parallel_for<size_t>(0u,_vertexCount,[&](size_t _begin, size_t _end)
+	{
+		for (size_t i=_begin; i<_end; i++)
+		{
+			const uint8_t* vertex = _packedVertices+i*_vertexSize;
+			uint32_t redirect = static_cast<uint32_t>(i);
+
+			uint64_t neighbourHashes[8];
+			uint32_t neighbourCount = 0u;
+			if (useGrid && exactCells)
+				neighbourHashes[neighbourCount++] = getExactCellHash(i);
+			else if (useGrid)
+			{
+				int64_t base[3];
+				getCellCoords(i,0.5,base);
+				for (uint32_t n=0u; n<8u; n++)
+				{
+					const uint64_t h = hashCell(base[0]+(n&1u),base[1]+((n>>1)&1u),base[2]+(n>>2));
+					if (std::find(neighbourHashes,neighbourHashes+neighbourCount,h)==neighbourHashes+neighbourCount)
+						neighbourHashes[neighbourCount++] = h;
+				}
+			}
+			else
+				neighbourHashes[neighbourCount++] = 0ull;
+
+			for (uint32_t n=0u; n<neighbourCount; n++)
+			{
+				const auto range = cells.find(neighbourHashes[n]);
+				// entries within a cell are sorted by vertex index, so we can stop as soon as we cannot improve on the current redirect
+				for (uint32_t e=range.first; e<range.second && entries[e].vertexIx<redirect; e++)
+				{
+					const uint32_t other = entries[e].vertexIx;
+					if (compareVertices(_meshbuffer,vertex,_packedVertices+size_t(other)*_vertexSize,_errMetrics,_meshManip))
+						redirect = other;
+				}
+			}
+			_outRedirects[i] = redirect;
+		}
+	},_threadCount,0x1000u);
+
+	// redirects always point to lower indices, so a single forward pass collapses the chains
+	uint32_t maxRedirect = 0u;
+	for (size_t i=0u; i<_vertexCount; i++)
+	{
+		_outRedirects[i] = _outRedirects[_outRedirects[i]];
+		maxRedirect = std::max(maxRedirect,_outRedirects[i]);
+	}
+	return maxRedirect;
+}
+
+}
+}
@@ -0,0 +1,76 @@
+#ifndef __C_VERTEX_WELDER_H_INCLUDED__
+#define __C_VERTEX_WELDER_H_INCLUDED__
+
+#include "irr/asset/ICPUMeshBuffer.h"
+#include "irr/asset/IMeshManipulator.h"
+
+namespace irr
+{
+namespace asset
+{
+
+//! Finds groups of vertices equal under a set of error metrics without comparing every vertex against every other vertex.
+/**
+Vertices are bucketed in a uniform grid over their positions whose cell size is derived from the position attribute's SErrorMetric epsilon,
+so that any two vertices close enough to be welded always land in one of the 2x2x2 cells around each other.
+With a zero epsilon every distinct position is a cell of its own instead, and only that cell is searched.
+Full vertex comparisons only happen within that neighbourhood and are spread over multiple threads.
+*/
+class CVertexWelder
+{
+	public:
+		//! Fills `_outRedirects` (of length `_vertexCount`) so that every vertex points to the lowest index of a vertex it is equal to.
+		/**
+		A vertex with no lower-indexed equal vertex points to itself, and redirects are collapsed so that no vertex ever points to a vertex which itself is redirected.
+		The result does not depend on the thread count.
+		@param _packedVertices Vertex data with all mapped attributes of `_meshbuffer` tightly packed in attribute ID order, `_vertexSize` bytes per vertex.
+		@param _threadCount Amount of threads to use, 0 means core::getDefaultThreadCount().
+		@returns The highest redirect written.
+		*/
+		static uint32_t computeRedirects(uint32_t* _outRedirects, const ICPUMeshBuffer* _meshbuffer, const uint8_t* _packedVertices, size_t _vertexSize, size_t _vertexCount,
+										const IMeshManipulator::SErrorMetric* _errMetrics, const IMeshManipulator* _meshManip, uint32_t _threadCount=0u);
+
+		CVertexWelder() = delete;
+		~CVertexWelder() = delete;
+
+	private:
+		struct SCellEntry
+		{
+			uint64_t cellHash;
+			uint32_t vertexIx;
+
+			inline bool operator<(const SCellEntry& other) const
+			{
+				return cellHash<other.cellHash || (cellHash==other.cellHash && vertexIx<other.vertexIx);
+			}
+		};
+
+		//! Open addressing (linear probing) map from a cell hash to the range of entries in that cell
+		class CCellTable
+		{
+			public:
+				CCellTable(const core::vector<SCellEntry>& _sortedEntries);
+
+				//! Returns [begin,end) range into the sorted entries, empty range if cell is not occupied
+				std::pair<uint32_t,uint32_t> find(uint64_t _cellHash) const;
+
+			private:
+				struct SSlot
+				{
+					uint64_t cellHash;
+					uint32_t begin;
+					uint32_t end;
+				};
+
+				core::vector<SSlot> slots;
+				uint64_t mask;
+		};
+
+		static uint64_t hashCell(int64_t _x, int64_t _y, int64_t _z);
+		static bool compareVertices(const ICPUMeshBuffer* _meshbuffer, const uint8_t* _va, const uint8_t* _vb, const IMeshManipulator::SErrorMetric* _errMetrics, const IMeshManipulator* _meshManip);
+};
+
+}
+}
+
+#endif
@@ -6,15 +6,117 @@
 namespace irr { namespace asset
 {
 
+IGLSLCompiler::IGLSLCompiler(core::smart_refctd_ptr<CSPIR_VCache>&& _cache) : m_compiler(new shaderc::Compiler()), m_cache(std::move(_cache)), m_compilePool(nullptr)
+{
+}
+
+IGLSLCompiler::~IGLSLCompiler()
+{
+    // finishes the jobs still queued, they need the compiler
+    if (m_compilePool)
+        delete m_compilePool;
+}
+
+//! Everything the bytecode depends on, glslang's SPIR-V version included because upgrading it changes the output
+static CSPIR_VCache::SKey makeSPIR_VCacheKey(const shaderc::PreprocessedSourceCompilationResult& _preprocessed, shaderc_shader_kind _stage, const char* _entryPoint, bool _debug, const char* _compilationId)
+{
+    unsigned int spvVersion[2];
+    shaderc_get_spv_version(spvVersion+0, spvVersion+1);
+
+    std::string keySource(reinterpret_cast<const char*>(spvVersion), sizeof(spvVersion));
+    keySource.append(reinterpret_cast<const char*>(&_stage), sizeof(_stage));
+    keySource += _debug ? 'd':'r';
+    keySource.append(_entryPoint, strlen(_entryPoint)+1u);
+    // debug info has the file name in it
+    if (_debug && _compilationId)
+        keySource.append(_compilationId, strlen(_compilationId)+1u);
+    keySource.append(_preprocessed.cbegin(), _preprocessed.cend());
+
+    CSPIR_VCache::SKey key;
+    core::XXHash_256(keySource.data(), keySource.size(), key.hash);
+    return key;
+}
+
 ICPUShader* IGLSLCompiler::createShaderFromGLSL(const char* _glslCode, E_SHADER_STAGE _stage, const char* _entryPoint, bool _debug, const char* _compilationId) const
 {
-    shaderc::Compiler comp;
     shaderc::CompileOptions options;
     if (_debug)
         options.SetGenerateDebugInfo();
     const shaderc_shader_kind stage = _stage==ESS_UNKNOWN ? shaderc_glsl_infer_from_source : ESStoShadercEnum(_stage);
-    shaderc::SpvCompilationResult res = comp.CompileGlslToSpv(_glslCode, strlen(_glslCode), stage, _compilationId ? _compilationId : "", _entryPoint, options);
-    return new ICPUShader(res.cbegin(), std::distance(res.cbegin(), res.cend())*sizeof(uint32_t));
+    const size_t glslLen = strlen(_glslCode);
+
+    // preprocessing is a small fraction of a full compile, and lets edits to comments or unused macros hit the cache
+    CSPIR_VCache::SKey key;
+    bool cacheable = false;
+    if (m_cache)
+    {
+        shaderc::PreprocessedSourceCompilationResult preprocessed = m_compiler->PreprocessGlsl(_glslCode, glslLen, stage, _compilationId ? _compilationId : "", options);
+        // failing to preprocess fails the compile too, let that report the errors
+        if (preprocessed.GetCompilationStatus()==shaderc_compilation_status_success)
+        {
+            key = makeSPIR_VCacheKey(preprocessed, stage, _entryPoint, _debug, _compilationId);
+            if (auto cached = m_cache->find(key))
+                return new ICPUShader(cached->getPointer(), cached->getSize());
+            cacheable = true;
+        }
+    }
+
+    shaderc::SpvCompilationResult res = m_compiler->CompileGlslToSpv(_glslCode, glslLen, stage, _compilationId ? _compilationId : "", _entryPoint, options);
+    const size_t byteSize = std::distance(res.cbegin(), res.cend())*sizeof(uint32_t);
+    if (cacheable && res.GetCompilationStatus()==shaderc_compilation_status_success)
+        m_cache->insert(key, res.cbegin(), byteSize);
+    return new ICPUShader(res.cbegin(), byteSize);
+}
+
+core::vector<std::future<ICPUShader*> > IGLSLCompiler::createShadersAsync(const core::vector<SCompileJob>& _jobs) const
+{
+    core::vector<std::future<ICPUShader*> > results;
+    results.reserve(_jobs.size());
+
+    std::lock_guard<core::mutex> lock(m_compilePoolMutex);
+    if (!m_compilePool)
+        m_compilePool = new core::CThreadPool();
+
+    for (const auto& job : _jobs)
+    {
+        // nothing to compile, the future is ready with a null shader right away
+        if (!job.glsl && !job.spirv)
+        {
+            std::promise<ICPUShader*> empty;
+            empty.set_value(nullptr);
+            results.push_back(empty.get_future());
+            continue;
+        }
+
+        // CThreadPool tasks have to be copyable
+        auto task = std::make_shared<std::packaged_task<ICPUShader*()> >([this,job]() { return runCompileJob(job); });
+        results.push_back(task->get_future());
+        m_compilePool->enqueue([task]() { (*task)(); });
+    }
+
+    return results;
+}
+
+ICPUShader* IGLSLCompiler::runCompileJob(const SCompileJob& _job) const
+{
+    ICPUShader* shader = _job.spirv ?
+        new ICPUShader(_job.spirv, _job.spirvSize):
+        createShaderFromGLSL(_job.glsl, _job.stage, _job.entryPoint, _job.debug, _job.compilationId);
+
+    // a failed compile leaves no bytecode to reflect on
+    if (_job.introspect && shader->getSPIR_VBytecode()->getSize())
+    {
+        try
+        {
+            shader->enableIntrospection();
+        }
+        catch (...)
+        {
+            shader->drop();
+            throw;
+        }
+    }
+    return shader;
 }
 
-}}
\ No newline at end of file
+}}
@@ -122,6 +122,7 @@ FinalBoneHierarchyBlobV0::FinalBoneHierarchyBlobV0(const scene::CFinalBoneHierar
 		*strPtr = 0;
 		++strPtr;
 	}
+	memcpy(ptr + calcBoneNameIndexOffset(_fbh), _fbh->getBoneNameIndex(), calcBoneNameIndexByteSize(_fbh));
 }
 
 template<>
@@ -134,7 +135,8 @@ size_t SizedBlob<VariableSizeBlob, FinalBoneHierarchyBlobV0,scene::CFinalBoneHie
 		FinalBoneHierarchyBlobV0::calcKeyFramesByteSize(_obj) +
 		FinalBoneHierarchyBlobV0::calcInterpolatedAnimsByteSize(_obj) +
 		FinalBoneHierarchyBlobV0::calcNonInterpolatedAnimsByteSize(_obj) +
-		FinalBoneHierarchyBlobV0::calcBoneNamesByteSize(_obj);
+		FinalBoneHierarchyBlobV0::calcBoneNamesByteSize(_obj) +
+		FinalBoneHierarchyBlobV0::calcBoneNameIndexByteSize(_obj);
 }
 
 size_t FinalBoneHierarchyBlobV0::calcBonesOffset(const scene::CFinalBoneHierarchy* _fbh)
@@ -161,6 +163,10 @@ size_t FinalBoneHierarchyBlobV0::calcBoneNamesOffset(const scene::CFinalBoneHier
 {
 	return calcNonInterpolatedAnimsOffset(_fbh) + calcNonInterpolatedAnimsByteSize(_fbh);
 }
+size_t FinalBoneHierarchyBlobV0::calcBoneNameIndexOffset(const scene::CFinalBoneHierarchy* _fbh)
+{
+	return calcBoneNamesOffset(_fbh) + calcBoneNamesByteSize(_fbh);
+}
 
 size_t FinalBoneHierarchyBlobV0::calcBonesByteSize(const scene::CFinalBoneHierarchy * _fbh)
 {
@@ -186,6 +192,10 @@ size_t FinalBoneHierarchyBlobV0::calcBoneNamesByteSize(const scene::CFinalBoneHi
 {
 	return _fbh->getSizeOfAllBoneNames();
 }
+size_t FinalBoneHierarchyBlobV0::calcBoneNameIndexByteSize(const scene::CFinalBoneHierarchy * _fbh)
+{
+	return _fbh->getBoneCount()*scene::CFinalBoneHierarchy::getSizeOfSingleBoneNameIndexEntry();
+}
 
 size_t FinalBoneHierarchyBlobV0::calcBonesOffset() const
 {
@@ -232,6 +242,10 @@ size_t FinalBoneHierarchyBlobV0::calcNonInterpolatedAnimsByteSize() const
 {
 	return keyframeCount * boneCount * scene::CFinalBoneHierarchy::getSizeOfSingleAnimationData();
 }
+size_t FinalBoneHierarchyBlobV0::calcBoneNameIndexByteSize() const
+{
+	return boneCount * scene::CFinalBoneHierarchy::getSizeOfSingleBoneNameIndexEntry();
+}
 
 
 // .baw VERSION 1
@@ -7,6 +7,7 @@
 
 #include "ISceneManager.h"
 #include "IFileSystem.h"
+#include "IReadFile.h"
 #include "IVideoDriver.h"
 #include "irr/video/SGPUMesh.h"
 #include "irr/asset/SCPUMesh.h"
@@ -18,6 +19,7 @@
 #include "irr/asset/IAssetManager.h"
 #include "irr/asset/ICPUSkinnedMeshBuffer.h"
 #include "irr/asset/CBAWMeshFileLoader.h"
+#include "CMappedReadFile.h"
 
 namespace irr { namespace asset
 {
@@ -36,6 +38,16 @@ void* TypedBlob<RawBufferBlobV0, asset::ICPUBuffer>::instantiateEmpty(const void
 		return NULL;
 
 	RawBufferBlobV0* blob = (RawBufferBlobV0*)_blob;
+
+	// uncompressed blob read straight from a memory mapped file, alias the mapping if it's aligned well enough for SIMD access
+	if (_params.mappedFile)
+	{
+		const uint8_t* const mapping = reinterpret_cast<const uint8_t*>(_params.mappedFile->getMappedPointer());
+		const uint8_t* const data = reinterpret_cast<const uint8_t*>(blob->getData());
+		if (data >= mapping && data+_blobSize <= mapping+_params.mappedFile->getSize() && (reinterpret_cast<size_t>(data)%_IRR_SIMD_ALIGNMENT) == 0u)
+			return new asset::CCustomAllocatorCPUBuffer<io::CMappedFileAllocator<uint8_t> >(_blobSize, const_cast<uint8_t*>(data), core::adopt_memory, io::CMappedFileAllocator<uint8_t>(_params.mappedFile)); // mapping is private (copy-on-write) so writing through the buffer is fine
+	}
+
 	asset::ICPUBuffer* buf = new asset::ICPUBuffer(_blobSize);
 	memcpy(buf->getPointer(), blob->getData(), _blobSize);
 
@@ -366,13 +378,19 @@ void* TypedBlob<FinalBoneHierarchyBlobV0, scene::CFinalBoneHierarchy>::instantia
 		strPtr += len;
 	}
 
+	const uint8_t* boneNameIndexBegin = (const uint8_t*)strPtr;
+	const uint8_t* boneNameIndexEnd = boneNameIndexBegin + blob->calcBoneNameIndexByteSize();
+	if (boneNameIndexEnd != (const uint8_t*)blobEnd) // blob from before the index was saved, the hierarchy will build it
+		boneNameIndexBegin = boneNameIndexEnd = NULL;
+
 	scene::CFinalBoneHierarchy* fbh = new scene::CFinalBoneHierarchy(
 		bonesBegin, bonesEnd,
 		boneNames, boneNames + blob->boneCount,
 		(const size_t*)levelsBegin, (const size_t*)levelsEnd,
 		(const float*)keyframesBegin, (const float*)keyframesEnd,
 		interpolatedAnimsBegin, interpolatedAnimsEnd,
-		nonInterpolatedAnimsBegin, nonInterpolatedAnimsEnd
+		nonInterpolatedAnimsBegin, nonInterpolatedAnimsEnd,
+		boneNameIndexBegin, boneNameIndexEnd
 	);
 
 	if ((uint8_t*)boneNames == stack)
@@ -0,0 +1,816 @@
+#include "irr/video/compressBlocks.h"
+
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+#include "IrrCompileConfig.h"
+#include "irr/core/parallel_for.h"
+#include "irr/asset/CImageData.h"
+#include "irr/video/convertColor.h"
+
+namespace irr
+{
+namespace video
+{
+using namespace asset;
+
+namespace impl
+{
+    //! Texels of one block as floats stored channel by channel, so that 4 texels of a channel fit in an SSE register
+    struct SBlockTexels
+    {
+        alignas(16) float channel[4][16];
+    };
+
+    static const float AllTexels[16] = {1.f,1.f,1.f,1.f,1.f,1.f,1.f,1.f,1.f,1.f,1.f,1.f,1.f,1.f,1.f,1.f};
+
+    static inline float clampf(float _value, float _min, float _max)
+    {
+        return std::min(std::max(_value,_min),_max);
+    }
+
+    static void loadBlock(const uint8_t _texels[16][4], bool _signed, SBlockTexels& _out)
+    {
+        for (uint32_t i=0u; i<16u; i++)
+        for (uint32_t ch=0u; ch<4u; ch++)
+        {
+            if (_signed) // -128 and -127 both decode to -1
+                _out.channel[ch][i] = float(std::max<int32_t>(int8_t(_texels[i][ch]),-127));
+            else
+                _out.channel[ch][i] = float(_texels[i][ch]);
+        }
+    }
+
+    //! Picks the closest palette entry for every texel, @returns the squared error summed over the texels scaled by `_texelWeights`
+    /** Ties go to the lower index, so the result is the same with and without SIMD. */
+    static float selectIndices(const SBlockTexels& _texels, const float _texelWeights[16], const float (*_palette)[4], uint32_t _paletteSize, const float _channelWeights[4], uint8_t _outIndices[16])
+    {
+        float error = 0.f;
+#ifdef __IRR_COMPILE_WITH_X86_SIMD_
+        const __m128 channelWeights[4] = {_mm_set1_ps(_channelWeights[0]),_mm_set1_ps(_channelWeights[1]),_mm_set1_ps(_channelWeights[2]),_mm_set1_ps(_channelWeights[3])};
+        for (uint32_t i=0u; i<16u; i+=4u)
+        {
+            __m128 texels[4];
+            for (uint32_t ch=0u; ch<4u; ch++)
+                texels[ch] = _mm_load_ps(_texels.channel[ch]+i);
+
+            __m128 bestError = _mm_set1_ps(FLT_MAX);
+            __m128i bestIndex = _mm_setzero_si128();
+            for (uint32_t j=0u; j<_paletteSize; j++)
+            {
+                __m128 entryError = _mm_setzero_ps();
+                for (uint32_t ch=0u; ch<4u; ch++)
+                {
+                    const __m128 diff = _mm_sub_ps(texels[ch],_mm_set1_ps(_palette[j][ch]));
+                    entryError = _mm_add_ps(entryError,_mm_mul_ps(_mm_mul_ps(diff,diff),channelWeights[ch]));
+                }
+                const __m128 closer = _mm_cmplt_ps(entryError,bestError);
+                bestError = _mm_min_ps(entryError,bestError);
+                bestIndex = _mm_blendv_epi8(bestIndex,_mm_set1_epi32(j),_mm_castps_si128(closer));
+            }
+
+            alignas(16) int32_t indices[4];
+            alignas(16) float errors[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(indices),bestIndex);
+            _mm_store_ps(errors,_mm_mul_ps(bestError,_mm_loadu_ps(_texelWeights+i)));
+            for (uint32_t k=0u; k<4u; k++)
+            {
+                _outIndices[i+k] = indices[k];
+                error += errors[k];
+            }
+        }
+#else
+        for (uint32_t i=0u; i<16u; i++)
+        {
+            float bestError = FLT_MAX;
+            uint8_t bestIndex = 0u;
+            for (uint32_t j=0u; j<_paletteSize; j++)
+            {
+                float entryError = 0.f;
+                for (uint32_t ch=0u; ch<4u; ch++)
+                {
+                    const float diff = _texels.channel[ch][i]-_palette[j][ch];
+                    entryError += diff*diff*_channelWeights[ch];
+                }
+                if (entryError<bestError)
+                {
+                    bestError = entryError;
+                    bestIndex = j;
+                }
+            }
+            _outIndices[i] = bestIndex;
+            error += bestError*_texelWeights[i];
+        }
+#endif
+        return error;
+    }
+
+    //! Finds two endpoints of a line through the texels with non-zero `_texelWeights`, over the first `_channelCount` channels
+    /** With EBCQ_FASTEST the line is the diagonal of the bounding box flipped to follow the correlation with the widest channel, otherwise it is the principal axis. */
+    static void findEndpoints(const SBlockTexels& _texels, const float _texelWeights[16], uint32_t _channelCount, E_BLOCK_COMPRESSION_QUALITY _quality, float _outE0[4], float _outE1[4])
+    {
+        float mean[4] = {0.f,0.f,0.f,0.f};
+        float minValue[4] = {FLT_MAX,FLT_MAX,FLT_MAX,FLT_MAX};
+        float maxValue[4] = {-FLT_MAX,-FLT_MAX,-FLT_MAX,-FLT_MAX};
+        float weightSum = 0.f;
+        for (uint32_t i=0u; i<16u; i++)
+        {
+            if (_texelWeights[i]==0.f)
+                continue;
+            weightSum += _texelWeights[i];
+            for (uint32_t ch=0u; ch<_channelCount; ch++)
+            {
+                mean[ch] += _texels.channel[ch][i]*_texelWeights[i];
+                minValue[ch] = std::min(minValue[ch],_texels.channel[ch][i]);
+                maxValue[ch] = std::max(maxValue[ch],_texels.channel[ch][i]);
+            }
+        }
+        for (uint32_t ch=0u; ch<4u; ch++)
+            _outE0[ch] = _outE1[ch] = 0.f;
+        if (weightSum==0.f)
+            return;
+        for (uint32_t ch=0u; ch<_channelCount; ch++)
+            mean[ch] /= weightSum;
+
+        float covariance[4][4] = {};
+        for (uint32_t i=0u; i<16u; i++)
+        {
+            if (_texelWeights[i]==0.f)
+                continue;
+            for (uint32_t j=0u; j<_channelCount; j++)
+            for (uint32_t k=j; k<_channelCount; k++)
+                covariance[j][k] += (_texels.channel[j][i]-mean[j])*(_texels.channel[k][i]-mean[k])*_texelWeights[i];
+        }
+        for (uint32_t j=0u; j<_channelCount; j++)
+        for (uint32_t k=0u; k<j; k++)
+            covariance[j][k] = covariance[k][j];
+
+        float axis[4] = {0.f,0.f,0.f,0.f};
+        uint32_t widest = 0u;
+        for (uint32_t ch=0u; ch<_channelCount; ch++)
+        {
+            axis[ch] = maxValue[ch]-minValue[ch];
+            if (axis[ch]>axis[widest])
+                widest = ch;
+        }
+        for (uint32_t ch=0u; ch<_channelCount; ch++)
+        if (covariance[widest][ch]<0.f)
+            axis[ch] = -axis[ch];
+
+        if (_quality!=EBCQ_FASTEST)
+        {
+            // power iteration, the flipped bounding box diagonal is already a good guess
+            for (uint32_t iteration=0u; iteration<8u; iteration++)
+            {
+                float next[4] = {0.f,0.f,0.f,0.f};
+                float largest = 0.f;
+                for (uint32_t j=0u; j<_channelCount; j++)
+                {
+                    for (uint32_t k=0u; k<_channelCount; k++)
+                        next[j] += covariance[j][k]*axis[k];
+                    largest = std::max(largest,std::abs(next[j]));
+                }
+                if (largest==0.f)
+                    break;
+                for (uint32_t ch=0u; ch<_channelCount; ch++)
+                    axis[ch] = next[ch]/largest;
+            }
+        }
+
+        float lengthSq = 0.f;
+        for (uint32_t ch=0u; ch<_channelCount; ch++)
+            lengthSq += axis[ch]*axis[ch];
+        if (lengthSq<FLT_EPSILON)
+        {
+            for (uint32_t ch=0u; ch<_channelCount; ch++)
+                _outE0[ch] = _outE1[ch] = mean[ch];
+            return;
+        }
+
+        float minT = FLT_MAX, maxT = -FLT_MAX;
+        for (uint32_t i=0u; i<16u; i++)
+        {
+            if (_texelWeights[i]==0.f)
+                continue;
+            float t = 0.f;
+            for (uint32_t ch=0u; ch<_channelCount; ch++)
+                t += (_texels.channel[ch][i]-mean[ch])*axis[ch];
+            t /= lengthSq;
+            minT = std::min(minT,t);
+            maxT = std::max(maxT,t);
+        }
+        for (uint32_t ch=0u; ch<_channelCount; ch++)
+        {
+            _outE0[ch] = mean[ch]+minT*axis[ch];
+            _outE1[ch] = mean[ch]+maxT*axis[ch];
+        }
+    }
+
+    //! Least squares endpoints for fixed indices, `_interpolation[index]` is how far along from the first to the second endpoint a palette entry lies (negative for entries off the line)
+    /** @returns false if the system is singular, for example when all texels picked the same entry. */
+    static bool refineEndpoints(const SBlockTexels& _texels, const float _texelWeights[16], const uint8_t _indices[16], const float* _interpolation, uint32_t _channelCount, float _outE0[4], float _outE1[4])
+    {
+        float aa = 0.f, ab = 0.f, bb = 0.f;
+        float ax[4] = {0.f,0.f,0.f,0.f};
+        float bx[4] = {0.f,0.f,0.f,0.f};
+        for (uint32_t i=0u; i<16u; i++)
+        {
+            const float beta = _interpolation[_indices[i]];
+            if (_texelWeights[i]==0.f || beta<0.f)
+                continue;
+            const float alpha = 1.f-beta;
+            aa += alpha*alpha*_texelWeights[i];
+            ab += alpha*beta*_texelWeights[i];
+            bb += beta*beta*_texelWeights[i];
+            for (uint32_t ch=0u; ch<_channelCount; ch++)
+            {
+                ax[ch] += alpha*_texels.channel[ch][i]*_texelWeights[i];
+                bx[ch] += beta*_texels.channel[ch][i]*_texelWeights[i];
+            }
+        }
+
+        const float determinant = aa*bb-ab*ab;
+        if (std::abs(determinant)<FLT_EPSILON)
+            return false;
+        for (uint32_t ch=0u; ch<_channelCount; ch++)
+        {
+            _outE0[ch] = (bb*ax[ch]-ab*bx[ch])/determinant;
+            _outE1[ch] = (aa*bx[ch]-ab*ax[ch])/determinant;
+        }
+        return true;
+    }
+
+    static uint32_t getRefinementPasses(E_BLOCK_COMPRESSION_QUALITY _quality)
+    {
+        switch (_quality)
+        {
+            case EBCQ_FASTEST:
+                return 0u;
+            case EBCQ_NORMAL:
+                return 1u;
+            default:
+                return 3u;
+        }
+    }
+
+    //! Writes `_bitCount` bits of `_value` at bit `_offset` of a zeroed block, least significant bit first
+    static inline void writeBits(uint8_t* _block, uint32_t& _offset, uint32_t _value, uint32_t _bitCount)
+    {
+        for (uint32_t i=0u; i<_bitCount; i++,_offset++)
+        if ((_value>>i)&0x1u)
+            _block[_offset/8u] |= 0x1u<<(_offset%8u);
+    }
+
+    //! BC1 color block, also the second half of BC2 and BC3
+    struct SColorBlock
+    {
+        uint16_t color[2];
+        bool fourColor;
+        uint8_t indices[16];
+        float error;
+    };
+
+    // how far along from the first to the second color every palette entry lies, index 3 of the three color mode is black or transparent
+    static const float FourColorInterpolation[4] = {0.f,1.f,1.f/3.f,2.f/3.f};
+    static const float ThreeColorInterpolation[4] = {0.f,1.f,0.5f,-1.f};
+
+    static inline uint16_t quantize565(const float _color[4])
+    {
+        const uint32_t r = uint32_t(std::round(clampf(_color[0],0.f,255.f)*31.f/255.f));
+        const uint32_t g = uint32_t(std::round(clampf(_color[1],0.f,255.f)*63.f/255.f));
+        const uint32_t b = uint32_t(std::round(clampf(_color[2],0.f,255.f)*31.f/255.f));
+        return (r<<11u)|(g<<5u)|b;
+    }
+
+    static inline void expand565(uint16_t _color, float _out[4])
+    {
+        const uint32_t r = _color>>11u;
+        const uint32_t g = (_color>>5u)&0x3fu;
+        const uint32_t b = _color&0x1fu;
+        _out[0] = float((r<<3u)|(r>>2u));
+        _out[1] = float((g<<2u)|(g>>4u));
+        _out[2] = float((b<<3u)|(b>>2u));
+        _out[3] = 0.f;
+    }
+
+    //! Quantizes the endpoints, orders them for the block mode and picks the indices
+    /** Texels with zero weight are transparent and get index 3, which is transparent black in the three color mode. */
+    static void evaluateColorEndpoints(const SBlockTexels& _texels, const float _texelWeights[16], const float _e0[4], const float _e1[4], bool _threeColor, bool _forceFourColor, SColorBlock& _out)
+    {
+        uint16_t c0 = quantize565(_e0);
+        uint16_t c1 = quantize565(_e1);
+        // the decoder picks the mode from the order of the colors
+        if (_threeColor ? (c0>c1):(c0<c1))
+            std::swap(c0,c1);
+        _out.color[0] = c0;
+        _out.color[1] = c1;
+        _out.fourColor = _forceFourColor || c0>c1;
+
+        float palette[4][4];
+        expand565(c0,palette[0]);
+        expand565(c1,palette[1]);
+        for (uint32_t ch=0u; ch<4u; ch++)
+        {
+            if (_out.fourColor)
+            {
+                palette[2][ch] = (2.f*palette[0][ch]+palette[1][ch])/3.f;
+                palette[3][ch] = (palette[0][ch]+2.f*palette[1][ch])/3.f;
+            }
+            else
+            {
+                palette[2][ch] = (palette[0][ch]+palette[1][ch])*0.5f;
+                palette[3][ch] = 0.f;
+            }
+        }
+
+        const float channelWeights[4] = {1.f,1.f,1.f,0.f};
+        _out.error = selectIndices(_texels,_texelWeights,palette,_out.fourColor ? 4u:3u,channelWeights,_out.indices);
+        for (uint32_t i=0u; i<16u; i++)
+        if (_texelWeights[i]==0.f)
+            _out.indices[i] = 3u;
+    }
+
+    static void compressColorBlock(const SBlockTexels& _texels, bool _punchThroughAlpha, bool _forceFourColor, E_BLOCK_COMPRESSION_QUALITY _quality, uint8_t* _out)
+    {
+        float texelWeights[16];
+        bool transparent = false;
+        bool opaque = false;
+        for (uint32_t i=0u; i<16u; i++)
+        {
+            const bool texelTransparent = _punchThroughAlpha && _texels.channel[3][i]<128.f;
+            texelWeights[i] = texelTransparent ? 0.f:1.f;
+            transparent = transparent || texelTransparent;
+            opaque = opaque || !texelTransparent;
+        }
+
+        SColorBlock best;
+        if (!opaque)
+        {
+            // equal colors select the three color mode, index 3 everywhere
+            best.color[0] = best.color[1] = 0u;
+            memset(best.indices,3u,sizeof(best.indices));
+        }
+        else
+        {
+            float e0[4], e1[4];
+            findEndpoints(_texels,texelWeights,3u,_quality,e0,e1);
+
+            // transparent texels need the three color mode, opaque blocks only try it when asked for the best quality
+            bool modes[2] = {false,true};
+            uint32_t firstMode = transparent ? 1u:0u;
+            uint32_t lastMode = transparent||(_quality==EBCQ_HIGHEST&&!_forceFourColor) ? 1u:0u;
+
+            best.error = FLT_MAX;
+            for (uint32_t mode=firstMode; mode<=lastMode; mode++)
+            {
+                SColorBlock candidate;
+                evaluateColorEndpoints(_texels,texelWeights,e0,e1,modes[mode],_forceFourColor,candidate);
+                for (uint32_t pass=0u; pass<getRefinementPasses(_quality); pass++)
+                {
+                    float r0[4], r1[4];
+                    if (!refineEndpoints(_texels,texelWeights,candidate.indices,candidate.fourColor ? FourColorInterpolation:ThreeColorInterpolation,3u,r0,r1))
+                        break;
+                    SColorBlock refined;
+                    evaluateColorEndpoints(_texels,texelWeights,r0,r1,modes[mode],_forceFourColor,refined);
+                    if (refined.error>=candidate.error)
+                        break;
+                    candidate = refined;
+                }
+                if (candidate.error<best.error)
+                    best = candidate;
+            }
+        }
+
+        memcpy(_out,best.color,4u);
+        uint32_t indices = 0u;
+        for (uint32_t i=0u; i<16u; i++)
+            indices |= uint32_t(best.indices[i])<<(2u*i);
+        memcpy(_out+4u,&indices,4u);
+    }
+
+    //! BC2 alpha, 4 bits per texel
+    static void compressExplicitAlphaBlock(const SBlockTexels& _texels, uint8_t* _out)
+    {
+        uint64_t alpha = 0u;
+        for (uint32_t i=0u; i<16u; i++)
+            alpha |= uint64_t(std::round(_texels.channel[3][i]*15.f/255.f))<<(4u*i);
+        memcpy(_out,&alpha,8u);
+    }
+
+    //! BC4 block from one channel, also the alpha of BC3 and either half of BC5
+    /** Values are in [0,255] for unsigned and [-127,127] for signed blocks. */
+    static void compressSingleChannelBlock(const SBlockTexels& _texels, uint32_t _channel, bool _signed, E_BLOCK_COMPRESSION_QUALITY _quality, uint8_t* _out)
+    {
+        const float lowest = _signed ? -127.f:0.f;
+        const float highest = _signed ? 127.f:255.f;
+
+        struct SCandidate
+        {
+            int32_t value[2];
+            uint8_t indices[16];
+            float error;
+        };
+        float channelWeights[4] = {0.f,0.f,0.f,0.f};
+        channelWeights[_channel] = 1.f;
+        // first value greater than the second picks 8 interpolated values, otherwise 6 plus both extremes
+        auto evaluate = [&](int32_t _v0, int32_t _v1, SCandidate& _candidate) -> void
+        {
+            float palette[8][4] = {};
+            palette[0][_channel] = float(_v0);
+            palette[1][_channel] = float(_v1);
+            if (_v0>_v1)
+            {
+                for (uint32_t i=1u; i<7u; i++)
+                    palette[i+1u][_channel] = (float(7u-i)*_v0+float(i)*_v1)/7.f;
+            }
+            else
+            {
+                for (uint32_t i=1u; i<5u; i++)
+                    palette[i+1u][_channel] = (float(5u-i)*_v0+float(i)*_v1)/5.f;
+                palette[6][_channel] = lowest;
+                palette[7][_channel] = highest;
+            }
+            _candidate.value[0] = _v0;
+            _candidate.value[1] = _v1;
+            _candidate.error = selectIndices(_texels,AllTexels,palette,8u,channelWeights,_candidate.indices);
+        };
+
+        float minValue = FLT_MAX, maxValue = -FLT_MAX;
+        float minInner = FLT_MAX, maxInner = -FLT_MAX;
+        for (uint32_t i=0u; i<16u; i++)
+        {
+            const float value = _texels.channel[_channel][i];
+            minValue = std::min(minValue,value);
+            maxValue = std::max(maxValue,value);
+            if (value!=lowest && value!=highest)
+            {
+                minInner = std::min(minInner,value);
+                maxInner = std::max(maxInner,value);
+            }
+        }
+
+        SCandidate best;
+        evaluate(int32_t(maxValue),int32_t(minValue),best);
+        if (_quality!=EBCQ_FASTEST && best.error>0.f && minInner<=maxInner)
+        {
+            // extremes are free in the 6 value mode, so the interpolated values only need to span the rest
+            SCandidate candidate;
+            evaluate(int32_t(minInner),int32_t(maxInner),candidate);
+            if (candidate.error<best.error)
+                best = candidate;
+        }
+        if (_quality==EBCQ_HIGHEST && best.error>0.f && maxValue>minValue)
+        {
+            // pulling the ends in a little often matches the interpolated values better
+            for (int32_t d0=-2; d0<=0; d0++)
+            for (int32_t d1=0; d1<=2; d1++)
+            {
+                const int32_t v0 = int32_t(maxValue)+d0;
+                const int32_t v1 = int32_t(minValue)+d1;
+                if (v0<=v1 || (d0==0&&d1==0))
+                    continue;
+                SCandidate candidate;
+                evaluate(v0,v1,candidate);
+                if (candidate.error<best.error)
+                    best = candidate;
+            }
+        }
+
+        _out[0] = uint8_t(best.value[0]);
+        _out[1] = uint8_t(best.value[1]);
+        uint64_t indices = 0u;
+        for (uint32_t i=0u; i<16u; i++)
+            indices |= uint64_t(best.indices[i])<<(3u*i);
+        memcpy(_out+2u,&indices,6u);
+    }
+
+    //! BC7 mode 6, one subset with 7 bit RGBA endpoints plus a p-bit each and 4 bit indices
+    /** The mode covers all of RGBA at once, which makes it the usual choice of fast BC7 encoders for textures of any kind. */
+    struct SBC7Block
+    {
+        uint32_t endpoint[2][4];
+        uint32_t pBit[2];
+        uint8_t indices[16];
+        float error;
+    };
+
+    static const uint32_t BC7Weights[16] = {0u,4u,9u,13u,17u,21u,26u,30u,34u,38u,43u,47u,51u,55u,60u,64u};
+    static const float BC7Interpolation[16] = {0.f/64.f,4.f/64.f,9.f/64.f,13.f/64.f,17.f/64.f,21.f/64.f,26.f/64.f,30.f/64.f,34.f/64.f,38.f/64.f,43.f/64.f,47.f/64.f,51.f/64.f,55.f/64.f,60.f/64.f,64.f/64.f};
+
+    static inline uint32_t quantizeBC7(float _value, uint32_t _pBit)
+    {
+        return uint32_t(clampf(std::round((_value-float(_pBit))*0.5f),0.f,127.f));
+    }
+
+    //! p-bit giving the smallest error for the endpoint on its own
+    static uint32_t chooseBC7PBit(const float _endpoint[4])
+    {
+        float errors[2] = {0.f,0.f};
+        for (uint32_t pBit=0u; pBit<2u; pBit++)
+        for (uint32_t ch=0u; ch<4u; ch++)
+        {
+            const float diff = _endpoint[ch]-float((quantizeBC7(_endpoint[ch],pBit)<<1u)|pBit);
+            errors[pBit] += diff*diff;
+        }
+        return errors[1]<errors[0] ? 1u:0u;
+    }
+
+    static void evaluateBC7Endpoints(const SBlockTexels& _texels, const float _e0[4], const float _e1[4], uint32_t _pBit0, uint32_t _pBit1, SBC7Block& _out)
+    {
+        _out.pBit[0] = _pBit0;
+        _out.pBit[1] = _pBit1;
+        uint32_t unquantized[2][4];
+        for (uint32_t ch=0u; ch<4u; ch++)
+        {
+            _out.endpoint[0][ch] = quantizeBC7(_e0[ch],_pBit0);
+            _out.endpoint[1][ch] = quantizeBC7(_e1[ch],_pBit1);
+            unquantized[0][ch] = (_out.endpoint[0][ch]<<1u)|_pBit0;
+            unquantized[1][ch] = (_out.endpoint[1][ch]<<1u)|_pBit1;
+        }
+
+        float palette[16][4];
+        for (uint32_t i=0u; i<16u; i++)
+        for (uint32_t ch=0u; ch<4u; ch++)
+            palette[i][ch] = float(((64u-BC7Weights[i])*unquantized[0][ch]+BC7Weights[i]*unquantized[1][ch]+32u)>>6u);
+
+        const float channelWeights[4] = {1.f,1.f,1.f,1.f};
+        _out.error = selectIndices(_texels,AllTexels,palette,16u,channelWeights,_out.indices);
+    }
+
+    static void compressBC7Block(const SBlockTexels& _texels, E_BLOCK_COMPRESSION_QUALITY _quality, uint8_t* _out)
+    {
+        auto evaluate = [&](const float _e0[4], const float _e1[4], SBC7Block& _block) -> void
+        {
+            if (_quality==EBCQ_HIGHEST)
+            {
+                _block.error = FLT_MAX;
+                for (uint32_t pBits=0u; pBits<4u; pBits++)
+                {
+                    SBC7Block candidate;
+                    evaluateBC7Endpoints(_texels,_e0,_e1,pBits&0x1u,pBits>>1u,candidate);
+                    if (candidate.error<_block.error)
+                        _block = candidate;
+                }
+            }
+            else
+                evaluateBC7Endpoints(_texels,_e0,_e1,chooseBC7PBit(_e0),chooseBC7PBit(_e1),_block);
+        };
+
+        float e0[4], e1[4];
+        findEndpoints(_texels,AllTexels,4u,_quality,e0,e1);
+        SBC7Block best;
+        evaluate(e0,e1,best);
+        for (uint32_t pass=0u; pass<getRefinementPasses(_quality); pass++)
+        {
+            float r0[4], r1[4];
+            if (!refineEndpoints(_texels,AllTexels,best.indices,BC7Interpolation,4u,r0,r1))
+                break;
+            SBC7Block refined;
+            evaluate(r0,r1,refined);
+            if (refined.error>=best.error)
+                break;
+            best = refined;
+        }
+
+        // the most significant bit of the first index is implied zero
+        if (best.indices[0]&0x8u)
+        {
+            for (uint32_t ch=0u; ch<4u; ch++)
+                std::swap(best.endpoint[0][ch],best.endpoint[1][ch]);
+            std::swap(best.pBit[0],best.pBit[1]);
+            for (uint32_t i=0u; i<16u; i++)
+                best.indices[i] = 15u-best.indices[i];
+        }
+
+        memset(_out,0,16u);
+        uint32_t offset = 0u;
+        writeBits(_out,offset,0x1u<<6u,7u);
+        for (uint32_t ch=0u; ch<4u; ch++)
+        {
+            writeBits(_out,offset,best.endpoint[0][ch],7u);
+            writeBits(_out,offset,best.endpoint[1][ch],7u);
+        }
+        writeBits(_out,offset,best.pBit[0],1u);
+        writeBits(_out,offset,best.pBit[1],1u);
+        writeBits(_out,offset,best.indices[0],3u);
+        for (uint32_t i=1u; i<16u; i++)
+            writeBits(_out,offset,best.indices[i],4u);
+    }
+
+    void compressBlock(E_FORMAT _fmt, const uint8_t _texels[16][4], void* _block, E_BLOCK_COMPRESSION_QUALITY _quality)
+    {
+        SBlockTexels texels;
+        loadBlock(_texels,_fmt==EF_BC4_SNORM_BLOCK||_fmt==EF_BC5_SNORM_BLOCK,texels);
+
+        uint8_t* out = reinterpret_cast<uint8_t*>(_block);
+        switch (_fmt)
+        {
+            case EF_BC1_RGB_UNORM_BLOCK:
+            case EF_BC1_RGB_SRGB_BLOCK:
+                compressColorBlock(texels,false,false,_quality,out);
+                break;
+            case EF_BC1_RGBA_UNORM_BLOCK:
+            case EF_BC1_RGBA_SRGB_BLOCK:
+                compressColorBlock(texels,true,false,_quality,out);
+                break;
+            case EF_BC2_UNORM_BLOCK:
+            case EF_BC2_SRGB_BLOCK:
+                compressExplicitAlphaBlock(texels,out);
+                compressColorBlock(texels,false,true,_quality,out+8u);
+                break;
+            case EF_BC3_UNORM_BLOCK:
+            case EF_BC3_SRGB_BLOCK:
+                compressSingleChannelBlock(texels,3u,false,_quality,out);
+                compressColorBlock(texels,false,true,_quality,out+8u);
+                break;
+            case EF_BC4_UNORM_BLOCK:
+            case EF_BC4_SNORM_BLOCK:
+                compressSingleChannelBlock(texels,0u,_fmt==EF_BC4_SNORM_BLOCK,_quality,out);
+                break;
+            case EF_BC5_UNORM_BLOCK:
+            case EF_BC5_SNORM_BLOCK:
+                compressSingleChannelBlock(texels,0u,_fmt==EF_BC5_SNORM_BLOCK,_quality,out);
+                compressSingleChannelBlock(texels,1u,_fmt==EF_BC5_SNORM_BLOCK,_quality,out+8u);
+                break;
+            case EF_BC7_UNORM_BLOCK:
+            case EF_BC7_SRGB_BLOCK:
+                compressBC7Block(texels,_quality,out);
+                break;
+            default:
+                assert(0);
+                break;
+        }
+    }
+} //namespace impl
+
+bool isBlockCompressorFormat(E_FORMAT _fmt)
+{
+    switch (_fmt)
+    {
+        case EF_BC1_RGB_UNORM_BLOCK:
+        case EF_BC1_RGB_SRGB_BLOCK:
+        case EF_BC1_RGBA_UNORM_BLOCK:
+        case EF_BC1_RGBA_SRGB_BLOCK:
+        case EF_BC2_UNORM_BLOCK:
+        case EF_BC2_SRGB_BLOCK:
+        case EF_BC3_UNORM_BLOCK:
+        case EF_BC3_SRGB_BLOCK:
+        case EF_BC4_UNORM_BLOCK:
+        case EF_BC4_SNORM_BLOCK:
+        case EF_BC5_UNORM_BLOCK:
+        case EF_BC5_SNORM_BLOCK:
+        case EF_BC7_UNORM_BLOCK:
+        case EF_BC7_SRGB_BLOCK:
+            return true;
+        default:
+            return false;
+    }
+}
+
+E_FORMAT getBlockCompressorInputFormat(E_FORMAT _fmt)
+{
+    switch (_fmt)
+    {
+        case EF_BC1_RGB_SRGB_BLOCK:
+        case EF_BC1_RGBA_SRGB_BLOCK:
+        case EF_BC2_SRGB_BLOCK:
+        case EF_BC3_SRGB_BLOCK:
+        case EF_BC7_SRGB_BLOCK:
+            return EF_R8G8B8A8_SRGB;
+        case EF_BC4_SNORM_BLOCK:
+        case EF_BC5_SNORM_BLOCK:
+            return EF_R8G8B8A8_SNORM;
+        default:
+            return EF_R8G8B8A8_UNORM;
+    }
+}
+
+E_FORMAT getBlockCompressedFormat(E_FORMAT _fmt, bool _preferBC7)
+{
+    if (isBlockCompressionFormat(_fmt) || isPlanarFormat(_fmt) || isDepthOrStencilFormat(_fmt) || !isNormalizedFormat(_fmt))
+        return EF_UNKNOWN;
+
+    const bool srgb = isSRGBFormat(_fmt);
+    const bool snorm = isSignedFormat(_fmt);
+    switch (getFormatChannelCount(_fmt))
+    {
+        case 1u:
+            return srgb ? EF_UNKNOWN:(snorm ? EF_BC4_SNORM_BLOCK:EF_BC4_UNORM_BLOCK);
+        case 2u:
+            return srgb ? EF_UNKNOWN:(snorm ? EF_BC5_SNORM_BLOCK:EF_BC5_UNORM_BLOCK);
+        case 3u:
+            if (snorm)
+                return EF_UNKNOWN;
+            if (_preferBC7)
+                return srgb ? EF_BC7_SRGB_BLOCK:EF_BC7_UNORM_BLOCK;
+            return srgb ? EF_BC1_RGB_SRGB_BLOCK:EF_BC1_RGB_UNORM_BLOCK;
+        case 4u:
+            if (snorm)
+                return EF_UNKNOWN;
+            if (_preferBC7)
+                return srgb ? EF_BC7_SRGB_BLOCK:EF_BC7_UNORM_BLOCK;
+            return srgb ? EF_BC3_SRGB_BLOCK:EF_BC3_UNORM_BLOCK;
+        default:
+            return EF_UNKNOWN;
+    }
+}
+
+void compressBlocks(E_FORMAT _fmt, const void* _texels, void* _blocks, const core::vector3d<uint32_t>& _imgSize, E_BLOCK_COMPRESSION_QUALITY _quality, uint32_t _threadCount)
+{
+    if (!isBlockCompressorFormat(_fmt))
+    {
+        assert(0);
+        return;
+    }
+    if (_imgSize.X==0u || _imgSize.Y==0u || _imgSize.Z==0u)
+        return;
+
+    const uint32_t blocksPerRow = (_imgSize.X+3u)/4u;
+    const uint32_t blockRowsPerSlice = (_imgSize.Y+3u)/4u;
+    const size_t blockSize = getTexelOrBlockSize(_fmt);
+    const uint8_t* const texels = reinterpret_cast<const uint8_t*>(_texels);
+    uint8_t* const blocks = reinterpret_cast<uint8_t*>(_blocks);
+    // a few hundred blocks is about the least work worth a thread
+    const size_t minRowsPerThread = std::max<size_t>(256u/blocksPerRow,1u);
+    core::parallel_for<size_t>(0u,size_t(blockRowsPerSlice)*_imgSize.Z,[&](size_t _rowBegin, size_t _rowEnd)
+    {
+        uint8_t blockTexels[16][4];
+        for (size_t row=_rowBegin; row<_rowEnd; row++)
+        {
+            const uint8_t* sliceTexels = texels+(row/blockRowsPerSlice)*size_t(_imgSize.X)*_imgSize.Y*4u;
+            const uint32_t firstY = uint32_t(row%blockRowsPerSlice)*4u;
+            for (uint32_t blockX=0u; blockX<blocksPerRow; blockX++)
+            {
+                // partial blocks repeat the last column and row
+                for (uint32_t y=0u; y<4u; y++)
+                for (uint32_t x=0u; x<4u; x++)
+                {
+                    const size_t texelY = std::min(firstY+y,_imgSize.Y-1u);
+                    const size_t texelX = std::min(blockX*4u+x,_imgSize.X-1u);
+                    memcpy(blockTexels[4u*y+x],sliceTexels+(texelY*_imgSize.X+texelX)*4u,4u);
+                }
+                impl::compressBlock(_fmt,blockTexels,blocks+(row*blocksPerRow+blockX)*blockSize,_quality);
+            }
+        }
+    },_threadCount,minRowsPerThread);
+}
+
+CImageData* createBlockCompressedImage(const CImageData* _image, E_FORMAT _fmt, E_BLOCK_COMPRESSION_QUALITY _quality, uint32_t _threadCount)
+{
+    const E_FORMAT srcFmt = _image->getColorFormat();
+    if (!isBlockCompressorFormat(_fmt) || isBlockCompressionFormat(srcFmt) || isPlanarFormat(srcFmt))
+        return nullptr;
+
+    core::vector3d<uint32_t> size = _image->getSize();
+    const E_FORMAT inputFmt = getBlockCompressorInputFormat(_fmt);
+    core::vector<uint8_t> texels(size_t(size.X)*size.Y*size.Z*4u);
+    const size_t pitch = _image->getPitchIncludingAlignment();
+    if (pitch==size_t(size.X)*getTexelOrBlockSize(srcFmt))
+    {
+        const void* srcPix[4] = {_image->getData(),nullptr,nullptr,nullptr};
+        convertColor(srcFmt,inputFmt,srcPix,texels.data(),_image->getImageDataSizeInPixels(),size,_threadCount);
+    }
+    else
+    {
+        // rows are padded for the unpack alignment
+        core::vector3d<uint32_t> rowSize(size.X,1u,1u);
+        for (uint32_t row=0u; row<size.Y*size.Z; row++)
+        {
+            const void* srcPix[4] = {reinterpret_cast<const uint8_t*>(_image->getData())+row*pitch,nullptr,nullptr,nullptr};
+            convertColor(srcFmt,inputFmt,srcPix,texels.data()+size_t(row)*size.X*4u,size.X,rowSize);
+        }
+    }
+    // decoders of formats without alpha do not write it, and BC1 with alpha and BC7 would encode it
+    if (getFormatChannelCount(srcFmt)<4u)
+    for (size_t i=0u; i<texels.size(); i+=4u)
+        texels[i+3u] = 0xffu;
+
+    uint32_t minCoord[3], maxCoord[3];
+    memcpy(minCoord,_image->getSliceMin(),sizeof(minCoord));
+    memcpy(maxCoord,_image->getSliceMax(),sizeof(maxCoord));
+    CImageData* compressed = new CImageData(nullptr,minCoord,maxCoord,_image->getSupposedMipLevel(),_fmt);
+    compressBlocks(_fmt,texels.data(),compressed->getData(),size,_quality,_threadCount);
+    return compressed;
+}
+
+void blockCompressImages(core::vector<CImageData*>& _images, bool _highQuality, uint32_t _threadCount)
+{
+    for (auto& image : _images)
+    {
+        const E_FORMAT fmt = getBlockCompressedFormat(image->getColorFormat(),_highQuality);
+        if (fmt==EF_UNKNOWN)
+            continue;
+
+        CImageData* compressed = createBlockCompressedImage(image,fmt,_highQuality ? EBCQ_HIGHEST:EBCQ_NORMAL,_threadCount);
+        if (!compressed)
+            continue;
+        image->drop();
+        image = compressed;
+    }
+}
+
+}
+}